@@ -0,0 +1,162 @@
+//##################################################
+// File: ArenaList.h
+// Description: A doubly linked list stored in one contiguous arena, linked by 32-bit indices instead of pointers.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef ARENALIST_H
+#define ARENALIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Doubly linked list whose nodes live side by side in a single vector.
+ * @note Links are 32-bit indices, so a node of `char` takes 12 bytes instead of the 24 bytes (plus
+ *       heap header) of a pointer-linked node, and traversal walks one block of memory. Erased slots
+ *       go on a free list and keep their stale value until reused, so the arena never shrinks until
+ *       `clear` or destruction. Handles stay valid until their node is erased; growing the arena
+ *       moves the nodes but keeps every handle.
+ */
+template <typename T>
+class ArenaList {
+public:
+    using Handle = std::uint32_t;
+    static constexpr Handle None = UINT32_MAX; ///< The "no node" handle: end of the list or empty list.
+
+    Handle pushFront(const T& data);                   ///< Adds a node to the front and returns its handle.
+    Handle pushBack(const T& data);                    ///< Adds a node to the end and returns its handle.
+    Handle insertAfter(Handle position, const T& data); ///< Inserts after a node and returns the new handle.
+    void erase(Handle node);                           ///< Removes a node in O(1).
+    bool popFront();                                   ///< Removes the first node.
+    bool popBack();                                    ///< Removes the last node.
+    void clear();                                      ///< Removes every node and empties the arena.
+    void reserve(std::size_t nodeCount);               ///< Preallocates arena space for `nodeCount` nodes.
+
+    Handle front() const { return head; }              ///< Handle of the first node, or `None`.
+    Handle back() const { return tail; }               ///< Handle of the last node, or `None`.
+    Handle next(Handle node) const { return nodes[node].next; } ///< Handle of the following node, or `None`.
+    Handle prev(Handle node) const { return nodes[node].prev; } ///< Handle of the preceding node, or `None`.
+    T& value(Handle node) { return nodes[node].data; }             ///< The data of a live node.
+    const T& value(Handle node) const { return nodes[node].data; } ///< The data of a live node.
+
+    bool isEmpty() const { return head == None; }      ///< Checks if the list is empty.
+    std::size_t size() const { return count; }         ///< Returns the number of live nodes.
+
+private:
+    struct ArenaNode {
+        T data;
+        Handle next;
+        Handle prev;
+    };
+
+    std::vector<ArenaNode> nodes;
+    Handle head = None;
+    Handle tail = None;
+    Handle freeList = None;    ///< Erased slots, chained through `next`.
+    std::size_t count = 0;
+
+    Handle allocate(const T& data, Handle prev, Handle next);
+};
+
+/**
+ * @brief Takes a slot from the free list, or appends one to the arena.
+ * @return The handle of the initialized, not yet linked-in node.
+ */
+template <typename T>
+typename ArenaList<T>::Handle ArenaList<T>::allocate(const T& data, Handle prev, Handle next) {
+    Handle node;
+    if (freeList != None) {
+        node = freeList;
+        freeList = nodes[node].next;
+        nodes[node] = ArenaNode{ data, next, prev };
+    } else {
+        node = static_cast<Handle>(nodes.size());
+        nodes.push_back(ArenaNode{ data, next, prev });
+    }
+    count++;
+    return node;
+}
+
+template <typename T>
+typename ArenaList<T>::Handle ArenaList<T>::pushFront(const T& data) {
+    Handle node = allocate(data, None, head);
+    if (head != None) nodes[head].prev = node;
+    else tail = node;
+    head = node;
+    return node;
+}
+
+template <typename T>
+typename ArenaList<T>::Handle ArenaList<T>::pushBack(const T& data) {
+    Handle node = allocate(data, tail, None);
+    if (tail != None) nodes[tail].next = node;
+    else head = node;
+    tail = node;
+    return node;
+}
+
+/**
+ * @brief Inserts a node right after a given node.
+ * @param position A live node of this list.
+ * @param data The data to insert.
+ * @return The new node's handle.
+ */
+template <typename T>
+typename ArenaList<T>::Handle ArenaList<T>::insertAfter(Handle position, const T& data) {
+    Handle node = allocate(data, position, nodes[position].next);
+    Handle after = nodes[node].next;
+    nodes[position].next = node;
+    if (after != None) nodes[after].prev = node;
+    else tail = node;
+    return node;
+}
+
+/**
+ * @brief Unlinks a node and puts its slot on the free list.
+ * @param node A live node of this list; its handle is invalid afterwards.
+ */
+template <typename T>
+void ArenaList<T>::erase(Handle node) {
+    ArenaNode& current = nodes[node];
+    if (current.prev != None) nodes[current.prev].next = current.next;
+    else head = current.next;
+
+    if (current.next != None) nodes[current.next].prev = current.prev;
+    else tail = current.prev;
+
+    current.next = freeList;
+    freeList = node;
+    count--;
+}
+
+template <typename T>
+bool ArenaList<T>::popFront() {
+    if (head == None) return false;
+    erase(head);
+    return true;
+}
+
+template <typename T>
+bool ArenaList<T>::popBack() {
+    if (tail == None) return false;
+    erase(tail);
+    return true;
+}
+
+template <typename T>
+void ArenaList<T>::clear() {
+    nodes.clear();
+    head = tail = freeList = None;
+    count = 0;
+}
+
+template <typename T>
+void ArenaList<T>::reserve(std::size_t nodeCount) {
+    nodes.reserve(nodeCount);
+}
+
+#endif // ARENALIST_H
@@ -0,0 +1,146 @@
+//##################################################
+// File: BufferedWriter.h
+// Description: Large-buffer output to a FILE*, with fast shortest round-trip formatting of doubles.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef BUFFEREDWRITER_H
+#define BUFFEREDWRITER_H
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+class BufferedWriter {
+public:
+    /**
+     * @brief Creates a writer with a buffer of `capacity` bytes.
+     * @param out The stream that receives the data.
+     * @param capacity Buffer size; output is written in chunks of this size.
+     */
+    explicit BufferedWriter(std::FILE* out, std::size_t capacity = 1 << 20)
+        : out(out), buffer(capacity < 64 ? 64 : capacity), used(0), error(false) {}
+
+    ~BufferedWriter() { flush(); } ///< Flushes any buffered output.
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    /**
+     * @brief Appends raw bytes.
+     */
+    void write(const char* data, std::size_t size) {
+        if (size > buffer.size() - used) {
+            flush();
+            if (size > buffer.size()) {
+                if (std::fwrite(data, 1, size, out) != size) error = true;
+                return;
+            }
+        }
+        std::memcpy(buffer.data() + used, data, size);
+        used += size;
+    }
+
+    /**
+     * @brief Appends one character.
+     */
+    void put(char c) {
+        if (used == buffer.size()) flush();
+        buffer[used++] = c;
+    }
+
+    /**
+     * @brief Appends the shortest text that reads back as exactly `value`.
+     */
+    void writeDouble(double value) {
+        char text[32];
+        std::to_chars_result converted = std::to_chars(text, text + sizeof(text), value);
+        write(text, static_cast<std::size_t>(converted.ptr - text));
+    }
+
+    /**
+     * @brief Appends `value` with exactly `decimals` digits after the point, as printf's "%.*f" does.
+     * @param value The value to write.
+     * @param decimals Digits after the point, 0 to 9.
+     * @note While the scaled value stays below 1e18, it is computed exactly in 128-bit integers and
+     *       rounded half to even. That gives the digit string printf produces, at a fraction of
+     *       its cost. Larger, infinite and NaN values go through snprintf.
+     */
+    void writeFixed(double value, int decimals) {
+        static constexpr std::uint64_t Powers[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+        const double magnitude = value < 0 ? -value : value;
+        if (decimals < 0 || decimals > 9 || !(magnitude * static_cast<double>(Powers[decimals]) < 1e18)) {
+            char text[352];
+            int length = std::snprintf(text, sizeof(text), "%.*f", decimals, value);
+            write(text, static_cast<std::size_t>(length));
+            return;
+        }
+
+        // magnitude = f * 2^-shift exactly; f * 10^decimals < 2^83
+        std::uint64_t bits;
+        std::memcpy(&bits, &magnitude, sizeof(bits));
+        const int biased = static_cast<int>(bits >> 52);
+        const std::uint64_t f = (bits & ((1ULL << 52) - 1)) | (biased != 0 ? 1ULL << 52 : 0);
+        const int shift = 1075 - (biased != 0 ? biased : 1);
+        std::uint64_t scaled = 0;
+        if (shift <= 0) {
+            scaled = (f << -shift) * Powers[decimals]; // A whole number
+        } else if (shift < 84) {
+            const unsigned __int128 exact = static_cast<unsigned __int128>(f) * Powers[decimals];
+            const unsigned __int128 rest = exact & ((static_cast<unsigned __int128>(1) << shift) - 1);
+            const unsigned __int128 half = static_cast<unsigned __int128>(1) << (shift - 1);
+            scaled = static_cast<std::uint64_t>(exact >> shift);
+            if (rest > half || (rest == half && (scaled & 1) != 0)) scaled++;
+        } // Otherwise below half of the last digit: rounds to zero
+
+        char text[40];
+        char* end = text + sizeof(text);
+        char* p = end;
+        std::uint64_t whole = scaled / Powers[decimals];
+        std::uint64_t fraction = scaled - whole * Powers[decimals];
+        for (int i = 0; i < decimals; ++i, fraction /= 10) *--p = static_cast<char>('0' + fraction % 10);
+        if (decimals > 0) *--p = '.';
+        do {
+            *--p = static_cast<char>('0' + whole % 10);
+            whole /= 10;
+        } while (whole != 0);
+        if (std::signbit(value)) *--p = '-';
+        write(p, static_cast<std::size_t>(end - p));
+    }
+
+    /**
+     * @brief Appends a decimal integer.
+     */
+    void writeInt(long long value) {
+        char text[24];
+        std::to_chars_result converted = std::to_chars(text, text + sizeof(text), value);
+        write(text, static_cast<std::size_t>(converted.ptr - text));
+    }
+
+    /**
+     * @brief Writes the buffered bytes to the stream.
+     * @return False if any write so far has failed.
+     */
+    bool flush() {
+        if (used > 0) {
+            if (std::fwrite(buffer.data(), 1, used, out) != used) error = true;
+            used = 0;
+        }
+        return !error;
+    }
+
+    bool failed() const { return error; } ///< True if a write to the stream has failed.
+
+private:
+    std::FILE* out;
+    std::vector<char> buffer;
+    std::size_t used;
+    bool error;
+};
+
+#endif // BUFFEREDWRITER_H
@@ -0,0 +1,284 @@
+//##################################################
+// File: ColumnEvaluator.cpp
+// Description: Block-at-a-time evaluation of a Program over column arrays with AVX2/SSE2/scalar kernels.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "ColumnEvaluator.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define RPN_X86_SIMD 1
+#endif
+
+namespace {
+
+// Rows evaluated per block; a block of every stack slot stays resident in L1.
+const std::size_t BlockSize = 256;
+
+typedef void (*BinaryKernel)(const double* a, const double* b, double* out, std::size_t n);
+typedef void (*ZeroCheckKernel)(const double* divisor, unsigned char* errors, std::size_t n);
+
+struct Kernels {
+    BinaryKernel add;
+    BinaryKernel sub;
+    BinaryKernel mul;
+    BinaryKernel div;
+    ZeroCheckKernel markZeroDivisors;
+};
+
+struct AddOp {
+    static double scalar(double a, double b) { return a + b; }
+#ifdef RPN_X86_SIMD
+    static __m128d sse2(__m128d a, __m128d b) { return _mm_add_pd(a, b); }
+    __attribute__((target("avx2"))) static __m256d avx2(__m256d a, __m256d b) { return _mm256_add_pd(a, b); }
+#endif
+};
+
+struct SubOp {
+    static double scalar(double a, double b) { return a - b; }
+#ifdef RPN_X86_SIMD
+    static __m128d sse2(__m128d a, __m128d b) { return _mm_sub_pd(a, b); }
+    __attribute__((target("avx2"))) static __m256d avx2(__m256d a, __m256d b) { return _mm256_sub_pd(a, b); }
+#endif
+};
+
+struct MulOp {
+    static double scalar(double a, double b) { return a * b; }
+#ifdef RPN_X86_SIMD
+    static __m128d sse2(__m128d a, __m128d b) { return _mm_mul_pd(a, b); }
+    __attribute__((target("avx2"))) static __m256d avx2(__m256d a, __m256d b) { return _mm256_mul_pd(a, b); }
+#endif
+};
+
+struct DivOp {
+    static double scalar(double a, double b) { return a / b; }
+#ifdef RPN_X86_SIMD
+    static __m128d sse2(__m128d a, __m128d b) { return _mm_div_pd(a, b); }
+    __attribute__((target("avx2"))) static __m256d avx2(__m256d a, __m256d b) { return _mm256_div_pd(a, b); }
+#endif
+};
+
+template <typename Op>
+void binaryScalar(const double* a, const double* b, double* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = Op::scalar(a[i], b[i]);
+}
+
+void markZeroDivisorsScalar(const double* divisor, unsigned char* errors, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (divisor[i] == 0) errors[i] = 3;
+    }
+}
+
+#ifdef RPN_X86_SIMD
+template <typename Op>
+void binarySse2(const double* a, const double* b, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        _mm_storeu_pd(out + i, Op::sse2(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    }
+    for (; i < n; ++i) out[i] = Op::scalar(a[i], b[i]);
+}
+
+void markZeroDivisorsSse2(const double* divisor, unsigned char* errors, std::size_t n) {
+    const __m128d zero = _mm_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        int mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(divisor + i), zero));
+        if (mask & 1) errors[i] = 3;
+        if (mask & 2) errors[i + 1] = 3;
+    }
+    markZeroDivisorsScalar(divisor + i, errors + i, n - i);
+}
+
+template <typename Op>
+__attribute__((target("avx2"))) void binaryAvx2(const double* a, const double* b, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(out + i, Op::avx2(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    }
+    for (; i < n; ++i) out[i] = Op::scalar(a[i], b[i]);
+}
+
+__attribute__((target("avx2"))) void markZeroDivisorsAvx2(const double* divisor, unsigned char* errors, std::size_t n) {
+    const __m256d zero = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(divisor + i), zero, _CMP_EQ_OQ));
+        while (mask != 0) {
+            errors[i + __builtin_ctz(mask)] = 3;
+            mask &= mask - 1;
+        }
+    }
+    markZeroDivisorsScalar(divisor + i, errors + i, n - i);
+}
+#endif
+
+const Kernels ScalarKernels = {
+    binaryScalar<AddOp>, binaryScalar<SubOp>, binaryScalar<MulOp>, binaryScalar<DivOp>, markZeroDivisorsScalar
+};
+
+#ifdef RPN_X86_SIMD
+const Kernels Sse2Kernels = {
+    binarySse2<AddOp>, binarySse2<SubOp>, binarySse2<MulOp>, binarySse2<DivOp>, markZeroDivisorsSse2
+};
+
+const Kernels Avx2Kernels = {
+    binaryAvx2<AddOp>, binaryAvx2<SubOp>, binaryAvx2<MulOp>, binaryAvx2<DivOp>, markZeroDivisorsAvx2
+};
+#endif
+
+const Kernels& kernelsFor(SimdLevel level) {
+    if (level == SimdLevel::Auto) level = detectSimdLevel();
+#ifdef RPN_X86_SIMD
+    if (level == SimdLevel::AVX2 && detectSimdLevel() == SimdLevel::AVX2) return Avx2Kernels;
+    if (level == SimdLevel::AVX2 || level == SimdLevel::SSE2) return Sse2Kernels;
+#endif
+    return ScalarKernels;
+}
+
+/**
+ * @brief One operand stack entry for the current block: either a broadcast scalar or a column of values.
+ * @note Variables point straight into the caller's columns, so they are never copied.
+ */
+struct Slot {
+    const double* values;
+    double scalar;
+    bool isScalar;
+};
+
+double applyScalar(const Instruction& ins, double a, double b) {
+    switch (ins.op) {
+    case OpCode::Add: return AddOp::scalar(a, b);
+    case OpCode::Sub: return SubOp::scalar(a, b);
+    case OpCode::Mul: return MulOp::scalar(a, b);
+    case OpCode::Div: return DivOp::scalar(a, b);
+    case OpCode::Pow: return std::pow(a, b);
+    case OpCode::Neg: return -a;
+    default: return callFunction(static_cast<Function>(ins.operand), a, b);
+    }
+}
+
+/**
+ * @brief Returns the SIMD kernel for an arithmetic operator, or null for the library-call operations.
+ */
+BinaryKernel kernelFor(const Kernels& kernels, OpCode op) {
+    switch (op) {
+    case OpCode::Add: return kernels.add;
+    case OpCode::Sub: return kernels.sub;
+    case OpCode::Mul: return kernels.mul;
+    case OpCode::Div: return kernels.div;
+    default: return nullptr;
+    }
+}
+
+const double* broadcast(double* buffer, double value, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) buffer[i] = value;
+    return buffer;
+}
+
+} // namespace
+
+/**
+ * @brief Evaluates `program` once per row, a block of rows at a time.
+ * @param program A compiled expression; `columns[i]` holds the values of `program.variables[i]`.
+ * @param columns One array of `rows` values per variable slot.
+ * @param rows Number of rows to evaluate.
+ * @param results Receives one result per row (0 for rows that failed).
+ * @param errorMask Receives one error code per row: 0 for success, 3 for division by zero.
+ * @param level Kernel set to use.
+ * @return The program's compile error code (1 if variables are unbound); when non-zero nothing is written.
+ * @note Each instruction runs over a whole block before the next one starts. IEEE +, -, * and / are
+ *       exact per lane, so every kernel level matches `RPNCalculator::run` bit for bit; '^', negation
+ *       and function calls use the same library calls as `run`.
+ */
+int evaluateColumns(const Program& program, const double* const* columns, std::size_t rows,
+                    double* results, unsigned char* errorMask, SimdLevel level) {
+    if (program.errorCode != 0) return program.errorCode;
+    if (columns == nullptr && !program.variables.empty()) return 1; // Unbound variables
+
+    const Kernels& kernels = kernelsFor(level);
+    const std::size_t depth = program.maxDepth > 0 ? static_cast<std::size_t>(program.maxDepth) : 1;
+
+    // One block buffer per stack position plus two for broadcasting scalar operands
+    std::vector<double> scratch((depth + 2) * BlockSize);
+    std::vector<Slot> slots(depth);
+    double* broadcastA = scratch.data() + depth * BlockSize;
+    double* broadcastB = broadcastA + BlockSize;
+
+    for (std::size_t start = 0; start < rows; start += BlockSize) {
+        const std::size_t n = rows - start < BlockSize ? rows - start : BlockSize;
+        unsigned char* errors = errorMask + start;
+        std::memset(errors, 0, n);
+
+        std::size_t sp = 0;
+        for (const Instruction& ins : program.code) {
+            if (ins.op == OpCode::PushConst) {
+                slots[sp].scalar = program.constants[ins.operand];
+                slots[sp].isScalar = true;
+                sp++;
+                continue;
+            }
+            if (ins.op == OpCode::PushVar) {
+                slots[sp].values = columns[ins.operand] + start;
+                slots[sp].isScalar = false;
+                sp++;
+                continue;
+            }
+
+            if (ins.op == OpCode::Neg || ins.op == OpCode::Call1) {
+                Slot& top = slots[sp - 1];
+                if (top.isScalar) {
+                    top.scalar = applyScalar(ins, top.scalar, 0.0);
+                    continue;
+                }
+                double* out = scratch.data() + (sp - 1) * BlockSize;
+                for (std::size_t i = 0; i < n; ++i) out[i] = applyScalar(ins, top.values[i], 0.0);
+                top.values = out;
+                continue;
+            }
+
+            const Slot rhs = slots[--sp];
+            Slot& lhs = slots[sp - 1];
+
+            if (lhs.isScalar && rhs.isScalar) {
+                if (ins.op == OpCode::Div && rhs.scalar == 0) {
+                    std::memset(errors, 3, n); // Division by zero on every row
+                }
+                lhs.scalar = applyScalar(ins, lhs.scalar, rhs.scalar);
+                continue;
+            }
+
+            const double* a = lhs.isScalar ? broadcast(broadcastA, lhs.scalar, n) : lhs.values;
+            const double* b = rhs.isScalar ? broadcast(broadcastB, rhs.scalar, n) : rhs.values;
+            double* out = scratch.data() + (sp - 1) * BlockSize;
+
+            if (ins.op == OpCode::Div) kernels.markZeroDivisors(b, errors, n);
+            BinaryKernel kernel = kernelFor(kernels, ins.op);
+            if (kernel) {
+                kernel(a, b, out, n);
+            } else {
+                // '^' and two-argument functions are library calls; run them row by row
+                for (std::size_t i = 0; i < n; ++i) out[i] = applyScalar(ins, a[i], b[i]);
+            }
+
+            lhs.values = out;
+            lhs.isScalar = false;
+        }
+
+        double* blockResults = results + start;
+        if (slots[0].isScalar) broadcast(blockResults, slots[0].scalar, n);
+        else std::memcpy(blockResults, slots[0].values, n * sizeof(double));
+
+        for (std::size_t i = 0; i < n; ++i) {
+            if (errors[i] != 0) blockResults[i] = 0.0;
+        }
+    }
+    return 0;
+}
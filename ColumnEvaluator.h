@@ -0,0 +1,30 @@
+//##################################################
+// File: ColumnEvaluator.h
+// Description: Evaluates one compiled expression over columns of inputs using SIMD kernels.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef COLUMNEVALUATOR_H
+#define COLUMNEVALUATOR_H
+
+#include "Program.h"
+#include "SimdLevel.h"
+
+#include <cstddef>
+
+/**
+ * @brief Evaluates `program` once per row.
+ * @param program A compiled expression; `columns[i]` holds the values of `program.variables[i]`.
+ * @param columns One array of `rows` values per variable slot (may be null if there are no variables).
+ * @param rows Number of rows to evaluate.
+ * @param results Receives one result per row (0 for rows that failed).
+ * @param errorMask Receives one error code per row: 0 for success, 3 for division by zero.
+ * @param level Kernel set to use; every level produces bit-identical results.
+ * @return The program's compile error code; when non-zero nothing is written.
+ */
+int evaluateColumns(const Program& program, const double* const* columns, std::size_t rows,
+                    double* results, unsigned char* errorMask, SimdLevel level = SimdLevel::Auto);
+
+#endif // COLUMNEVALUATOR_H
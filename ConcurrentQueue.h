@@ -0,0 +1,606 @@
+//##################################################
+// File: ConcurrentQueue.h
+// Description: Lock-free bounded single-producer/single-consumer and multi-producer/multi-consumer queues with blocking waits.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef CONCURRENTQUEUE_H
+#define CONCURRENTQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#if defined(__SANITIZE_THREAD__)
+#define RPN_TSAN 1
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define RPN_TSAN 1
+#endif
+#endif
+#ifndef RPN_TSAN
+#define RPN_TSAN 0
+#endif
+
+namespace concurrent_detail {
+
+const std::size_t CacheLine = 64;
+
+/**
+ * @brief Rounds a requested capacity up to a power of two (at least 2) so slots are found with a mask.
+ */
+inline std::size_t slotCount(std::size_t capacity) {
+    std::size_t count = 2;
+    while (count < capacity) count *= 2;
+    return count;
+}
+
+/**
+ * @brief Spinning only helps when the thread being waited for runs on another core.
+ */
+inline bool spinningHelps() {
+    static const bool multicore = std::thread::hardware_concurrency() > 1;
+    return multicore;
+}
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+/**
+ * @brief Where threads sleep until the queue changes: a short spin (on multicore machines), a few
+ *        yields, then a futex wait.
+ * @note `notify` costs a fence and a load unless somebody is actually asleep. Waiters announce
+ *       themselves before their final check, and notifiers publish before checking for waiters, so
+ *       (both sides being fenced) at least one of them sees the other and no wake-up is lost.
+ */
+class WaitPoint {
+public:
+    template <typename Ready>
+    void wait(Ready&& ready) {
+        for (int spin = spinningHelps() ? 0 : SpinLimit; spin < SpinLimit; ++spin) {
+            if (ready()) return;
+            cpuRelax();
+        }
+        for (int yield = 0; yield < YieldLimit; ++yield) {
+            if (ready()) return;
+            std::this_thread::yield();
+        }
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        for (;;) {
+            std::uint32_t seen = epoch.load(std::memory_order_acquire);
+#if !RPN_TSAN
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+#endif
+            if (ready()) break;
+            epoch.wait(seen, std::memory_order_acquire);
+        }
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void notify() {
+#if RPN_TSAN
+        // ThreadSanitizer does not model fences; a read-modify-write on `waiters` orders the same way
+        if (waiters.fetch_add(0, std::memory_order_seq_cst) == 0) return;
+#else
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) == 0) return;
+#endif
+        epoch.fetch_add(1, std::memory_order_release);
+        epoch.notify_all();
+    }
+
+private:
+    static const int SpinLimit = 64;
+    static const int YieldLimit = 8;
+
+    std::atomic<std::uint32_t> epoch{ 0 };
+    std::atomic<std::uint32_t> waiters{ 0 };
+};
+
+} // namespace concurrent_detail
+
+/**
+ * @brief Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ * @note The producer owns `tail` and the consumer owns `head`, each on its own cache line together
+ *       with a cached copy of the other side's index, so the shared lines are touched only when the
+ *       cached copy says the queue looks full or empty. `close` wakes blocked threads; after it,
+ *       enqueues fail and dequeues drain what is left.
+ */
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(std::size_t capacity);  ///< Creates a queue holding at least `capacity` elements.
+    ~SpscQueue();                              ///< Destroys the elements still queued.
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side
+    bool tryEnqueue(const T& data);            ///< Adds an element unless the queue is full.
+    bool tryEnqueue(T&& data);                 ///< Adds an element by moving it unless the queue is full.
+    bool enqueue(const T& data);               ///< Waits for room, then adds; false once closed.
+    bool enqueue(T&& data);                    ///< Waits for room, then adds by moving; false once closed.
+    template <typename Iterator>
+    std::size_t tryEnqueueBatch(Iterator first, std::size_t count); ///< Adds as many of `count` elements as fit.
+
+    // Consumer side
+    bool tryDequeue(T& out);                   ///< Moves the front element into `out` unless the queue is empty.
+    bool dequeue(T& out);                      ///< Waits for an element; false once closed and drained.
+    bool peek(T& out) const;                   ///< Copies the front element without removing it.
+    std::size_t tryDequeueBatch(T* out, std::size_t maxCount); ///< Moves up to `maxCount` elements into `out`.
+    std::size_t dequeueBatch(T* out, std::size_t maxCount);    ///< Waits for at least one element, then takes up to `maxCount`.
+
+    void close();                              ///< Rejects further enqueues and wakes every waiting thread.
+    bool isClosed() const { return closed.load(std::memory_order_acquire); } ///< True after `close`.
+    bool isEmpty() const;                      ///< Checks if the queue is empty (a snapshot).
+    std::size_t size() const;                  ///< Returns the number of queued elements (a snapshot).
+    std::size_t capacity() const { return mask + 1; } ///< Returns the number of slots.
+
+private:
+    alignas(concurrent_detail::CacheLine) std::atomic<std::size_t> head{ 0 }; ///< Next slot to read; written by the consumer.
+    std::size_t cachedTail = 0;                                                ///< Consumer's last view of `tail`.
+    alignas(concurrent_detail::CacheLine) std::atomic<std::size_t> tail{ 0 }; ///< Next slot to write; written by the producer.
+    std::size_t cachedHead = 0;                                                ///< Producer's last view of `head`.
+    alignas(concurrent_detail::CacheLine) T* slots;
+    std::size_t mask;
+    std::atomic<bool> closed{ false };
+    concurrent_detail::WaitPoint notEmpty;
+    concurrent_detail::WaitPoint notFull;
+
+    std::size_t freeSlots(std::size_t position);
+    std::size_t readySlots(std::size_t position);
+    template <typename U>
+    bool pushOne(U&& data);
+};
+
+template <typename T>
+SpscQueue<T>::SpscQueue(std::size_t capacity) : mask(concurrent_detail::slotCount(capacity) - 1) {
+    slots = static_cast<T*>(::operator new((mask + 1) * sizeof(T), std::align_val_t(alignof(T))));
+}
+
+template <typename T>
+SpscQueue<T>::~SpscQueue() {
+    for (std::size_t position = head.load(std::memory_order_relaxed); position != tail.load(std::memory_order_relaxed); ++position) {
+        slots[position & mask].~T();
+    }
+    ::operator delete(slots, std::align_val_t(alignof(T)));
+}
+
+/**
+ * @brief Producer only: number of free slots from `position`, rereading `head` only when the cached copy says full.
+ */
+template <typename T>
+std::size_t SpscQueue<T>::freeSlots(std::size_t position) {
+    std::size_t available = mask + 1 - (position - cachedHead);
+    if (available == 0) {
+        cachedHead = head.load(std::memory_order_acquire);
+        available = mask + 1 - (position - cachedHead);
+    }
+    return available;
+}
+
+/**
+ * @brief Consumer only: number of filled slots from `position`, rereading `tail` only when the cached copy says empty.
+ */
+template <typename T>
+std::size_t SpscQueue<T>::readySlots(std::size_t position) {
+    std::size_t available = cachedTail - position;
+    if (available == 0) {
+        cachedTail = tail.load(std::memory_order_acquire);
+        available = cachedTail - position;
+    }
+    return available;
+}
+
+template <typename T>
+template <typename U>
+bool SpscQueue<T>::pushOne(U&& data) {
+    std::size_t position = tail.load(std::memory_order_relaxed);
+    if (freeSlots(position) == 0) return false;
+    new (slots + (position & mask)) T(std::forward<U>(data));
+    tail.store(position + 1, std::memory_order_release);
+    notEmpty.notify();
+    return true;
+}
+
+template <typename T>
+bool SpscQueue<T>::tryEnqueue(const T& data) {
+    return pushOne(data);
+}
+
+template <typename T>
+bool SpscQueue<T>::tryEnqueue(T&& data) {
+    return pushOne(std::move(data));
+}
+
+/**
+ * @brief Adds an element, sleeping while the queue is full.
+ * @param data The data to add.
+ * @return True once added; false if the queue was closed first.
+ */
+template <typename T>
+bool SpscQueue<T>::enqueue(const T& data) {
+    for (;;) {
+        if (isClosed()) return false;
+        if (pushOne(data)) return true;
+        notFull.wait([this] { return isClosed() || freeSlots(tail.load(std::memory_order_relaxed)) > 0; });
+    }
+}
+
+template <typename T>
+bool SpscQueue<T>::enqueue(T&& data) {
+    for (;;) {
+        if (isClosed()) return false;
+        if (pushOne(std::move(data))) return true;
+        notFull.wait([this] { return isClosed() || freeSlots(tail.load(std::memory_order_relaxed)) > 0; });
+    }
+}
+
+/**
+ * @brief Adds up to `count` elements with a single publication of the tail index.
+ * @param first Start of the elements; wrap it in std::make_move_iterator to move them.
+ * @param count Number of elements offered.
+ * @return The number of elements added (those that fitted, from the front).
+ */
+template <typename T>
+template <typename Iterator>
+std::size_t SpscQueue<T>::tryEnqueueBatch(Iterator first, std::size_t count) {
+    std::size_t position = tail.load(std::memory_order_relaxed);
+    std::size_t available = freeSlots(position);
+    std::size_t added = count < available ? count : available;
+    for (std::size_t i = 0; i < added; ++i, ++first) {
+        new (slots + ((position + i) & mask)) T(*first);
+    }
+    if (added) {
+        tail.store(position + added, std::memory_order_release);
+        notEmpty.notify();
+    }
+    return added;
+}
+
+template <typename T>
+bool SpscQueue<T>::tryDequeue(T& out) {
+    return tryDequeueBatch(&out, 1) == 1;
+}
+
+/**
+ * @brief Takes the front element, sleeping while the queue is empty.
+ * @param out Receives the element.
+ * @return True if an element was taken; false once the queue is closed and empty.
+ */
+template <typename T>
+bool SpscQueue<T>::dequeue(T& out) {
+    return dequeueBatch(&out, 1) == 1;
+}
+
+/**
+ * @brief Consumer only: copies the front element.
+ * @param out Receives the copy.
+ * @return False if the queue is empty.
+ */
+template <typename T>
+bool SpscQueue<T>::peek(T& out) const {
+    std::size_t position = head.load(std::memory_order_relaxed);
+    if (tail.load(std::memory_order_acquire) == position) return false;
+    out = slots[position & mask];
+    return true;
+}
+
+/**
+ * @brief Moves up to `maxCount` elements into `out` with a single publication of the head index.
+ * @param out Destination of at least `maxCount` constructed elements, which are assigned to.
+ * @param maxCount Maximum number of elements to take.
+ * @return The number of elements taken.
+ */
+template <typename T>
+std::size_t SpscQueue<T>::tryDequeueBatch(T* out, std::size_t maxCount) {
+    std::size_t position = head.load(std::memory_order_relaxed);
+    std::size_t available = readySlots(position);
+    std::size_t taken = maxCount < available ? maxCount : available;
+    for (std::size_t i = 0; i < taken; ++i) {
+        T& item = slots[(position + i) & mask];
+        out[i] = std::move(item);
+        item.~T();
+    }
+    if (taken) {
+        head.store(position + taken, std::memory_order_release);
+        notFull.notify();
+    }
+    return taken;
+}
+
+template <typename T>
+std::size_t SpscQueue<T>::dequeueBatch(T* out, std::size_t maxCount) {
+    for (;;) {
+        std::size_t taken = tryDequeueBatch(out, maxCount);
+        if (taken || maxCount == 0) return taken;
+        if (isClosed()) {
+            // The producer may have added elements just before closing
+            return tryDequeueBatch(out, maxCount);
+        }
+        notEmpty.wait([this] { return isClosed() || readySlots(head.load(std::memory_order_relaxed)) > 0; });
+    }
+}
+
+template <typename T>
+void SpscQueue<T>::close() {
+    closed.store(true, std::memory_order_release);
+    notEmpty.notify();
+    notFull.notify();
+}
+
+template <typename T>
+bool SpscQueue<T>::isEmpty() const {
+    return size() == 0;
+}
+
+template <typename T>
+std::size_t SpscQueue<T>::size() const {
+    std::size_t first = head.load(std::memory_order_acquire);
+    std::size_t last = tail.load(std::memory_order_acquire);
+    return last > first ? last - first : 0;
+}
+
+/**
+ * @brief Bounded lock-free queue for any number of producer and consumer threads.
+ * @note Each slot carries a sequence number that says whose turn it is (Vyukov's bounded MPMC
+ *       design): producers and consumers claim positions with one compare-and-swap on their own,
+ *       cache-line-padded index and then only touch the claimed slot. There is no `peek`: with
+ *       several consumers the front can be taken between looking and acting. Call `close` once the
+ *       producers are done: an enqueue still in flight when the queue is closed may be missed by
+ *       consumers that are already draining.
+ */
+template <typename T>
+class MpmcQueue {
+public:
+    explicit MpmcQueue(std::size_t capacity);  ///< Creates a queue holding at least `capacity` elements.
+    ~MpmcQueue();                              ///< Destroys the elements still queued.
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    bool tryEnqueue(const T& data);            ///< Adds an element unless the queue is full.
+    bool tryEnqueue(T&& data);                 ///< Adds an element by moving it unless the queue is full.
+    bool enqueue(const T& data);               ///< Waits for room, then adds; false once closed.
+    bool enqueue(T&& data);                    ///< Waits for room, then adds by moving; false once closed.
+    template <typename Iterator>
+    std::size_t tryEnqueueBatch(Iterator first, std::size_t count); ///< Adds elements until one does not fit.
+
+    bool tryDequeue(T& out);                   ///< Moves the front element into `out` unless the queue is empty.
+    bool dequeue(T& out);                      ///< Waits for an element; false once closed and drained.
+    std::size_t tryDequeueBatch(T* out, std::size_t maxCount); ///< Moves up to `maxCount` elements into `out`.
+    std::size_t dequeueBatch(T* out, std::size_t maxCount);    ///< Waits for at least one element, then takes up to `maxCount`.
+
+    void close();                              ///< Rejects further enqueues and wakes every waiting thread.
+    bool isClosed() const { return closed.load(std::memory_order_acquire); } ///< True after `close`.
+    bool isEmpty() const;                      ///< Checks if the queue is empty (a snapshot).
+    std::size_t size() const;                  ///< Returns the number of queued elements (a snapshot).
+    std::size_t capacity() const { return mask + 1; } ///< Returns the number of slots.
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;     ///< `position` when free for that enqueue, `position + 1` when filled.
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* item() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    alignas(concurrent_detail::CacheLine) std::atomic<std::size_t> enqueuePosition{ 0 };
+    alignas(concurrent_detail::CacheLine) std::atomic<std::size_t> dequeuePosition{ 0 };
+    alignas(concurrent_detail::CacheLine) Cell* cells;
+    std::size_t mask;
+    std::atomic<bool> closed{ false };
+    concurrent_detail::WaitPoint notEmpty;
+    concurrent_detail::WaitPoint notFull;
+
+    template <typename U>
+    bool pushOne(U&& data);
+    bool popOne(T& out);
+    bool hasRoom() const;
+    bool hasItem() const;
+};
+
+template <typename T>
+MpmcQueue<T>::MpmcQueue(std::size_t capacity) : mask(concurrent_detail::slotCount(capacity) - 1) {
+    cells = static_cast<Cell*>(::operator new((mask + 1) * sizeof(Cell), std::align_val_t(alignof(Cell))));
+    for (std::size_t i = 0; i <= mask; ++i) {
+        new (&cells[i].sequence) std::atomic<std::size_t>(i);
+    }
+}
+
+template <typename T>
+MpmcQueue<T>::~MpmcQueue() {
+    std::size_t last = enqueuePosition.load(std::memory_order_relaxed);
+    for (std::size_t position = dequeuePosition.load(std::memory_order_relaxed); position != last; ++position) {
+        cells[position & mask].item()->~T();
+    }
+    for (std::size_t i = 0; i <= mask; ++i) cells[i].sequence.~atomic();
+    ::operator delete(cells, std::align_val_t(alignof(Cell)));
+}
+
+/**
+ * @brief Claims the next enqueue position whose cell is free, then fills and publishes it.
+ * @return False if the queue is full.
+ */
+template <typename T>
+template <typename U>
+bool MpmcQueue<T>::pushOne(U&& data) {
+    std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells[position & mask];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+        if (difference == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+        } else if (difference < 0) {
+            return false; // The cell still holds the element from one lap ago
+        } else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+    new (cell->storage) T(std::forward<U>(data));
+    cell->sequence.store(position + 1, std::memory_order_release);
+    notEmpty.notify();
+    return true;
+}
+
+/**
+ * @brief Claims the next dequeue position whose cell is filled, then empties it for the next lap.
+ * @return False if the queue is empty.
+ */
+template <typename T>
+bool MpmcQueue<T>::popOne(T& out) {
+    std::size_t position = dequeuePosition.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells[position & mask];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+        if (difference == 0) {
+            if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = dequeuePosition.load(std::memory_order_relaxed);
+        }
+    }
+    T* item = cell->item();
+    out = std::move(*item);
+    item->~T();
+    cell->sequence.store(position + mask + 1, std::memory_order_release);
+    notFull.notify();
+    return true;
+}
+
+template <typename T>
+bool MpmcQueue<T>::hasRoom() const {
+    std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    return static_cast<std::intptr_t>(cells[position & mask].sequence.load(std::memory_order_acquire) - position) >= 0;
+}
+
+template <typename T>
+bool MpmcQueue<T>::hasItem() const {
+    std::size_t position = dequeuePosition.load(std::memory_order_relaxed);
+    return static_cast<std::intptr_t>(cells[position & mask].sequence.load(std::memory_order_acquire) - (position + 1)) >= 0;
+}
+
+template <typename T>
+bool MpmcQueue<T>::tryEnqueue(const T& data) {
+    return pushOne(data);
+}
+
+template <typename T>
+bool MpmcQueue<T>::tryEnqueue(T&& data) {
+    return pushOne(std::move(data));
+}
+
+/**
+ * @brief Adds an element, sleeping while the queue is full.
+ * @param data The data to add.
+ * @return True once added; false if the queue was closed first.
+ */
+template <typename T>
+bool MpmcQueue<T>::enqueue(const T& data) {
+    for (;;) {
+        if (isClosed()) return false;
+        if (pushOne(data)) return true;
+        notFull.wait([this] { return isClosed() || hasRoom(); });
+    }
+}
+
+template <typename T>
+bool MpmcQueue<T>::enqueue(T&& data) {
+    for (;;) {
+        if (isClosed()) return false;
+        if (pushOne(std::move(data))) return true;
+        notFull.wait([this] { return isClosed() || hasRoom(); });
+    }
+}
+
+/**
+ * @brief Adds elements one by one until the queue is full.
+ * @param first Start of the elements; wrap it in std::make_move_iterator to move them.
+ * @param count Number of elements offered.
+ * @return The number of elements added, from the front; other producers may interleave with them.
+ */
+template <typename T>
+template <typename Iterator>
+std::size_t MpmcQueue<T>::tryEnqueueBatch(Iterator first, std::size_t count) {
+    std::size_t added = 0;
+    for (; added < count; ++added, ++first) {
+        if (!pushOne(*first)) break;
+    }
+    return added;
+}
+
+template <typename T>
+bool MpmcQueue<T>::tryDequeue(T& out) {
+    return popOne(out);
+}
+
+/**
+ * @brief Takes the front element, sleeping while the queue is empty.
+ * @param out Receives the element.
+ * @return True if an element was taken; false once the queue is closed and empty.
+ */
+template <typename T>
+bool MpmcQueue<T>::dequeue(T& out) {
+    return dequeueBatch(&out, 1) == 1;
+}
+
+template <typename T>
+std::size_t MpmcQueue<T>::tryDequeueBatch(T* out, std::size_t maxCount) {
+    std::size_t taken = 0;
+    while (taken < maxCount && popOne(out[taken])) taken++;
+    return taken;
+}
+
+template <typename T>
+std::size_t MpmcQueue<T>::dequeueBatch(T* out, std::size_t maxCount) {
+    for (;;) {
+        std::size_t taken = tryDequeueBatch(out, maxCount);
+        if (taken || maxCount == 0) return taken;
+        if (isClosed()) {
+            // A producer may have finished an enqueue just before the close
+            return tryDequeueBatch(out, maxCount);
+        }
+        notEmpty.wait([this] { return isClosed() || hasItem(); });
+    }
+}
+
+template <typename T>
+void MpmcQueue<T>::close() {
+    closed.store(true, std::memory_order_release);
+    notEmpty.notify();
+    notFull.notify();
+}
+
+template <typename T>
+bool MpmcQueue<T>::isEmpty() const {
+    return size() == 0;
+}
+
+template <typename T>
+std::size_t MpmcQueue<T>::size() const {
+    std::size_t first = dequeuePosition.load(std::memory_order_acquire);
+    std::size_t last = enqueuePosition.load(std::memory_order_acquire);
+    return last > first ? last - first : 0;
+}
+
+#endif // CONCURRENTQUEUE_H
@@ -0,0 +1,559 @@
+//##################################################
+// File: ConstexprCalculator.h
+// Description: Compile-time parsing of string-literal RPN and infix expressions into constants or inlined callables.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef CONSTEXPRCALCULATOR_H
+#define CONSTEXPRCALCULATOR_H
+
+#include "Program.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief A string literal usable as a template argument, e.g. rpnValue<"3 2 5 * +">.
+ */
+template <std::size_t N>
+struct FixedString {
+    char text[N];
+
+    constexpr FixedString(const char (&literal)[N]) : text() {
+        for (std::size_t i = 0; i < N; ++i) text[i] = literal[i];
+    }
+
+    constexpr std::size_t size() const { return N - 1; } ///< Length without the terminator.
+};
+
+/**
+ * @brief A Program built during compilation; sized so that any N-character expression fits.
+ * @note Variables are identified by where their first occurrence starts in the expression text, in
+ *       first-appearance order like `Program::variables`.
+ */
+template <std::size_t N>
+struct StaticProgram {
+    Instruction code[N] = {};
+    double constants[N] = {};
+    std::size_t variableStart[N] = {};
+    std::size_t variableLength[N] = {};
+    std::size_t codeSize = 0;
+    std::size_t constantCount = 0;
+    std::size_t variableCount = 0;
+};
+
+/**
+ * @brief Reports a malformed expression. Deliberately not constexpr: reaching it during constant
+ *        evaluation stops compilation, and the diagnostic shows the reason passed in.
+ */
+inline void constexprExpressionError(const char* reason) {
+    (void)reason;
+}
+
+namespace constexpr_detail {
+
+constexpr bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * @brief Emits postfix instructions and tracks stack depth, like ProgramBuilder but at compile time.
+ */
+template <std::size_t N>
+struct StaticBuilder {
+    const char* text;
+    StaticProgram<N> program;
+    int depth = 0;
+
+    constexpr explicit StaticBuilder(const char* expression) : text(expression), program() {}
+
+    constexpr void emit(OpCode op, unsigned int operand) {
+        program.code[program.codeSize].op = op;
+        program.code[program.codeSize].operand = operand;
+        program.codeSize++;
+    }
+
+    constexpr void pushConstant(double value) {
+        program.constants[program.constantCount] = value;
+        emit(OpCode::PushConst, static_cast<unsigned int>(program.constantCount++));
+        depth++;
+    }
+
+    constexpr void pushVariable(std::size_t start, std::size_t length) {
+        std::size_t slot = 0;
+        for (; slot < program.variableCount; ++slot) {
+            if (program.variableLength[slot] != length) continue;
+            std::size_t i = 0;
+            while (i < length && text[program.variableStart[slot] + i] == text[start + i]) i++;
+            if (i == length) break;
+        }
+        if (slot == program.variableCount) {
+            program.variableStart[slot] = start;
+            program.variableLength[slot] = length;
+            program.variableCount++;
+        }
+        emit(OpCode::PushVar, static_cast<unsigned int>(slot));
+        depth++;
+    }
+
+    constexpr void applyOperator(OpCode op) {
+        if (depth < 2) constexprExpressionError("insufficient operands");
+        if (op == OpCode::Div) {
+            const Instruction& divisor = program.code[program.codeSize - 1];
+            if (divisor.op == OpCode::PushConst && program.constants[divisor.operand] == 0) {
+                constexprExpressionError("division by a literal zero");
+            }
+        }
+        emit(op, 0);
+        depth--;
+    }
+
+    constexpr void applyNegate() {
+        if (depth < 1) constexprExpressionError("insufficient operands");
+        const Instruction& last = program.code[program.codeSize - 1];
+        if (last.op == OpCode::PushConst && last.operand + 1 == program.constantCount) {
+            program.constants[last.operand] = -program.constants[last.operand];
+            return;
+        }
+        emit(OpCode::Neg, 0);
+    }
+
+    constexpr StaticProgram<N> finish() {
+        if (depth == 0) constexprExpressionError("insufficient operands");
+        if (depth > 1) constexprExpressionError("too many operands");
+        return program;
+    }
+};
+
+/**
+ * @brief Converts a decimal literal exactly as `parseDouble` would.
+ * @note Only Clinger's exact case (at most 2^53 with a power of ten up to 1e22) can be evaluated without
+ *       the runtime tables, so longer literals are rejected rather than risk a different rounding.
+ */
+constexpr double parseLiteral(const char* text, std::size_t begin, std::size_t end) {
+    const double powersOfTen[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    std::size_t p = begin;
+    bool negative = false;
+    if (p < end && (text[p] == '-' || text[p] == '+')) negative = text[p++] == '-';
+
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    for (; p < end && isDigit(text[p]); ++p, ++digits) {
+        if (mantissa > (std::uint64_t(1) << 53)) constexprExpressionError("literal has too many digits to convert at compile time");
+        mantissa = mantissa * 10 + static_cast<std::uint64_t>(text[p] - '0');
+    }
+    if (p < end && text[p] == '.') {
+        for (++p; p < end && isDigit(text[p]); ++p, ++digits, --exponent) {
+            if (mantissa > (std::uint64_t(1) << 53)) constexprExpressionError("literal has too many digits to convert at compile time");
+            mantissa = mantissa * 10 + static_cast<std::uint64_t>(text[p] - '0');
+        }
+    }
+    if (digits == 0) constexprExpressionError("malformed number");
+
+    if (p < end && (text[p] == 'e' || text[p] == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if (p < end && (text[p] == '-' || text[p] == '+')) negativeExponent = text[p++] == '-';
+        if (p == end || !isDigit(text[p])) constexprExpressionError("malformed number");
+        int value = 0;
+        for (; p < end && isDigit(text[p]); ++p) {
+            if (value < 10000) value = value * 10 + (text[p] - '0');
+        }
+        exponent += negativeExponent ? -value : value;
+    }
+    if (p != end) constexprExpressionError("malformed number");
+
+    if (mantissa > (std::uint64_t(1) << 53)) constexprExpressionError("literal has too many digits to convert at compile time");
+    double result = static_cast<double>(mantissa);
+    if (mantissa != 0) {
+        if (exponent < -22 || exponent > 22) constexprExpressionError("literal exponent too large to convert at compile time");
+        result = exponent < 0 ? result / powersOfTen[-exponent] : result * powersOfTen[exponent];
+    }
+    return negative ? -result : result;
+}
+
+constexpr bool isIdentifierStartChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+constexpr bool isIdentifierContinuation(char c) {
+    return isIdentifierStartChar(c) || isDigit(c);
+}
+
+/**
+ * @brief Checks whether a name is one of the built-in functions `lookupFunction` knows (e.g. "sqrt", "max").
+ */
+constexpr bool isFunctionName(const char* text, std::size_t start, std::size_t length) {
+    constexpr const char* Names[] = { "sqrt", "abs", "exp", "log", "sin", "cos", "tan", "min", "max", "pow" };
+    for (const char* name : Names) {
+        std::size_t i = 0;
+        while (i < length && name[i] != '\0' && name[i] == text[start + i]) i++;
+        if (i == length && name[i] == '\0') return true;
+    }
+    return false;
+}
+
+constexpr bool operatorCode(char c, OpCode& op) {
+    switch (c) {
+    case '+': op = OpCode::Add; return true;
+    case '-': op = OpCode::Sub; return true;
+    case '*': op = OpCode::Mul; return true;
+    case '/': op = OpCode::Div; return true;
+    case '^': op = OpCode::Pow; return true;
+    default: return false;
+    }
+}
+
+template <std::size_t N>
+constexpr StaticProgram<N> compileRpn(const FixedString<N>& expression) {
+    StaticBuilder<N> builder(expression.text);
+    const char* text = expression.text;
+    const std::size_t end = expression.size();
+
+    std::size_t pos = 0;
+    while (true) {
+        while (pos < end && text[pos] == ' ') pos++;
+        if (pos == end) break;
+        std::size_t start = pos;
+        while (pos < end && text[pos] != ' ') pos++;
+
+        OpCode op = OpCode::Add;
+        if (pos - start == 1 && operatorCode(text[start], op)) {
+            builder.applyOperator(op);
+        } else if (isIdentifierStartChar(text[start])) {
+            for (std::size_t i = start; i < pos; ++i) {
+                if (!isIdentifierContinuation(text[i])) constexprExpressionError("invalid token");
+            }
+            if (isFunctionName(text, start, pos - start)) constexprExpressionError("function calls are not supported at compile time");
+            builder.pushVariable(start, pos - start);
+        } else {
+            builder.pushConstant(parseLiteral(text, start, pos));
+        }
+    }
+    return builder.finish();
+}
+
+/**
+ * @brief Precedence-climbing parser for the infix grammar: numbers, variables, + - * / ^, parentheses
+ *        and unary minus, with the same precedence and associativity as `InfixCalculator`.
+ */
+template <std::size_t N>
+struct InfixParser {
+    const char* text;
+    std::size_t pos;
+    std::size_t end;
+    StaticBuilder<N>& builder;
+
+    static constexpr int precedence(char op) {
+        if (op == '^') return 3;
+        if (op == '*' || op == '/') return 2;
+        if (op == '+' || op == '-') return 1;
+        return 0;
+    }
+
+    constexpr void skipSpaces() {
+        while (pos < end && text[pos] == ' ') pos++;
+    }
+
+    constexpr void parseExpression(int minPrecedence) {
+        parseOperand();
+        while (true) {
+            skipSpaces();
+            if (pos == end) return;
+            char op = text[pos];
+            int opPrecedence = precedence(op);
+            if (opPrecedence == 0 || opPrecedence < minPrecedence) return;
+            pos++;
+            parseExpression(op == '^' ? opPrecedence : opPrecedence + 1);
+            OpCode code = OpCode::Add;
+            operatorCode(op, code);
+            builder.applyOperator(code);
+        }
+    }
+
+    constexpr void parseOperand() {
+        skipSpaces();
+        if (pos == end) constexprExpressionError("missing operand");
+        const char c = text[pos];
+
+        if (isDigit(c) || c == '.') {
+            std::size_t start = pos;
+            while (pos < end && (isDigit(text[pos]) || text[pos] == '.')) pos++;
+            if (pos < end && (text[pos] == 'e' || text[pos] == 'E')) {
+                pos++;
+                if (pos < end && (text[pos] == '+' || text[pos] == '-')) pos++;
+                while (pos < end && isDigit(text[pos])) pos++;
+            }
+            builder.pushConstant(parseLiteral(text, start, pos));
+            return;
+        }
+        if (isIdentifierStartChar(c)) {
+            std::size_t start = pos;
+            while (pos < end && isIdentifierContinuation(text[pos])) pos++;
+            std::size_t length = pos - start;
+            skipSpaces();
+            if (pos < end && text[pos] == '(') constexprExpressionError("function calls are not supported at compile time");
+            builder.pushVariable(start, length);
+            return;
+        }
+        if (c == '(') {
+            pos++;
+            parseExpression(0);
+            skipSpaces();
+            if (pos == end || text[pos] != ')') constexprExpressionError("mismatched parentheses");
+            pos++;
+            return;
+        }
+        if (c == '-' || c == '+') {
+            pos++;
+            parseExpression(precedence('^'));
+            if (c == '-') builder.applyNegate();
+            return;
+        }
+        constexprExpressionError("invalid character");
+    }
+};
+
+template <std::size_t N>
+constexpr StaticProgram<N> compileInfix(const FixedString<N>& expression) {
+    StaticBuilder<N> builder(expression.text);
+    InfixParser<N> parser{ expression.text, 0, expression.size(), builder };
+    parser.parseExpression(0);
+    parser.skipSpaces();
+    if (parser.pos != parser.end) {
+        char c = expression.text[parser.pos];
+        constexprExpressionError(isDigit(c) || c == '.' || c == '(' || isIdentifierStartChar(c)
+                                 ? "too many operands" : "invalid character");
+    }
+    return builder.finish();
+}
+
+/**
+ * @brief Checks that a * b is exactly representable (Dekker's two-product error term is zero).
+ * @note Conservative near the ends of the exponent range, where the splitting itself could round.
+ */
+constexpr bool productIsExact(double a, double b) {
+    if (a == 0 || b == 0) return true;
+    const double limit = 1e150;
+    const double magnitudeA = a < 0 ? -a : a;
+    const double magnitudeB = b < 0 ? -b : b;
+    if (magnitudeA > limit || magnitudeB > limit || magnitudeA < 1 / limit || magnitudeB < 1 / limit) return false;
+
+    const double splitter = 134217729.0; // 2^27 + 1
+    double product = a * b;
+    double scaledA = splitter * a;
+    double highA = scaledA - (scaledA - a);
+    double lowA = a - highA;
+    double scaledB = splitter * b;
+    double highB = scaledB - (scaledB - b);
+    double lowB = b - highB;
+    double error = ((highA * highB - product) + highA * lowB + lowA * highB) + lowA * lowB;
+    return error == 0;
+}
+
+/**
+ * @brief Folds x ^ n when the result is exact, so it matches what std::pow returns at runtime.
+ */
+constexpr double exactPower(double base, double exponent) {
+    if (exponent != static_cast<double>(static_cast<long long>(exponent)) || exponent > 1024 || exponent < -1024) {
+        constexprExpressionError("'^' can only be folded at compile time for integer exponents with an exact result");
+    }
+    long long n = static_cast<long long>(exponent);
+    bool reciprocal = n < 0;
+    if (reciprocal) n = -n;
+
+    double result = 1.0;
+    for (long long i = 0; i < n; ++i) {
+        if (!productIsExact(result, base)) {
+            constexprExpressionError("'^' can only be folded at compile time for integer exponents with an exact result");
+        }
+        result *= base;
+    }
+    if (reciprocal) {
+        if (result == 0) constexprExpressionError("division by zero");
+        double inverse = 1.0 / result;
+        if (!productIsExact(inverse, result) || inverse * result != 1.0) {
+            constexprExpressionError("'^' can only be folded at compile time for integer exponents with an exact result");
+        }
+        result = inverse;
+    }
+    return result;
+}
+
+/**
+ * @brief Runs a variable-free StaticProgram during compilation.
+ */
+template <std::size_t N>
+constexpr double foldProgram(const StaticProgram<N>& program) {
+    if (program.variableCount != 0) constexprExpressionError("expression has variables; use a callable instead of a value");
+
+    double stack[N] = {};
+    std::size_t top = 0;
+    for (std::size_t i = 0; i < program.codeSize; ++i) {
+        const Instruction& ins = program.code[i];
+        if (ins.op == OpCode::PushConst) {
+            stack[top++] = program.constants[ins.operand];
+            continue;
+        }
+        if (ins.op == OpCode::Neg) {
+            stack[top - 1] = -stack[top - 1];
+            continue;
+        }
+        double b = stack[--top];
+        double& a = stack[top - 1];
+        switch (ins.op) {
+        case OpCode::Add: a += b; break;
+        case OpCode::Sub: a -= b; break;
+        case OpCode::Mul: a *= b; break;
+        case OpCode::Div:
+            if (b == 0) constexprExpressionError("division by zero");
+            a /= b;
+            break;
+        default: a = exactPower(a, b); break;
+        }
+    }
+    return stack[0];
+}
+
+/**
+ * @brief Index of the first instruction of the subtree whose value instruction `last` produces.
+ */
+template <std::size_t N>
+constexpr std::size_t subtreeStart(const StaticProgram<N>& program, std::size_t last) {
+    int needed = 1;
+    std::size_t i = last + 1;
+    while (needed > 0) {
+        --i;
+        OpCode op = program.code[i].op;
+        int consumed = op == OpCode::PushConst || op == OpCode::PushVar ? 0 : op == OpCode::Neg ? 1 : 2;
+        needed += consumed - 1;
+    }
+    return i;
+}
+
+/**
+ * @brief Expression-tree node generated from instruction `I` of `P`; evaluation inlines to plain arithmetic.
+ * @tparam Checked When true, division by zero sets error code 3 as `RPNCalculator::run` does.
+ */
+template <auto P, std::size_t I, OpCode Op = P.code[I].op>
+struct Node {
+    using Right = Node<P, I - 1>;
+    using Left = Node<P, subtreeStart(P, I - 1) - 1>;
+
+    template <bool Checked>
+    static constexpr double eval(const double* variables, int& errorCode) {
+        double a = Left::template eval<Checked>(variables, errorCode);
+        double b = Right::template eval<Checked>(variables, errorCode);
+        if constexpr (Op == OpCode::Add) return a + b;
+        else if constexpr (Op == OpCode::Sub) return a - b;
+        else if constexpr (Op == OpCode::Mul) return a * b;
+        else if constexpr (Op == OpCode::Div) {
+            if constexpr (Checked) {
+                if (b == 0) errorCode = 3; // Division by zero
+            }
+            return a / b;
+        } else return std::pow(a, b);
+    }
+};
+
+template <auto P, std::size_t I>
+struct Node<P, I, OpCode::PushConst> {
+    template <bool Checked>
+    static constexpr double eval(const double*, int&) { return P.constants[P.code[I].operand]; }
+};
+
+template <auto P, std::size_t I>
+struct Node<P, I, OpCode::PushVar> {
+    template <bool Checked>
+    static constexpr double eval(const double* variables, int&) { return variables[P.code[I].operand]; }
+};
+
+template <auto P, std::size_t I>
+struct Node<P, I, OpCode::Neg> {
+    template <bool Checked>
+    static constexpr double eval(const double* variables, int& errorCode) {
+        return -Node<P, I - 1>::template eval<Checked>(variables, errorCode);
+    }
+};
+
+template <FixedString Expression, Notation Kind>
+inline constexpr auto staticProgram = Kind == Notation::RPN ? compileRpn(Expression) : compileInfix(Expression);
+
+template <std::size_t Index>
+struct AlwaysDouble {
+    using Type = double;
+};
+
+} // namespace constexpr_detail
+
+/**
+ * @brief A compiled-in expression with one `double` parameter per variable, in first-appearance order.
+ * @note The expression is parsed during compilation and turned into a tree of templates, so calling
+ *       it costs exactly the arithmetic it contains.
+ */
+template <FixedString Expression, Notation Kind>
+struct StaticExpression {
+    static constexpr const auto& program = constexpr_detail::staticProgram<Expression, Kind>;
+    static constexpr std::size_t variableCount = program.variableCount; ///< Number of parameters.
+
+    /**
+     * @brief Evaluates with IEEE semantics (division by zero gives an infinity or NaN), like hand-written code.
+     */
+    template <typename... Values>
+        requires(sizeof...(Values) == variableCount)
+    constexpr double operator()(Values... values) const {
+        const double variables[sizeof...(Values) + 1] = { static_cast<double>(values)..., 0.0 };
+        int errorCode = 0;
+        return Tree::template eval<false>(variables, errorCode);
+    }
+
+    /**
+     * @brief Evaluates with the calculator's error reporting: 3 on division by zero, with a result of 0.
+     */
+    template <typename... Values>
+        requires(sizeof...(Values) == variableCount)
+    constexpr double run(int& errorCode, Values... values) const {
+        const double variables[sizeof...(Values) + 1] = { static_cast<double>(values)..., 0.0 };
+        errorCode = 0;
+        double result = Tree::template eval<true>(variables, errorCode);
+        return errorCode == 0 ? result : 0.0;
+    }
+
+private:
+    using Tree = constexpr_detail::Node<constexpr_detail::staticProgram<Expression, Kind>, program.codeSize - 1>;
+};
+
+/**
+ * @brief The value of a variable-free RPN expression, computed during compilation.
+ * @note Malformed input, division by zero and inexact '^' are compile errors.
+ */
+template <FixedString Expression>
+inline constexpr double rpnValue = constexpr_detail::foldProgram(constexpr_detail::staticProgram<Expression, Notation::RPN>);
+
+/**
+ * @brief The value of a variable-free infix expression, computed during compilation.
+ */
+template <FixedString Expression>
+inline constexpr double infixValue = constexpr_detail::foldProgram(constexpr_detail::staticProgram<Expression, Notation::Infix>);
+
+/**
+ * @brief A callable for an RPN expression with variables, e.g. rpnExpression<"x y * 2 +">(3, 4).
+ */
+template <FixedString Expression>
+inline constexpr StaticExpression<Expression, Notation::RPN> rpnExpression{};
+
+/**
+ * @brief A callable for an infix expression with variables, e.g. infixExpression<"x * y + 2">(3, 4).
+ */
+template <FixedString Expression>
+inline constexpr StaticExpression<Expression, Notation::Infix> infixExpression{};
+
+#endif // CONSTEXPRCALCULATOR_H
@@ -0,0 +1,339 @@
+//##################################################
+// File: CsvEvaluator.cpp
+// Description: Block-wise CSV scanning with in-place fields, and batched column evaluation of the formulas.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "CsvEvaluator.h"
+#include "BufferedWriter.h"
+#include "ColumnEvaluator.h"
+#include "InfixCalculator.h"
+#include "NumberParser.h"
+#include "ProgramOptimizer.h"
+#include "RPNCalculator.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+namespace {
+
+/**
+ * @brief Walks the fields of the row that starts at `begin`.
+ * @param begin Start of the row.
+ * @param end End of the buffered input.
+ * @param atEnd True if no input follows `end`, so a row without a newline is complete.
+ * @param delimiter The field separator.
+ * @param onField Called with (field index, first byte, one past the last byte) for every field; quoted
+ *        fields include their quotes and may span lines.
+ * @return One past the row's newline (or `end` for a last row without one), or nullptr if the row
+ *         continues past `end`. Fields seen before nullptr is returned are reported again on the next scan.
+ */
+template <typename Fn>
+const char* scanRow(const char* begin, const char* end, bool atEnd, char delimiter, Fn&& onField) {
+    const char* p = begin;
+    for (std::size_t index = 0;; ++index) {
+        const char* fieldStart = p;
+        if (p < end && *p == '"') {
+            for (p++;;) {
+                const char* quote = static_cast<const char*>(std::memchr(p, '"', static_cast<std::size_t>(end - p)));
+                if (quote == nullptr) {
+                    if (!atEnd) return nullptr;
+                    p = end; // Unterminated quote: the field runs to the end of the input
+                    break;
+                }
+                if (quote + 1 == end && !atEnd) return nullptr; // Could be the first half of ""
+                p = quote + 1;
+                if (p == end || *p != '"') break;
+                p++; // An escaped quote
+            }
+        }
+        while (p < end && *p != delimiter && *p != '\n') p++;
+        if (p == end && !atEnd) return nullptr;
+
+        onField(index, fieldStart, p);
+        if (p == end) return end;
+        if (*p++ == '\n') return p;
+    }
+}
+
+/**
+ * @brief Strips surrounding blanks, a carriage return and one pair of quotes from a field.
+ */
+std::string_view fieldText(const char* begin, const char* end) {
+    while (begin < end && (*begin == ' ' || *begin == '\t')) begin++;
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) end--;
+    if (end - begin >= 2 && *begin == '"' && end[-1] == '"') {
+        begin++;
+        end--;
+    }
+    return std::string_view(begin, static_cast<std::size_t>(end - begin));
+}
+
+/**
+ * @brief Converts a numeric field, with a fast path for the plain decimals most exports contain.
+ * @note A field such as "-1234.56" with at most 15 digits is m / 10^k with both exact, so one
+ *       division gives the correctly rounded value, the same as `parseDouble`. Anything else
+ *       (blanks, quotes, exponents, long fields) goes through `parseDouble`.
+ */
+bool parseField(const char* begin, const char* end, double& value) {
+    static constexpr double Powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+    const char* p = begin + (begin < end && *begin == '-' ? 1 : 0);
+    const char* digitsStart = p;
+    std::uint64_t mantissa = 0;
+    while (p < end && static_cast<unsigned>(*p - '0') < 10) mantissa = mantissa * 10 + static_cast<unsigned>(*p++ - '0');
+    const char* integerEnd = p;
+    if (p < end && *p == '.' && p > digitsStart) {
+        p++;
+        while (p < end && static_cast<unsigned>(*p - '0') < 10) mantissa = mantissa * 10 + static_cast<unsigned>(*p++ - '0');
+    }
+    const std::ptrdiff_t fraction = p > integerEnd ? p - integerEnd - 1 : 0;
+    const std::ptrdiff_t digits = (integerEnd - digitsStart) + fraction;
+    if (p != end || digits == 0 || digits > 15 || (p > integerEnd && fraction == 0)) {
+        return parseDouble(fieldText(begin, end), value);
+    }
+    double result = static_cast<double>(mantissa) / Powers[fraction];
+    value = begin < end && *begin == '-' ? -result : result;
+    return true;
+}
+
+/**
+ * @brief Writes a header name, quoted if it contains the delimiter, a quote or a line break.
+ */
+void writeName(BufferedWriter& writer, const std::string& name, char delimiter) {
+    if (name.find_first_of(std::string{ delimiter, '"', '\n', '\r' }) == std::string::npos) {
+        writer.write(name.data(), name.size());
+        return;
+    }
+    writer.put('"');
+    for (char c : name) {
+        if (c == '"') writer.put('"');
+        writer.put(c);
+    }
+    writer.put('"');
+}
+
+/**
+ * @brief A formula compiled once, with each variable slot mapped to an input column.
+ */
+struct CompiledFormula {
+    Program program;
+    std::vector<int> inputs;       ///< Index into the batch's column arrays, per variable slot.
+    int setupError = 0;            ///< 1 if a variable names no column.
+    std::vector<double> results;   ///< One per batch row.
+    std::vector<unsigned char> errors;
+};
+
+} // namespace
+
+/**
+ * @brief Copies a CSV stream to `out` with one extra column per formula.
+ * @param in The input; the first row is the header and names the columns.
+ * @param out Receives every input row unchanged, followed by the formulas' results.
+ * @param options Formulas, notation, delimiter and block sizes.
+ * @param stats Optional totals.
+ * @return False if reading or writing failed, or the input has no header row.
+ * @note The input is read into one block that is refilled in place. Rows are never copied: fields are
+ *       sliced where they lie, and only the columns that some formula uses are converted, into one
+ *       array per column for up to `batchRows` rows. Each formula then runs over the whole batch
+ *       with `evaluateColumns`. The batch is written before the block is refilled, so memory depends
+ *       on the block size, the batch size and the longest row, never on the file size. Blank lines
+ *       are not records and are dropped.
+ */
+bool evaluateCsv(std::FILE* in, std::FILE* out, const CsvOptions& options, CsvStats* stats) {
+    const auto started = std::chrono::steady_clock::now();
+    CsvStats totals;
+    const char delimiter = options.delimiter;
+    const std::size_t batchRows = options.batchRows > 0 ? options.batchRows : 1;
+    std::vector<char> buffer(options.blockBytes < 64 ? 64 : options.blockBytes);
+    std::size_t used = 0;
+    bool atEnd = false;
+    bool readError = false;
+    auto fill = [&] {
+        std::size_t want = buffer.size() - used;
+        std::size_t got = std::fread(buffer.data() + used, 1, want, in);
+        used += got;
+        totals.inputBytes += got;
+        if (got < want) {
+            atEnd = true;
+            readError = std::ferror(in) != 0;
+        }
+    };
+
+    // The header row, which may need more than one block
+    std::vector<std::string> names;
+    const char* headerEnd = nullptr;
+    while (headerEnd == nullptr) {
+        fill();
+        names.clear();
+        headerEnd = scanRow(buffer.data(), buffer.data() + used, atEnd, delimiter,
+                            [&](std::size_t, const char* begin, const char* end) {
+                                std::string_view text = fieldText(begin, end);
+                                std::string& name = names.emplace_back();
+                                for (std::size_t i = 0; i < text.size(); ++i) {
+                                    if (text[i] == '"' && i + 1 < text.size() && text[i + 1] == '"') i++;
+                                    name += text[i];
+                                }
+                            });
+        if (headerEnd == nullptr && used == buffer.size()) buffer.resize(buffer.size() * 2);
+    }
+    if (used == 0 || readError) {
+        if (stats) *stats = totals;
+        return false;
+    }
+
+    // Compile every formula and give each variable the column of the same name
+    std::vector<CompiledFormula> formulas(options.formulas.size());
+    std::vector<int> inputOfColumn(names.size(), -1);
+    std::vector<std::size_t> columnOfInput;
+    InfixCalculator infix;
+    for (std::size_t f = 0; f < formulas.size(); ++f) {
+        CompiledFormula& formula = formulas[f];
+        if (options.notation == Notation::Infix) infix.compileInfix(std::string_view(options.formulas[f].expression), formula.program);
+        else RPNCalculator::compile(std::string_view(options.formulas[f].expression), formula.program);
+        optimizeProgram(formula.program);
+        for (const std::string& variable : formula.program.variables) {
+            std::size_t column = 0;
+            while (column < names.size() && names[column] != variable) column++;
+            if (column == names.size()) {
+                formula.setupError = 1; // Unbound variable
+                totals.unboundVariables.push_back(variable);
+                formula.inputs.push_back(-1);
+                continue;
+            }
+            if (inputOfColumn[column] < 0) {
+                inputOfColumn[column] = static_cast<int>(columnOfInput.size());
+                columnOfInput.push_back(column);
+            }
+            formula.inputs.push_back(inputOfColumn[column]);
+        }
+        formula.results.resize(batchRows);
+        formula.errors.resize(batchRows);
+    }
+
+    std::vector<std::vector<const double*>> bindings(formulas.size());
+    std::vector<std::vector<double>> columns(columnOfInput.size(), std::vector<double>(batchRows));
+    for (std::size_t f = 0; f < formulas.size(); ++f) {
+        for (int input : formulas[f].inputs) bindings[f].push_back(input >= 0 ? columns[input].data() : nullptr);
+    }
+
+    // The header keeps its bytes and line ending and gains the formulas' names
+    BufferedWriter writer(out);
+    auto writeRow = [&](std::string_view row, auto&& appendFields) {
+        bool crlf = !row.empty() && row.back() == '\r';
+        if (crlf) row.remove_suffix(1);
+        writer.write(row.data(), row.size());
+        appendFields();
+        if (crlf) writer.put('\r');
+        writer.put('\n');
+    };
+    std::string_view header(buffer.data(), static_cast<std::size_t>(headerEnd - buffer.data()));
+    if (!header.empty() && header.back() == '\n') header.remove_suffix(1);
+    writeRow(header, [&] {
+        for (const CsvFormula& formula : options.formulas) {
+            writer.put(delimiter);
+            writeName(writer, formula.name, delimiter);
+        }
+    });
+
+    // Evaluates the batch column by column, then writes it row by row
+    std::vector<std::string_view> rows(batchRows);
+    std::size_t batched = 0;
+    const SimdLevel level = detectSimdLevel();
+    auto flushBatch = [&] {
+        if (batched == 0) return;
+        for (std::size_t f = 0; f < formulas.size(); ++f) {
+            CompiledFormula& formula = formulas[f];
+            int errorCode = formula.setupError;
+            if (errorCode == 0) {
+                errorCode = evaluateColumns(formula.program, bindings[f].data(), batched, formula.results.data(), formula.errors.data(), level);
+            }
+            if (errorCode != 0) {
+                std::memset(formula.errors.data(), errorCode, batched);
+                continue;
+            }
+            for (int input : formula.inputs) {
+                const double* values = columns[input].data();
+                for (std::size_t r = 0; r < batched; ++r) {
+                    if (std::isnan(values[r])) formula.errors[r] = 1; // Missing or non-numeric field
+                }
+            }
+        }
+        for (std::size_t r = 0; r < batched; ++r) {
+            writeRow(rows[r], [&] {
+                for (const CompiledFormula& formula : formulas) {
+                    writer.put(delimiter);
+                    if (formula.errors[r] != 0) {
+                        writer.write("error ", 6);
+                        writer.writeInt(formula.errors[r]);
+                        totals.errors++;
+                    } else if (options.precision >= 0) {
+                        writer.writeFixed(formula.results[r], options.precision);
+                    } else {
+                        writer.writeDouble(formula.results[r]);
+                    }
+                }
+            });
+        }
+        totals.rows += batched;
+        batched = 0;
+    };
+
+    const double missing = std::numeric_limits<double>::quiet_NaN();
+    std::size_t pos = static_cast<std::size_t>(headerEnd - buffer.data());
+    for (;;) {
+        const char* data = buffer.data();
+        while (pos < used) {
+            for (std::vector<double>& column : columns) column[batched] = missing;
+            const char* rowEnd = scanRow(data + pos, data + used, atEnd, delimiter,
+                                         [&](std::size_t index, const char* begin, const char* end) {
+                                             if (index >= inputOfColumn.size() || inputOfColumn[index] < 0) return;
+                                             double value;
+                                             if (parseField(begin, end, value)) columns[inputOfColumn[index]][batched] = value;
+                                         });
+            if (rowEnd == nullptr) break;
+
+            std::string_view row(data + pos, static_cast<std::size_t>(rowEnd - (data + pos)));
+            pos = static_cast<std::size_t>(rowEnd - data);
+            if (!row.empty() && row.back() == '\n') row.remove_suffix(1);
+            if (row.empty() || row == "\r") continue;
+            rows[batched++] = row;
+            if (batched == batchRows) flushBatch();
+        }
+
+        // Rows point into the block, so they are written before it is refilled
+        flushBatch();
+        if (atEnd || writer.failed()) break;
+        std::memmove(buffer.data(), buffer.data() + pos, used - pos);
+        used -= pos;
+        pos = 0;
+        if (used == buffer.size()) buffer.resize(buffer.size() * 2); // A row longer than the block
+        fill();
+    }
+
+    bool written = writer.flush();
+    totals.bufferBytes = buffer.size();
+    totals.elapsedNs = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count());
+    if (stats) *stats = totals;
+    return written && !readError;
+}
+
+/**
+ * @brief Writes a human-readable summary of a CSV run.
+ * @param stats Totals from `evaluateCsv`.
+ * @param out The stream to write to.
+ */
+void printCsvStats(const CsvStats& stats, std::FILE* out) {
+    double seconds = static_cast<double>(stats.elapsedNs) / 1e9;
+    std::fprintf(out, "rows              %zu (%zu error fields)\n", stats.rows, stats.errors);
+    std::fprintf(out, "elapsed           %.3f s, %.0f rows/s, %.1f MB/s\n", seconds,
+                 seconds > 0 ? static_cast<double>(stats.rows) / seconds : 0.0,
+                 seconds > 0 ? static_cast<double>(stats.inputBytes) / seconds / 1e6 : 0.0);
+    std::fprintf(out, "input buffer      %zu bytes\n", stats.bufferBytes);
+}
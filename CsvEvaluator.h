@@ -0,0 +1,67 @@
+//##################################################
+// File: CsvEvaluator.h
+// Description: Streams a CSV file and appends columns computed by formulas over its header-named fields.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef CSVEVALUATOR_H
+#define CSVEVALUATOR_H
+
+#include "Program.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A computed column: its header name and the formula that fills it.
+ */
+struct CsvFormula {
+    std::string name;        ///< Header of the appended column.
+    std::string expression;  ///< Formula whose variables are input column names, e.g. "price * qty".
+};
+
+/**
+ * @brief Settings for `evaluateCsv`.
+ */
+struct CsvOptions {
+    Notation notation = Notation::Infix;
+    std::vector<CsvFormula> formulas;  ///< Columns to append, in order.
+    char delimiter = ',';
+    std::size_t blockBytes = 1 << 20;  ///< Input read at a time; grows only for a row longer than this.
+    std::size_t batchRows = 1024;      ///< Rows evaluated together by the column kernels.
+    int precision = -1;                ///< Digits after the point in results; -1 writes the shortest exact text.
+};
+
+/**
+ * @brief Totals gathered by `evaluateCsv`.
+ */
+struct CsvStats {
+    std::size_t rows = 0;                         ///< Data rows, not counting the header.
+    std::size_t errors = 0;                       ///< Computed fields written as "error N".
+    std::size_t inputBytes = 0;                   ///< Bytes read.
+    std::size_t bufferBytes = 0;                  ///< Final size of the input buffer.
+    std::uint64_t elapsedNs = 0;                  ///< Wall time of the whole run.
+    std::vector<std::string> unboundVariables;    ///< Formula variables with no column of that name.
+};
+
+/**
+ * @brief Copies a CSV stream to `out` with one extra column per formula.
+ * @param in The input; the first row is the header and names the columns.
+ * @param out Receives every input row unchanged, followed by the formulas' results.
+ * @param options Formulas, notation, delimiter and block sizes.
+ * @param stats Optional totals.
+ * @return False if reading or writing failed, or the input has no header row.
+ * @note A field that is not a number (after trimming spaces), or is missing, makes every formula
+ *       that uses it write "error 1" for that row. A formula that does not compile, or that uses
+ *       a name with no column, writes "error N" on every row.
+ */
+bool evaluateCsv(std::FILE* in, std::FILE* out, const CsvOptions& options, CsvStats* stats = nullptr);
+
+void printCsvStats(const CsvStats& stats, std::FILE* out); ///< Writes a human-readable summary of `stats`.
+
+#endif // CSVEVALUATOR_H
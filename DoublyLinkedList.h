@@ -9,6 +9,11 @@
 #ifndef DOUBLYLINKEDLIST_H
 #define DOUBLYLINKEDLIST_H
 
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
 template <typename T>
 struct Node {
     T data;
@@ -23,16 +28,110 @@ struct Node {
     Node(T data) : data(data), next(nullptr), prev(nullptr) {}
 };
 
-template <typename T>
+/**
+ * @brief Hands out fixed-size node slots carved from slabs, recycling freed slots through a free list.
+ * @note Slabs double in size up to `MaxSlabNodes` and are only returned to the allocator on
+ *       destruction, so a list that shrinks keeps its memory for the next growth.
+ */
+template <typename NodeType, typename Allocator>
+class NodePool {
+public:
+    NodePool() = default;
+    explicit NodePool(const Allocator& allocator) : slotAllocator(allocator), slabs(allocator) {}
+    ~NodePool();                    ///< Returns every slab to the allocator; live nodes must already be destroyed.
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    void* acquire();                ///< Returns uninitialized storage for one node.
+    void release(void* slot);       ///< Takes back the storage of a destroyed node.
+
+    static constexpr std::size_t FirstSlabNodes = 16;
+    static constexpr std::size_t MaxSlabNodes = 4096;
+
+private:
+    struct alignas(NodeType) Slot {
+        unsigned char bytes[sizeof(NodeType)];
+    };
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+    struct Slab {
+        Slot* slots;
+        std::size_t count;
+    };
+    static_assert(sizeof(Slot) >= sizeof(FreeSlot), "a node slot must be able to hold the free-list link");
+
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+    using SlabAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slab>;
+
+    SlotAllocator slotAllocator;
+    std::vector<Slab, SlabAllocator> slabs;
+    FreeSlot* freeList = nullptr;   ///< Slots released by `release`, most recent first.
+    Slot* bump = nullptr;           ///< Next never-used slot of the newest slab.
+    Slot* bumpEnd = nullptr;
+
+    void addSlab();
+};
+
+template <typename NodeType, typename Allocator>
+NodePool<NodeType, Allocator>::~NodePool() {
+    for (const Slab& slab : slabs) {
+        std::allocator_traits<SlotAllocator>::deallocate(slotAllocator, slab.slots, slab.count);
+    }
+}
+
+/**
+ * @brief Returns storage for one node: a recycled slot if any, else the next slot of the newest slab.
+ * @return Storage suitably sized and aligned for `NodeType`.
+ * @note O(1); allocates only when every slab is full.
+ */
+template <typename NodeType, typename Allocator>
+void* NodePool<NodeType, Allocator>::acquire() {
+    if (freeList) {
+        FreeSlot* slot = freeList;
+        freeList = slot->next;
+        slot->~FreeSlot();
+        return slot;
+    }
+    if (bump == bumpEnd) addSlab();
+    return bump++;
+}
+
+template <typename NodeType, typename Allocator>
+void NodePool<NodeType, Allocator>::release(void* slot) {
+    freeList = new (slot) FreeSlot{ freeList };
+}
+
+template <typename NodeType, typename Allocator>
+void NodePool<NodeType, Allocator>::addSlab() {
+    std::size_t count = slabs.empty() ? FirstSlabNodes : slabs.back().count * 2;
+    if (count > MaxSlabNodes) count = MaxSlabNodes;
+    Slot* slots = std::allocator_traits<SlotAllocator>::allocate(slotAllocator, count);
+    slabs.push_back(Slab{ slots, count });
+    bump = slots;
+    bumpEnd = slots + count;
+}
+
+template <typename T, typename Allocator = std::allocator<T>>
 class DoublyLinkedList {
 public:
     DoublyLinkedList();    ///< Constructor initializes an empty list.
+    explicit DoublyLinkedList(const Allocator& allocator); ///< Empty list whose slabs come from `allocator`.
     ~DoublyLinkedList();   ///< Destructor clears all nodes from the list.
 
+    DoublyLinkedList(const DoublyLinkedList&) = delete;
+    DoublyLinkedList& operator=(const DoublyLinkedList&) = delete;
+
     void addToFront(const T& data);   ///< Adds a node with data to the front.
     void addToEnd(const T& data);     ///< Adds a node with data to the end.
     void insert(const T& search, const T& data); ///< Inserts a node after the specified value.
+    Node<T>* insertAfter(Node<T>* position, const T& data); ///< Inserts after a node in O(1) and returns the new node.
     void deleteNode(const T& search); ///< Deletes a node with the specified value.
+    void erase(Node<T>* node);        ///< Removes a node of this list in O(1).
+    bool popFront();                  ///< Removes the first node in O(1).
+    bool popBack();                   ///< Removes the last node in O(1).
+    void clear();                     ///< Removes every node, keeping the pooled storage.
     bool find(const T& search) const; ///< Checks if a node with the specified value exists.
 
     void traverseForward() const; ///< Traverses and prints the list from head to tail.
@@ -40,25 +139,62 @@ public:
 
     Node<T>* getHead() const { return head; }  ///< Returns the head node.
     Node<T>* getTail() const { return tail; }  ///< Returns the tail node.
+    bool isEmpty() const { return head == nullptr; } ///< Checks if the list is empty.
+    std::size_t size() const { return count; }       ///< Returns the number of nodes.
 
 private:
     Node<T>* head;
     Node<T>* tail;
+    std::size_t count;
+    NodePool<Node<T>, Allocator> pool; ///< Storage for every node of this list.
+
+    Node<T>* createNode(const T& data);
+    void destroyNode(Node<T>* node);
+    void unlink(Node<T>* node);
 };
 
 // Function definitions follow the lecture unit 11, with modifications noted where applicable.
 
-template <typename T>
-DoublyLinkedList<T>::DoublyLinkedList() : head(nullptr), tail(nullptr) {}
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::DoublyLinkedList() : head(nullptr), tail(nullptr), count(0) {}
 
-template <typename T>
-DoublyLinkedList<T>::~DoublyLinkedList() {
-    Node<T>* current = head;
-    while (current) {
-        Node<T>* nextNode = current->next;
-        delete current;
-        current = nextNode;
-    }
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::DoublyLinkedList(const Allocator& allocator)
+    : head(nullptr), tail(nullptr), count(0), pool(allocator) {}
+
+template <typename T, typename Allocator>
+DoublyLinkedList<T, Allocator>::~DoublyLinkedList() {
+    clear();
+}
+
+/**
+ * @brief Constructs a node in a pooled slot instead of allocating it with `new`.
+ * @param data The data to store.
+ * @return The unlinked node.
+ */
+template <typename T, typename Allocator>
+Node<T>* DoublyLinkedList<T, Allocator>::createNode(const T& data) {
+    return new (pool.acquire()) Node<T>(data);
+}
+
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::destroyNode(Node<T>* node) {
+    node->~Node<T>();
+    pool.release(node);
+}
+
+/**
+ * @brief Detaches a node from its neighbours, adjusting head and tail.
+ * @param node A node of this list.
+ */
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::unlink(Node<T>* node) {
+    if (node->prev) node->prev->next = node->next;
+    else head = node->next;
+
+    if (node->next) node->next->prev = node->prev;
+    else tail = node->prev;
+    count--;
 }
 
 /**
@@ -66,13 +202,14 @@ DoublyLinkedList<T>::~DoublyLinkedList() {
  * @param data The data to add to the front.
  * @note This function follows the lecture material, adding a node to the front of the list without modifications.
  */
-template <typename T>
-void DoublyLinkedList<T>::addToFront(const T& data) {
-    Node<T>* newNode = new Node<T>(data);
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::addToFront(const T& data) {
+    Node<T>* newNode = createNode(data);
     newNode->next = head;
     if (head) head->prev = newNode;
     else tail = newNode;
     head = newNode;
+    count++;
 }
 
 /**
@@ -80,9 +217,9 @@ void DoublyLinkedList<T>::addToFront(const T& data) {
  * @param data The data to add to the end.
  * @note Follows the lecture material with a slight modification to update the tail pointer.
  */
-template <typename T>
-void DoublyLinkedList<T>::addToEnd(const T& data) {
-    Node<T>* newNode = new Node<T>(data);
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::addToEnd(const T& data) {
+    Node<T>* newNode = createNode(data);
     if (!tail) {
         head = tail = newNode;
     } else {
@@ -90,6 +227,7 @@ void DoublyLinkedList<T>::addToEnd(const T& data) {
         newNode->prev = tail;
         tail = newNode;
     }
+    count++;
 }
 
 /**
@@ -98,42 +236,93 @@ void DoublyLinkedList<T>::addToEnd(const T& data) {
  * @param data The data to insert.
  * @note Based on lecture material; modified to work with generic types.
  */
-template <typename T>
-void DoublyLinkedList<T>::insert(const T& search, const T& data) {
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::insert(const T& search, const T& data) {
     Node<T>* current = head;
     while (current && current->data != search) {
         current = current->next;
     }
-    if (current) {
-        Node<T>* newNode = new Node<T>(data);
-        newNode->next = current->next;
-        newNode->prev = current;
-        if (current->next) current->next->prev = newNode;
-        current->next = newNode;
-        if (current == tail) tail = newNode;
-    }
+    if (current) insertAfter(current, data);
+}
+
+/**
+ * @brief Inserts a node with specified data right after a given node.
+ * @param position A node of this list.
+ * @param data The data to insert.
+ * @return The new node, usable as a handle for `erase` and `insertAfter`.
+ */
+template <typename T, typename Allocator>
+Node<T>* DoublyLinkedList<T, Allocator>::insertAfter(Node<T>* position, const T& data) {
+    Node<T>* newNode = createNode(data);
+    newNode->next = position->next;
+    newNode->prev = position;
+    if (position->next) position->next->prev = newNode;
+    position->next = newNode;
+    if (position == tail) tail = newNode;
+    count++;
+    return newNode;
 }
 
 /**
  * @brief Deletes a node with the specified value.
  * @param search The value to delete.
  * @note This function is based on the lecture material and includes logic to handle head and tail adjustments.
+ *       Prefer `erase`, `popFront` or `popBack` when the node is already known.
  */
-template <typename T>
-void DoublyLinkedList<T>::deleteNode(const T& search) {
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::deleteNode(const T& search) {
     Node<T>* current = head;
     while (current && current->data != search) {
         current = current->next;
     }
-    if (!current) return;
+    if (current) erase(current);
+}
 
-    if (current->prev) current->prev->next = current->next;
-    else head = current->next;
+/**
+ * @brief Removes a node without searching for it.
+ * @param node A node of this list; it is invalid afterwards.
+ */
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::erase(Node<T>* node) {
+    unlink(node);
+    destroyNode(node);
+}
 
-    if (current->next) current->next->prev = current->prev;
-    else tail = current->prev;
+/**
+ * @brief Removes the first node.
+ * @return True if a node was removed, false if the list was empty.
+ */
+template <typename T, typename Allocator>
+bool DoublyLinkedList<T, Allocator>::popFront() {
+    if (!head) return false;
+    erase(head);
+    return true;
+}
 
-    delete current;
+/**
+ * @brief Removes the last node.
+ * @return True if a node was removed, false if the list was empty.
+ */
+template <typename T, typename Allocator>
+bool DoublyLinkedList<T, Allocator>::popBack() {
+    if (!tail) return false;
+    erase(tail);
+    return true;
+}
+
+/**
+ * @brief Removes every node; their slots stay in the pool for reuse.
+ */
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::clear() {
+    Node<T>* current = head;
+    while (current) {
+        Node<T>* nextNode = current->next;
+        destroyNode(current);
+        current = nextNode;
+    }
+    head = tail = nullptr;
+    count = 0;
 }
 
 /**
@@ -142,8 +331,8 @@ void DoublyLinkedList<T>::deleteNode(const T& search) {
  * @return True if the value is found, false otherwise.
  * @note This function follows the lecture material directly.
  */
-template <typename T>
-bool DoublyLinkedList<T>::find(const T& search) const {
+template <typename T, typename Allocator>
+bool DoublyLinkedList<T, Allocator>::find(const T& search) const {
     Node<T>* current = head;
     while (current) {
         if (current->data == search) return true;
@@ -156,8 +345,8 @@ bool DoublyLinkedList<T>::find(const T& search) const {
  * @brief Traverses and prints the list from head to tail.
  * @note Follows lecture material for traversal.
  */
-template <typename T>
-void DoublyLinkedList<T>::traverseForward() const {
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::traverseForward() const {
     Node<T>* current = head;
     while (current) {
         // Replace with a custom print function
@@ -169,8 +358,8 @@ void DoublyLinkedList<T>::traverseForward() const {
  * @brief Traverses and prints the list from tail to head.
  * @note Follows lecture material for reverse traversal.
  */
-template <typename T>
-void DoublyLinkedList<T>::traverseBackward() const {
+template <typename T, typename Allocator>
+void DoublyLinkedList<T, Allocator>::traverseBackward() const {
     Node<T>* current = tail;
     while (current) {
         // Replace with a custom print function
@@ -0,0 +1,73 @@
+//##################################################
+// File: EvaluationScratch.h
+// Description: Caller-owned operand stack and result type for the reentrant, allocation-free evaluation calls.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef EVALUATIONSCRATCH_H
+#define EVALUATIONSCRATCH_H
+
+#include <cstddef>
+
+/**
+ * @brief Outcome of a reentrant evaluation.
+ */
+struct EvaluationResult {
+    double value = 0.0; ///< The result, or 0 in case of error.
+    int errorCode = 0;  ///< 0, the calculator's usual 1-3, or 6 when the scratch stack is too small.
+
+    bool ok() const { return errorCode == 0; } ///< True if `value` is a result.
+};
+
+/**
+ * @brief A fixed-capacity operand stack over memory the caller owns.
+ * @note The const `evaluate`, `evaluateInfix` and `run` overloads keep their operands here instead of
+ *       in the calculator, so one calculator can serve any number of threads, each with its own
+ *       scratch. The stack never grows. An expression that needs more than `capacity()` operands
+ *       fails with error 6 (`StackExhausted`). Every call starts from an empty stack, so nothing a
+ *       failed call left behind reaches the next one.
+ */
+class EvaluationScratch {
+public:
+    static constexpr int StackExhausted = 6; ///< Error code for an expression deeper than the scratch.
+
+    EvaluationScratch(double* storage, std::size_t capacity) : items(storage), count(0), cap(capacity) {} ///< Uses `capacity` doubles at `storage`.
+
+    EvaluationScratch(const EvaluationScratch&) = delete;
+    EvaluationScratch& operator=(const EvaluationScratch&) = delete;
+
+    bool tryPush(double value) {                ///< Pushes unless the stack is full; returns false if it is.
+        if (count == cap) return false;
+        items[count++] = value;
+        return true;
+    }
+    void push(double value) { items[count++] = value; } ///< Pushes without a check (the caller knows the depth).
+    double& top() { return items[count - 1]; }  ///< Top value (stack must not be empty).
+    void pop_back() { --count; }                ///< Removes the top value (stack must not be empty).
+    void clear() { count = 0; }                 ///< Empties the stack.
+
+    bool isEmpty() const { return count == 0; }
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return cap; }
+
+private:
+    double* items;
+    std::size_t count;
+    std::size_t cap;
+};
+
+/**
+ * @brief Scratch with its storage inline, e.g. `FixedEvaluationScratch<64> scratch;` on the caller's stack.
+ */
+template <std::size_t Capacity>
+class FixedEvaluationScratch : public EvaluationScratch {
+public:
+    FixedEvaluationScratch() : EvaluationScratch(storage, Capacity) {}
+
+private:
+    double storage[Capacity];
+};
+
+#endif // EVALUATIONSCRATCH_H
@@ -0,0 +1,359 @@
+//##################################################
+// File: ExpressionCache.cpp
+// Description: Normalization, hashing, open-addressing index and CLOCK eviction for ExpressionCache.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "ExpressionCache.h"
+#include "Hash.h"
+
+#include <cstring>
+
+namespace {
+
+using hash_detail::HashMultiplier0;
+using hash_detail::load64;
+using hash_detail::mix;
+
+const std::uint64_t InfixSeed = 0x94D049BB133111EBULL;
+
+// Keys up to this length are normalized on the stack; longer ones use a temporary string
+const std::size_t InlineKeyLength = 256;
+
+// The index starts at this many slots per shard and doubles whenever it would become half full
+const std::size_t InitialIndexSize = 64;
+
+std::uint64_t keyHash(std::string_view key, Notation notation) {
+    std::uint64_t hash = hashText(key);
+    return notation == Notation::Infix ? mix(hash ^ InfixSeed, HashMultiplier0) : hash;
+}
+
+/**
+ * @brief Holds the normalized form of a key, on the stack when it is short.
+ */
+class NormalizedKey {
+public:
+    explicit NormalizedKey(std::string_view expression) {
+        if (isNormalized(expression)) {
+            view = expression; // Common case: nothing to rewrite, so nothing to copy
+            return;
+        }
+        char* out = inlineBuffer;
+        if (expression.size() > InlineKeyLength) {
+            heapBuffer.resize(expression.size());
+            out = &heapBuffer[0];
+        }
+        view = std::string_view(out, normalizeExpression(expression, out));
+    }
+
+    std::string_view text() const { return view; }
+
+private:
+    /**
+     * @brief Checks for leading, trailing or doubled spaces, eight bytes at a time.
+     * @note The zero-byte trick can flag a byte right after a real space, which only sends a
+     *       normalized key down the copying path; it never misses a doubled space.
+     */
+    static bool isNormalized(std::string_view text) {
+        if (text.empty()) return true;
+        if (text.front() == ' ' || text.back() == ' ') return false;
+
+        const char* p = text.data();
+        std::size_t remaining = text.size();
+        std::uint64_t previous = 0; // Flag of the last byte of the previous chunk, moved to byte 0
+        while (remaining >= 8) {
+            std::uint64_t x = load64(p) ^ 0x2020202020202020ULL;
+            std::uint64_t spaces = (x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL;
+            if (spaces & ((spaces << 8) | previous)) return false;
+            previous = spaces >> 56;
+            p += 8;
+            remaining -= 8;
+        }
+        bool lastWasSpace = previous != 0;
+        for (; remaining > 0; --remaining, ++p) {
+            if (*p == ' ' && lastWasSpace) return false;
+            lastWasSpace = *p == ' ';
+        }
+        return true;
+    }
+
+    char inlineBuffer[InlineKeyLength];
+    std::string heapBuffer;
+    std::string_view view;
+};
+
+std::size_t programBytes(const Program& program) {
+    std::size_t bytes = sizeof(Program) + program.code.capacity() * sizeof(Instruction) +
+                        program.constants.capacity() * sizeof(double);
+    for (const std::string& name : program.variables) bytes += sizeof(std::string) + name.capacity();
+    return bytes;
+}
+
+} // namespace
+
+/**
+ * @brief Removes leading and trailing spaces and collapses every run of spaces to one.
+ * @param expression The expression text.
+ * @param out Receives the normalized text; must hold `expression.size()` bytes.
+ * @return The length of the normalized text.
+ * @note Only ' ' separates tokens in either notation, so other characters are left as they are.
+ */
+std::size_t normalizeExpression(std::string_view expression, char* out) {
+    std::size_t length = 0;
+    bool pendingSpace = false;
+    for (char c : expression) {
+        if (c == ' ') {
+            pendingSpace = length > 0;
+            continue;
+        }
+        if (pendingSpace) {
+            out[length++] = ' ';
+            pendingSpace = false;
+        }
+        out[length++] = c;
+    }
+    return length;
+}
+
+/**
+ * @brief Creates an empty cache.
+ * @param capacityBytes Approximate memory the entries may use, split evenly between the shards.
+ * @param shardCount Number of independently locked shards; rounded up to a power of two.
+ */
+ExpressionCache::ExpressionCache(std::size_t capacityBytes, unsigned shardCount) {
+    unsigned count = 1;
+    while (count < shardCount) count <<= 1;
+    shards.reset(new Shard[count]);
+    shardMask = count - 1;
+    shardCapacity = capacityBytes / count;
+    for (unsigned i = 0; i < count; ++i) shards[i].index.assign(InitialIndexSize, IndexSlot{ 0, 0 });
+}
+
+/**
+ * @brief Finds the index slot that refers to a key.
+ * @return The slot, or `shard.index.size()` if the key is not cached.
+ * @note Slots hold the full hash, so the key text is only compared once the hash matches.
+ */
+std::size_t ExpressionCache::findSlot(const Shard& shard, std::string_view key, std::uint64_t hash, Notation notation) {
+    const std::size_t mask = shard.index.size() - 1;
+    for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        const IndexSlot& candidate = shard.index[slot];
+        if (candidate.entry == 0) return shard.index.size();
+        if (candidate.hash != hash) continue;
+        const Entry& entry = shard.entries[candidate.entry - 1];
+        if (entry.notation == notation && entry.key == key) return slot;
+    }
+}
+
+/**
+ * @brief Finds the entry for a key and marks it recently used.
+ * @return The entry, or null on a miss.
+ * @note The shard's mutex must be held.
+ */
+ExpressionCache::Entry* ExpressionCache::find(Shard& shard, std::string_view key, std::uint64_t hash, Notation notation) {
+    std::size_t slot = findSlot(shard, key, hash, notation);
+    if (slot == shard.index.size()) return nullptr;
+    Entry& entry = shard.entries[shard.index[slot].entry - 1];
+    entry.referenced = true;
+    return &entry;
+}
+
+/**
+ * @brief Frees the entry an index slot refers to and removes the slot.
+ * @note Later slots of the same probe run are shifted back so lookups never stop at the hole.
+ */
+void ExpressionCache::eraseSlot(Shard& shard, std::size_t slot) {
+    const std::uint32_t position = shard.index[slot].entry - 1;
+    Entry& entry = shard.entries[position];
+    EntryDetails& details = shard.details[position];
+    shard.bytes -= details.bytes;
+    entry.live = false;
+    entry.key.clear();
+    entry.key.shrink_to_fit();
+    details.program.reset();
+    shard.freeEntries.push_back(position);
+    shard.liveCount--;
+
+    const std::size_t mask = shard.index.size() - 1;
+    std::size_t hole = slot;
+    for (std::size_t next = (hole + 1) & mask; shard.index[next].entry != 0; next = (next + 1) & mask) {
+        std::size_t home = shard.index[next].hash & mask;
+        // Move the slot back unless its home lies cyclically in (hole, next]
+        bool stays = hole <= next ? (home > hole && home <= next) : (home > hole || home <= next);
+        if (!stays) {
+            shard.index[hole] = shard.index[next];
+            hole = next;
+        }
+    }
+    shard.index[hole] = IndexSlot{ 0, 0 };
+}
+
+/**
+ * @brief Evicts one entry with the CLOCK policy.
+ * @note The hand clears the flag of every recently used entry it passes, so an entry is evicted only if
+ *       it has not been hit since the hand last went by.
+ */
+void ExpressionCache::evictOne(Shard& shard) {
+    while (true) {
+        if (shard.clockHand >= shard.entries.size()) shard.clockHand = 0;
+        Entry& entry = shard.entries[shard.clockHand++];
+        if (!entry.live) continue;
+        if (entry.referenced) {
+            entry.referenced = false;
+            continue;
+        }
+        eraseSlot(shard, findSlot(shard, entry.key, entry.hash, entry.notation));
+        shard.evictions++;
+        return;
+    }
+}
+
+void ExpressionCache::growIndex(Shard& shard) {
+    std::vector<IndexSlot> grown(shard.index.size() * 2, IndexSlot{ 0, 0 });
+    const std::size_t mask = grown.size() - 1;
+    for (const IndexSlot& slot : shard.index) {
+        if (slot.entry == 0) continue;
+        std::size_t position = slot.hash & mask;
+        while (grown[position].entry != 0) position = (position + 1) & mask;
+        grown[position] = slot;
+    }
+    shard.index.swap(grown);
+}
+
+/**
+ * @brief Looks up the result of evaluating an expression.
+ * @param expression The expression text as given to the calculator.
+ * @param notation How the text is parsed.
+ * @param value Receives the cached result on a hit.
+ * @param errorCode Receives the cached error code on a hit.
+ * @return True on a hit.
+ */
+bool ExpressionCache::findValue(std::string_view expression, Notation notation, double& value, int& errorCode) {
+    NormalizedKey key(expression);
+    const std::uint64_t hash = keyHash(key.text(), notation);
+    Shard& shard = shardFor(hash);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Entry* entry = find(shard, key.text(), hash, notation);
+    if (entry == nullptr) {
+        shard.misses++;
+        return false;
+    }
+    shard.hits++;
+    value = entry->value;
+    errorCode = entry->errorCode;
+    return true;
+}
+
+/**
+ * @brief Looks up the compiled form of an expression that has variables.
+ * @param expression The expression text.
+ * @param notation How the text is parsed.
+ * @return The shared Program, or null on a miss or if the expression has no variables.
+ */
+std::shared_ptr<const Program> ExpressionCache::findProgram(std::string_view expression, Notation notation) {
+    NormalizedKey key(expression);
+    const std::uint64_t hash = keyHash(key.text(), notation);
+    Shard& shard = shardFor(hash);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Entry* entry = find(shard, key.text(), hash, notation);
+    const std::shared_ptr<const Program>* program =
+        entry != nullptr ? &shard.details[static_cast<std::size_t>(entry - shard.entries.data())].program : nullptr;
+    if (program == nullptr || *program == nullptr) {
+        shard.misses++;
+        return nullptr;
+    }
+    shard.hits++;
+    return *program;
+}
+
+/**
+ * @brief Caches the outcome of compiling and running an expression.
+ * @param expression The expression text.
+ * @param notation How the text is parsed.
+ * @param program The compiled expression; copied only if it has variables.
+ * @param value Result of running the program without variables.
+ * @param errorCode Error code of that run.
+ * @note Replaces any entry with the same key, then evicts entries until the shard fits its budget.
+ *       An entry larger than a whole shard is not cached.
+ */
+void ExpressionCache::insert(std::string_view expression, Notation notation, const Program& program,
+                             double value, int errorCode) {
+    NormalizedKey key(expression);
+    const std::uint64_t hash = keyHash(key.text(), notation);
+    Shard& shard = shardFor(hash);
+
+    std::shared_ptr<const Program> shared;
+    std::size_t bytes = sizeof(Entry) + sizeof(EntryDetails) + 2 * sizeof(IndexSlot) + key.text().size();
+    if (!program.variables.empty() && program.errorCode == 0) {
+        shared = std::make_shared<const Program>(program);
+        bytes += programBytes(*shared);
+    }
+    if (bytes > shardCapacity) return;
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    std::size_t existing = findSlot(shard, key.text(), hash, notation);
+    if (existing != shard.index.size()) eraseSlot(shard, existing);
+
+    while (shard.bytes + bytes > shardCapacity && shard.liveCount > 0) evictOne(shard);
+    if ((shard.liveCount + 1) * 2 > shard.index.size()) growIndex(shard);
+
+    std::uint32_t position;
+    if (!shard.freeEntries.empty()) {
+        position = shard.freeEntries.back();
+        shard.freeEntries.pop_back();
+    } else {
+        position = static_cast<std::uint32_t>(shard.entries.size());
+        shard.entries.emplace_back();
+        shard.details.emplace_back();
+    }
+
+    Entry& entry = shard.entries[position];
+    entry.hash = hash;
+    entry.key.assign(key.text().data(), key.text().size());
+    entry.notation = notation;
+    entry.referenced = false;
+    entry.live = true;
+    entry.errorCode = errorCode;
+    entry.value = value;
+    shard.details[position].program = std::move(shared);
+    shard.details[position].bytes = bytes;
+    shard.bytes += bytes;
+    shard.liveCount++;
+
+    const std::size_t mask = shard.index.size() - 1;
+    std::size_t slot = hash & mask;
+    while (shard.index[slot].entry != 0) slot = (slot + 1) & mask;
+    shard.index[slot] = IndexSlot{ hash, position + 1 };
+}
+
+ExpressionCacheStats ExpressionCache::stats() const {
+    ExpressionCacheStats total;
+    for (unsigned i = 0; i <= shardMask; ++i) {
+        const Shard& shard = shards[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        total.hits += shard.hits;
+        total.misses += shard.misses;
+        total.evictions += shard.evictions;
+        total.entries += shard.liveCount;
+        total.bytes += shard.bytes;
+    }
+    return total;
+}
+
+void ExpressionCache::clear() {
+    for (unsigned i = 0; i <= shardMask; ++i) {
+        Shard& shard = shards[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.index.assign(InitialIndexSize, IndexSlot{ 0, 0 });
+        shard.entries.clear();
+        shard.details.clear();
+        shard.freeEntries.clear();
+        shard.liveCount = 0;
+        shard.clockHand = 0;
+        shard.bytes = 0;
+    }
+}
@@ -0,0 +1,117 @@
+//##################################################
+// File: ExpressionCache.h
+// Description: A thread-safe, sharded LRU cache of evaluated results and compiled Programs keyed by expression text.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef EXPRESSIONCACHE_H
+#define EXPRESSIONCACHE_H
+
+#include "Program.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Counters summed over all shards.
+ */
+struct ExpressionCacheStats {
+    std::uint64_t hits = 0;       ///< Lookups answered from the cache.
+    std::uint64_t misses = 0;     ///< Lookups that found nothing.
+    std::uint64_t evictions = 0;  ///< Entries dropped to stay within capacity.
+    std::size_t entries = 0;      ///< Entries currently cached.
+    std::size_t bytes = 0;        ///< Approximate memory held by the entries.
+};
+
+/**
+ * @brief Caches the outcome of evaluating expression text.
+ * @note Keys are the text with runs of spaces collapsed and leading/trailing spaces removed (the
+ *       calculators treat those spellings identically) plus the notation. Variable-free expressions keep
+ *       only their value and error code; expressions with variables keep their compiled Program for
+ *       `RPNCalculator::run`. Each shard has its own lock, index and eviction order, so threads rarely
+ *       contend. Recency is tracked with the CLOCK approximation of LRU: a hit only sets a flag, and
+ *       eviction skips (and clears) flagged entries once before taking them.
+ */
+class ExpressionCache {
+public:
+    explicit ExpressionCache(std::size_t capacityBytes, unsigned shardCount = 16); ///< Creates an empty cache.
+
+    ExpressionCache(const ExpressionCache&) = delete;
+    ExpressionCache& operator=(const ExpressionCache&) = delete;
+
+    bool findValue(std::string_view expression, Notation notation, double& value, int& errorCode); ///< Looks up a cached result.
+    std::shared_ptr<const Program> findProgram(std::string_view expression, Notation notation); ///< Looks up a cached Program.
+    void insert(std::string_view expression, Notation notation, const Program& program, double value, int errorCode); ///< Caches an outcome.
+
+    ExpressionCacheStats stats() const; ///< Returns the counters summed over all shards.
+    void clear();                       ///< Drops every entry (counters are kept).
+
+private:
+    /**
+     * @brief The fields a hit reads, packed into one cache line.
+     */
+    struct alignas(64) Entry {
+        std::uint64_t hash;
+        double value;          ///< Result of running without variables.
+        int errorCode;
+        Notation notation;
+        bool referenced;       ///< Set on every hit; cleared as the clock hand passes.
+        bool live;             ///< False for free slots.
+        std::string key;       ///< Normalized expression text.
+    };
+
+    /**
+     * @brief The fields only insertion, eviction and `findProgram` need, kept apart from the hot entries.
+     */
+    struct EntryDetails {
+        std::shared_ptr<const Program> program;  ///< Only for expressions with variables.
+        std::size_t bytes;                       ///< Approximate footprint charged against the capacity.
+    };
+
+    /**
+     * @brief Open-addressing index slot: the full hash and the entry's position plus one (0 = empty).
+     */
+    struct IndexSlot {
+        std::uint64_t hash;
+        std::uint32_t entry;
+    };
+
+    /**
+     * @brief One independently locked part of the cache.
+     */
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::vector<IndexSlot> index;       ///< Linear probing, power-of-two size, at most half full.
+        std::vector<Entry> entries;         ///< Entry slab; the clock hand sweeps over it.
+        std::vector<EntryDetails> details;  ///< Parallel to `entries`.
+        std::vector<std::uint32_t> freeEntries;
+        std::size_t liveCount = 0;
+        std::size_t clockHand = 0;
+        std::size_t bytes = 0;
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    unsigned shardMask;          ///< Shard count minus one (the count is a power of two).
+    std::size_t shardCapacity;   ///< Byte budget of each shard.
+
+    Shard& shardFor(std::uint64_t hash) { return shards[(hash >> 32) & shardMask]; }
+    static Entry* find(Shard& shard, std::string_view key, std::uint64_t hash, Notation notation); ///< Finds an entry and marks it used; lock held.
+    static std::size_t findSlot(const Shard& shard, std::string_view key, std::uint64_t hash, Notation notation); ///< Index slot of a key, or the index size.
+    static void eraseSlot(Shard& shard, std::size_t slot);   ///< Frees an entry and closes the gap in its probe run; lock held.
+    static void evictOne(Shard& shard);                      ///< Advances the clock hand to a victim and erases it; lock held.
+    static void growIndex(Shard& shard);                     ///< Doubles the index and reinserts every live entry; lock held.
+};
+
+std::size_t normalizeExpression(std::string_view expression, char* out); ///< Collapses space runs; `out` needs `expression.size()` bytes.
+
+#endif // EXPRESSIONCACHE_H
@@ -0,0 +1,254 @@
+//##################################################
+// File: ExpressionPipeline.cpp
+// Description: Reader, evaluator and writer stages of the threaded expression pipeline, joined by bounded queues.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "ExpressionPipeline.h"
+#include "BufferedWriter.h"
+#include "ConcurrentQueue.h"
+#include "InfixCalculator.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const std::size_t ReadChunk = 1 << 20;
+
+/**
+ * @brief A run of consecutive input lines and, once evaluated, their results.
+ * @note Batches are recycled through a fixed pool, so their buffers stop growing after warm-up.
+ */
+struct Batch {
+    std::size_t sequence = 0;              ///< Position of the batch in the input.
+    std::string text;                      ///< The lines back to back, carriage returns removed.
+    std::vector<std::size_t> lineEnds;     ///< End offset of each line in `text`.
+    std::vector<double> results;
+    std::vector<int> errorCodes;
+};
+
+typedef std::chrono::steady_clock Clock;
+
+std::uint64_t nanosecondsSince(Clock::time_point start) {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+
+/**
+ * @brief State shared by the stages.
+ * @note Only `window` batches exist. The reader has to take a free one before it can read further,
+ *       which is the backpressure: a slow writer or slow evaluators stall the reader instead of
+ *       letting input pile up in memory.
+ */
+struct Pipeline {
+    explicit Pipeline(std::size_t window) : freeBatches(window), work(window), finished(window) {}
+
+    MpmcQueue<Batch*> freeBatches;
+    MpmcQueue<Batch*> work;
+    MpmcQueue<Batch*> finished;
+    std::atomic<unsigned> runningEvaluators{ 0 };
+    std::atomic<std::uint64_t> evaluateNs{ 0 };
+};
+
+/**
+ * @brief Reader stage: splits the input into batches of whole lines and queues them for evaluation.
+ * @return False if reading failed.
+ */
+bool readBatches(std::FILE* in, std::size_t batchSize, Pipeline& pipeline, PipelineStats& stats) {
+    std::vector<char> chunk(ReadChunk);
+    std::string carry; // A line split across two reads
+    std::size_t sequence = 0;
+    Batch* batch = nullptr;
+
+    auto acquire = [&] {
+        if (!pipeline.freeBatches.tryDequeue(batch)) {
+            Clock::time_point start = Clock::now();
+            pipeline.freeBatches.dequeue(batch);
+            stats.readerStallNs += nanosecondsSince(start);
+        }
+        batch->sequence = sequence++;
+        batch->text.clear();
+        batch->lineEnds.clear();
+    };
+    auto submit = [&] {
+        pipeline.work.enqueue(batch);
+        batch = nullptr;
+    };
+    auto addLine = [&](std::string_view line) {
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (!batch) acquire();
+        batch->text.append(line);
+        batch->lineEnds.push_back(batch->text.size());
+        if (batch->lineEnds.size() == batchSize) submit();
+    };
+
+    std::size_t got;
+    while ((got = std::fread(chunk.data(), 1, chunk.size(), in)) > 0) {
+        stats.inputBytes += got;
+        const char* data = chunk.data();
+        std::size_t start = 0;
+        while (const char* newline = static_cast<const char*>(std::memchr(data + start, '\n', got - start))) {
+            std::string_view line(data + start, static_cast<std::size_t>(newline - data) - start);
+            if (carry.empty()) {
+                addLine(line);
+            } else {
+                carry.append(line);
+                addLine(carry);
+                carry.clear();
+            }
+            start = static_cast<std::size_t>(newline - data) + 1;
+        }
+        carry.append(data + start, got - start);
+    }
+    if (!carry.empty()) addLine(carry);
+    if (batch) submit();
+    pipeline.work.close();
+    return !std::ferror(in);
+}
+
+/**
+ * @brief Evaluator stage: compiles and runs every line of each batch with this thread's own calculator.
+ * @note Each line is compiled into a reusable Program and run, as `evaluateFile` does, so a failed
+ *       expression never leaves operands behind for the next one. The last evaluator to finish
+ *       closes the queue the writer reads.
+ */
+void evaluateBatches(Notation notation, Pipeline& pipeline) {
+    InfixCalculator calculator;
+    Program program;
+    std::uint64_t busyNs = 0;
+    Batch* batch;
+    while (pipeline.work.dequeue(batch)) {
+        Clock::time_point start = Clock::now();
+        const std::size_t lines = batch->lineEnds.size();
+        batch->results.resize(lines);
+        batch->errorCodes.resize(lines);
+        std::size_t begin = 0;
+        for (std::size_t i = 0; i < lines; ++i) {
+            std::string_view line(batch->text.data() + begin, batch->lineEnds[i] - begin);
+            begin = batch->lineEnds[i];
+            if (notation == Notation::RPN) RPNCalculator::compile(line, program);
+            else calculator.compileInfix(line, program);
+            batch->errorCodes[i] = 0;
+            batch->results[i] = calculator.run(program, batch->errorCodes[i]);
+        }
+        busyNs += nanosecondsSince(start);
+        pipeline.finished.enqueue(batch);
+    }
+    pipeline.evaluateNs.fetch_add(busyNs, std::memory_order_relaxed);
+    if (pipeline.runningEvaluators.fetch_sub(1, std::memory_order_acq_rel) == 1) pipeline.finished.close();
+}
+
+/**
+ * @brief Writer stage: holds finished batches until every earlier one is written, then writes them in order.
+ * @return False if writing failed.
+ */
+bool writeBatches(std::FILE* out, std::size_t window, Pipeline& pipeline, PipelineStats& stats) {
+    BufferedWriter writer(out);
+    std::vector<Batch*> pending(window, nullptr); // Indexed by sequence modulo the window
+    std::size_t next = 0;
+    std::size_t held = 0;
+
+    for (;;) {
+        Batch* batch;
+        if (!pipeline.finished.tryDequeue(batch)) {
+            Clock::time_point start = Clock::now();
+            bool got = pipeline.finished.dequeue(batch);
+            stats.writerWaitNs += nanosecondsSince(start);
+            if (!got) break;
+        }
+        // At most `window` batches exist, so sequences in flight never share a slot
+        pending[batch->sequence % window] = batch;
+        held++;
+        if (held - 1 > stats.maxReorder) stats.maxReorder = held - 1;
+
+        while (Batch* ready = pending[next % window]) {
+            for (std::size_t i = 0; i < ready->errorCodes.size(); ++i) {
+                if (ready->errorCodes[i] == 0) {
+                    writer.writeDouble(ready->results[i]);
+                } else {
+                    writer.write("error ", 6);
+                    writer.writeInt(ready->errorCodes[i]);
+                    stats.errors++;
+                }
+                writer.put('\n');
+            }
+            stats.lines += ready->errorCodes.size();
+            stats.batches++;
+            pending[next % window] = nullptr;
+            held--;
+            next++;
+            pipeline.freeBatches.enqueue(ready);
+        }
+    }
+    return writer.flush();
+}
+
+} // namespace
+
+/**
+ * @brief Evaluates one expression per input line on several threads, writing the results in input order.
+ * @param in The input stream, one expression per line ("\n" or "\r\n" endings).
+ * @param out Receives one line per input line: the result, or "error N".
+ * @param options Notation, thread count, batch size and window.
+ * @param stats Optional totals and timings.
+ * @return False if reading or writing failed.
+ * @note A reader thread fills batches, the evaluator threads drain them from a bounded MPMC queue,
+ *       and the calling thread is the writer. Memory is bounded by `window` batches of `batchSize`
+ *       lines whatever the input size.
+ */
+bool evaluateStream(std::FILE* in, std::FILE* out, const PipelineOptions& options, PipelineStats* stats) {
+    Clock::time_point start = Clock::now();
+    PipelineStats totals;
+    totals.threads = options.threads ? options.threads : std::thread::hardware_concurrency();
+    if (totals.threads == 0) totals.threads = 1;
+    totals.window = options.window ? options.window : 4 * static_cast<std::size_t>(totals.threads);
+    if (totals.window < 2) totals.window = 2;
+    const std::size_t batchSize = options.batchSize ? options.batchSize : 1;
+
+    Pipeline pipeline(totals.window);
+    std::unique_ptr<Batch[]> batches(new Batch[totals.window]);
+    for (std::size_t i = 0; i < totals.window; ++i) pipeline.freeBatches.enqueue(&batches[i]);
+
+    bool readOk = true;
+    pipeline.runningEvaluators.store(totals.threads, std::memory_order_relaxed);
+    std::vector<std::thread> evaluators;
+    for (unsigned i = 0; i < totals.threads; ++i) {
+        evaluators.emplace_back(evaluateBatches, options.notation, std::ref(pipeline));
+    }
+    std::thread reader([&] { readOk = readBatches(in, batchSize, pipeline, totals); });
+
+    bool writeOk = writeBatches(out, totals.window, pipeline, totals);
+
+    reader.join();
+    for (std::thread& evaluator : evaluators) evaluator.join();
+    totals.evaluateNs = pipeline.evaluateNs.load(std::memory_order_relaxed);
+    totals.elapsedNs = nanosecondsSince(start);
+    if (stats) *stats = totals;
+    return readOk && writeOk;
+}
+
+/**
+ * @brief Writes a human-readable summary of a pipeline run.
+ * @param stats Totals from `evaluateStream`.
+ * @param out The stream to write to (usually stderr, so results on stdout stay clean).
+ */
+void printPipelineStats(const PipelineStats& stats, std::FILE* out) {
+    double seconds = static_cast<double>(stats.elapsedNs) / 1e9;
+    double busy = stats.elapsedNs ? static_cast<double>(stats.evaluateNs) / (static_cast<double>(stats.elapsedNs) * stats.threads) : 0.0;
+    std::fprintf(out, "lines             %zu (%zu errors) in %zu batches\n", stats.lines, stats.errors, stats.batches);
+    std::fprintf(out, "elapsed           %.3f s, %.0f lines/s, %.1f MB/s\n", seconds,
+                 seconds > 0 ? static_cast<double>(stats.lines) / seconds : 0.0,
+                 seconds > 0 ? static_cast<double>(stats.inputBytes) / seconds / 1e6 : 0.0);
+    std::fprintf(out, "evaluators        %u, %.0f%% busy\n", stats.threads, busy * 100.0);
+    std::fprintf(out, "window            %zu batches, max %zu held for reordering\n", stats.window, stats.maxReorder);
+    std::fprintf(out, "reader stalled    %.3f s (backpressure)\n", static_cast<double>(stats.readerStallNs) / 1e9);
+    std::fprintf(out, "writer waited     %.3f s\n", static_cast<double>(stats.writerWaitNs) / 1e9);
+}
@@ -0,0 +1,57 @@
+//##################################################
+// File: ExpressionPipeline.h
+// Description: Streams expressions through a reader thread, evaluator threads and an in-order writer thread.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef EXPRESSIONPIPELINE_H
+#define EXPRESSIONPIPELINE_H
+
+#include "Program.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * @brief Settings for `evaluateStream`.
+ */
+struct PipelineOptions {
+    Notation notation = Notation::RPN;
+    unsigned threads = 0;          ///< Evaluator threads (0 = one per hardware thread).
+    std::size_t batchSize = 1024;  ///< Lines handed to an evaluator at a time.
+    std::size_t window = 0;        ///< Batches in flight, which bounds memory and the reorder distance (0 = 4 per evaluator).
+};
+
+/**
+ * @brief Totals and stage timings gathered by `evaluateStream`.
+ */
+struct PipelineStats {
+    std::size_t lines = 0;              ///< Expressions evaluated.
+    std::size_t errors = 0;             ///< Expressions that produced a non-zero error code.
+    std::size_t batches = 0;            ///< Batches passed through the pipeline.
+    std::size_t inputBytes = 0;         ///< Bytes read.
+    unsigned threads = 0;               ///< Evaluator threads used.
+    std::size_t window = 0;             ///< Batches in flight.
+    std::size_t maxReorder = 0;         ///< Most finished batches the writer held back waiting for an earlier one.
+    std::uint64_t elapsedNs = 0;        ///< Wall time of the whole run.
+    std::uint64_t readerStallNs = 0;    ///< Time the reader waited for a free batch (backpressure).
+    std::uint64_t evaluateNs = 0;       ///< Time spent evaluating, summed over the evaluator threads.
+    std::uint64_t writerWaitNs = 0;     ///< Time the writer waited for the next batch in order.
+};
+
+/**
+ * @brief Evaluates one expression per input line on several threads, writing the results in input order.
+ * @param in The input stream, one expression per line.
+ * @param out Receives one line per input line: the result, or "error N" (as `evaluateFile` writes).
+ * @param options Notation, thread count, batch size and window.
+ * @param stats Optional totals and timings.
+ * @return False if reading or writing failed.
+ */
+bool evaluateStream(std::FILE* in, std::FILE* out, const PipelineOptions& options, PipelineStats* stats = nullptr);
+
+void printPipelineStats(const PipelineStats& stats, std::FILE* out); ///< Writes a human-readable summary of `stats`.
+
+#endif // EXPRESSIONPIPELINE_H
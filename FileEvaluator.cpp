@@ -0,0 +1,83 @@
+//##################################################
+// File: FileEvaluator.cpp
+// Description: Zero-copy line splitting and evaluation over a memory-mapped expression file.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "FileEvaluator.h"
+#include "BufferedWriter.h"
+#include "InfixCalculator.h"
+#include "MappedFile.h"
+
+#include <cstring>
+#include <string_view>
+
+namespace {
+
+// Already-evaluated input is dropped from the resident set in windows of this size.
+const std::size_t ReleaseWindow = 16u << 20;
+
+} // namespace
+
+/**
+ * @brief Evaluates every line of a file and writes one result per line.
+ * @param path The input file, one expression per line ("\n" or "\r\n" endings).
+ * @param notation How to parse the expressions.
+ * @param out Receives one line per input line: the result, or "error N".
+ * @param stats Optional totals.
+ * @return False if the file cannot be mapped or the output cannot be written.
+ * @note Lines are compiled straight out of the mapping as string views, so tokens are never copied or
+ *       truncated. Pages behind the read position are released as the scan advances, which keeps the
+ *       resident set bounded by the release window rather than by the file size.
+ */
+bool evaluateFile(const char* path, Notation notation, std::FILE* out, FileEvaluationStats* stats) {
+    MappedFile file;
+    if (!file.open(path)) return false;
+    file.adviseSequential();
+
+    InfixCalculator calculator;
+    Program program;
+    BufferedWriter writer(out);
+    FileEvaluationStats totals = { 0, 0 };
+
+    const char* data = file.data();
+    const std::size_t size = file.size();
+    std::size_t pos = 0;
+    std::size_t released = 0;
+
+    while (pos < size) {
+        const char* lineStart = data + pos;
+        const char* newline = static_cast<const char*>(std::memchr(lineStart, '\n', size - pos));
+        const char* lineEnd = newline ? newline : data + size;
+        pos = static_cast<std::size_t>(lineEnd - data) + (newline ? 1 : 0);
+
+        std::size_t length = static_cast<std::size_t>(lineEnd - lineStart);
+        if (length > 0 && lineStart[length - 1] == '\r') length--;
+        std::string_view line(lineStart, length);
+
+        if (notation == Notation::RPN) RPNCalculator::compile(line, program);
+        else calculator.compileInfix(line, program);
+
+        int errorCode = 0;
+        double result = calculator.run(program, errorCode);
+        if (errorCode == 0) {
+            writer.writeDouble(result);
+        } else {
+            writer.write("error ", 6);
+            writer.writeInt(errorCode);
+            totals.errors++;
+        }
+        writer.put('\n');
+        totals.lines++;
+
+        if (pos - released >= ReleaseWindow) {
+            file.release(released, pos);
+            released = pos;
+        }
+    }
+
+    if (stats) *stats = totals;
+    return writer.flush();
+}
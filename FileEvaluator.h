@@ -0,0 +1,35 @@
+//##################################################
+// File: FileEvaluator.h
+// Description: Evaluates a file with one expression per line through a read-only memory mapping.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef FILEEVALUATOR_H
+#define FILEEVALUATOR_H
+
+#include "Program.h"
+
+#include <cstddef>
+#include <cstdio>
+
+/**
+ * @brief Totals gathered while evaluating a file.
+ */
+struct FileEvaluationStats {
+    std::size_t lines;  ///< Expressions evaluated.
+    std::size_t errors; ///< Expressions that produced a non-zero error code.
+};
+
+/**
+ * @brief Evaluates every line of a file and writes one result per line.
+ * @param path The input file, one expression per line.
+ * @param notation How to parse the expressions.
+ * @param out Receives one line per input line: the result, or "error N".
+ * @param stats Optional totals.
+ * @return False if the file cannot be mapped or the output cannot be written.
+ */
+bool evaluateFile(const char* path, Notation notation, std::FILE* out, FileEvaluationStats* stats = nullptr);
+
+#endif // FILEEVALUATOR_H
@@ -0,0 +1,267 @@
+//##################################################
+// File: FormulaGraph.cpp
+// Description: Named formula cells that reference each other, recomputed lazily when their inputs change.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "FormulaGraph.h"
+#include "ProgramOptimizer.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * @brief Returns the id of the cell with this name.
+ * @param name The cell's name.
+ * @return The existing cell, or a new empty input cell (error 1 until it is set or defined).
+ */
+FormulaGraph::CellId FormulaGraph::cell(std::string_view name) {
+    auto found = ids.find(std::string(name));
+    if (found != ids.end()) return found->second;
+    CellId id = static_cast<CellId>(cells.size());
+    cells.emplace_back().name = name;
+    values.push_back(0.0);
+    errors.push_back(1);
+    state.push_back(0);
+    ids.emplace(std::string(name), id);
+    return id;
+}
+
+/**
+ * @brief Looks up a cell without creating it.
+ * @param name The cell's name.
+ * @param id Receives the cell's id when it exists.
+ * @return True if a cell has this name.
+ */
+bool FormulaGraph::find(std::string_view name, CellId& id) const {
+    auto found = ids.find(std::string(name));
+    if (found == ids.end()) return false;
+    id = found->second;
+    return true;
+}
+
+/**
+ * @brief Compiles a formula into a cell and links it to the cells its variables name.
+ * @param name The cell to define; created if needed. An input cell becomes a formula.
+ * @param expression The formula; its variables are cell names.
+ * @param notation How `expression` is written.
+ * @return 0 on success, the compile error (1 or 2; the cell then reads as that error), or
+ *         `CycleError` if the cell would depend on itself, in which case nothing changes.
+ * @note The cycle check walks only the cells downstream of `name`, so redefining a cell costs about
+ *       as much as the recomputation it causes.
+ */
+int FormulaGraph::define(std::string_view name, std::string_view expression, Notation notation) {
+    CellId id = cell(name);
+    Program program;
+    if (notation == Notation::Infix) infix.compileInfix(expression, program);
+    else RPNCalculator::compile(expression, program);
+    optimizeProgram(program);
+
+    std::vector<CellId> inputs;
+    if (program.errorCode == 0) {
+        for (const std::string& variable : program.variables) inputs.push_back(cell(variable));
+    }
+    if (reaches(id, inputs)) return CycleError;
+
+    Cell& target = cells[id];
+    for (CellId input : target.inputs) {
+        std::vector<CellId>& readers = cells[input].dependents;
+        *std::find(readers.begin(), readers.end(), id) = readers.back();
+        readers.pop_back();
+    }
+    for (CellId input : inputs) cells[input].dependents.push_back(id);
+    target.program = std::move(program);
+    target.inputs = std::move(inputs);
+    target.formula = true;
+    markDirty(id);
+    return target.program.errorCode;
+}
+
+/**
+ * @brief Stores a value in a cell and marks everything downstream of it dirty.
+ * @param id The cell; a formula cell drops its formula and becomes an input.
+ * @param value The new value.
+ */
+void FormulaGraph::set(CellId id, double value) {
+    Cell& target = cells[id];
+    if (target.formula) {
+        for (CellId input : target.inputs) {
+            std::vector<CellId>& readers = cells[input].dependents;
+            *std::find(readers.begin(), readers.end(), id) = readers.back();
+            readers.pop_back();
+        }
+        target.inputs.clear();
+        target.program.clear();
+        target.formula = false;
+        if ((state[id] & Dirty) != 0) {
+            state[id] &= ~Dirty;
+            dirty--;
+        }
+    }
+    values[id] = value;
+    errors[id] = 0;
+    markDirty(id);
+}
+
+/**
+ * @brief Sets several inputs before anything is recomputed.
+ * @param changes Cell ids and their new values.
+ * @note Marking stops at cells that are already dirty, so downstream cells shared by several of the
+ *       changed inputs are visited once.
+ */
+void FormulaGraph::set(const std::vector<std::pair<CellId, double>>& changes) {
+    for (const std::pair<CellId, double>& change : changes) set(change.first, change.second);
+}
+
+/**
+ * @brief Returns a cell's current value.
+ * @param id The cell.
+ * @param errorCode Receives the cell's error code: 0, 1-3 from its formula or an input, or 1 for an empty input.
+ * @return The value, or 0 in case of error.
+ * @note Only the dirty cells this one depends on are recomputed.
+ */
+double FormulaGraph::value(CellId id, int& errorCode) {
+    refresh(id);
+    errorCode = errors[id];
+    return values[id];
+}
+
+/**
+ * @brief Returns the current value of a named cell.
+ * @param name The cell's name.
+ * @param errorCode Receives the cell's error code, or 1 if there is no such cell.
+ * @return The value, or 0 in case of error.
+ */
+double FormulaGraph::value(std::string_view name, int& errorCode) {
+    CellId id;
+    if (!find(name, id)) {
+        errorCode = 1;
+        return 0.0;
+    }
+    return value(id, errorCode);
+}
+
+/**
+ * @brief Brings every cell up to date.
+ * @return The number of formulas run.
+ */
+std::size_t FormulaGraph::recompute() {
+    const std::uint64_t before = evaluated;
+    for (CellId id : pending) {
+        state[id] &= ~Queued;
+        refresh(id);
+    }
+    pending.clear();
+    return static_cast<std::size_t>(evaluated - before);
+}
+
+/**
+ * @brief Checks whether defining `from` over `targets` would close a cycle.
+ * @param from The cell being defined.
+ * @param targets The cells its new formula reads.
+ * @return True if a target is `from` itself or one of the cells that read it, directly or not.
+ */
+bool FormulaGraph::reaches(CellId from, const std::vector<CellId>& targets) {
+    if (targets.empty()) return false;
+    if (epoch > std::numeric_limits<std::uint32_t>::max() - 2) {
+        for (Cell& c : cells) c.visited = 0;
+        epoch = 0;
+    }
+    const std::uint32_t target = ++epoch;
+    const std::uint32_t seen = ++epoch;
+    for (CellId id : targets) cells[id].visited = target;
+
+    work.clear();
+    work.push_back(from);
+    while (!work.empty()) {
+        Cell& current = cells[work.back()];
+        work.pop_back();
+        if (current.visited == target) return true;
+        if (current.visited == seen) continue;
+        current.visited = seen;
+        work.insert(work.end(), current.dependents.begin(), current.dependents.end());
+    }
+    return false;
+}
+
+/**
+ * @brief Marks a changed cell's downstream cells dirty.
+ * @param id A formula that was redefined (marked itself) or an input that was set (not marked).
+ * @note A dirty cell's dependents are already dirty, so the walk does not go past one.
+ */
+void FormulaGraph::markDirty(CellId id) {
+    work.clear();
+    if (cells[id].formula) work.push_back(id);
+    else work.assign(cells[id].dependents.begin(), cells[id].dependents.end());
+    while (!work.empty()) {
+        CellId current = work.back();
+        work.pop_back();
+        if ((state[current] & Dirty) != 0) continue;
+        if ((state[current] & Queued) == 0) pending.push_back(current);
+        state[current] |= Dirty | Queued;
+        dirty++;
+        const std::vector<CellId>& readers = cells[current].dependents;
+        work.insert(work.end(), readers.begin(), readers.end());
+    }
+
+    // Cells read through `value` stay listed; drop them once they outnumber the dirty ones
+    if (pending.size() > 2 * dirty + 64) {
+        std::erase_if(pending, [&](CellId listed) {
+            if ((state[listed] & Dirty) != 0) return false;
+            state[listed] &= ~Queued;
+            return true;
+        });
+    }
+}
+
+/**
+ * @brief Recomputes a cell and the dirty cells it depends on, inputs first.
+ * @param id The cell to bring up to date; nothing happens if it is clean.
+ * @note A cell stays on the stack until all its inputs are clean. Each formula runs once, and a
+ *       cell is pushed at most once per formula that reads it, on top of its own first visit.
+ */
+void FormulaGraph::refresh(CellId id) {
+    if ((state[id] & Dirty) == 0) return;
+    work.clear();
+    work.push_back(id);
+    while (!work.empty()) {
+        CellId current = work.back();
+        if ((state[current] & Dirty) == 0) {
+            work.pop_back();
+            continue;
+        }
+        bool ready = true;
+        for (CellId input : cells[current].inputs) {
+            if ((state[input] & Dirty) != 0) {
+                work.push_back(input);
+                ready = false;
+            }
+        }
+        if (!ready) continue;
+        work.pop_back();
+        evaluate(current);
+    }
+}
+
+/**
+ * @brief Runs a dirty formula whose inputs are clean and stores its result.
+ * @param id The cell; it is clean afterwards.
+ */
+void FormulaGraph::evaluate(CellId id) {
+    const Cell& target = cells[id];
+    int errorCode = 0;
+    double result = 0.0;
+    arguments.resize(target.inputs.size());
+    for (std::size_t i = 0; i < target.inputs.size() && errorCode == 0; ++i) {
+        errorCode = errors[target.inputs[i]];
+        arguments[i] = values[target.inputs[i]];
+    }
+    if (errorCode == 0) result = calculator.run(target.program, arguments.data(), errorCode);
+    values[id] = errorCode == 0 ? result : 0.0;
+    errors[id] = errorCode;
+    state[id] &= ~Dirty;
+    dirty--;
+    evaluated++;
+}
@@ -0,0 +1,99 @@
+//##################################################
+// File: FormulaGraph.h
+// Description: Named formula cells that reference each other, recomputed lazily when their inputs change.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef FORMULAGRAPH_H
+#define FORMULAGRAPH_H
+
+#include "InfixCalculator.h"
+#include "Program.h"
+#include "RPNCalculator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A spreadsheet-like set of named cells: inputs hold values, formulas compute theirs from other cells.
+ * @note Variables in a formula name other cells. Naming a cell that does not exist yet creates an
+ *       empty input cell, which reads as error 1 until it is set or defined. Every formula is compiled
+ *       once. A change marks its downstream cells dirty and nothing more. The walk stops at cells that
+ *       are already dirty, so a batch of changes costs the union of their downstream cells, not the sum.
+ *       Dirty cells are recomputed only when read (`value`) or on `recompute`, inputs first. The walk
+ *       uses an explicit stack, so chains of any length are safe. A formula that would make a cell
+ *       depend on itself is rejected with error 5 and the old definition stays. A cell whose inputs
+ *       have an error takes the first such error code.
+ */
+class FormulaGraph {
+public:
+    using CellId = std::uint32_t;
+
+    static constexpr int CycleError = 5; ///< Returned by `define` for a circular reference.
+
+    CellId cell(std::string_view name);                 ///< Returns a cell's id, creating an empty input cell if needed.
+    bool find(std::string_view name, CellId& id) const; ///< Looks up a cell without creating it.
+    const std::string& name(CellId id) const { return cells[id].name; } ///< Name of a cell.
+    std::size_t size() const { return cells.size(); }   ///< Number of cells, inputs included.
+
+    int define(std::string_view name, std::string_view expression, Notation notation = Notation::RPN); ///< Sets a cell's formula; returns its compile error, 5 for a cycle, or 0.
+    void set(CellId id, double value);                   ///< Makes a cell an input holding `value`.
+    void set(std::string_view name, double value) { set(cell(name), value); } ///< Sets an input cell by name.
+    void set(const std::vector<std::pair<CellId, double>>& changes); ///< Sets several inputs at once.
+
+    double value(CellId id, int& errorCode);             ///< Returns a cell's value, recomputing only the dirty cells it depends on.
+    double value(std::string_view name, int& errorCode); ///< Returns a cell's value by name; error 1 if there is no such cell.
+    std::size_t recompute();                             ///< Recomputes every dirty cell; returns how many were recomputed.
+
+    bool isFormula(CellId id) const { return cells[id].formula; } ///< True for a formula cell, false for an input.
+    bool isDirty(CellId id) const { return (state[id] & Dirty) != 0; } ///< True if the cell is waiting to be recomputed.
+    const std::vector<CellId>& dependents(CellId id) const { return cells[id].dependents; } ///< Formulas that read this cell.
+    std::size_t dirtyCount() const { return dirty; }              ///< Cells waiting to be recomputed.
+    std::uint64_t evaluations() const { return evaluated; }       ///< Formula runs since construction.
+
+private:
+    /**
+     * @brief What a cell is; the per-cell state that every walk reads is kept in the parallel arrays below.
+     */
+    struct Cell {
+        std::vector<CellId> dependents; ///< Formulas with this cell among their inputs.
+        std::vector<CellId> inputs;     ///< The cell bound to each variable slot of `program`.
+        Program program;
+        bool formula = false;
+        std::uint32_t visited = 0;      ///< Epoch of the last cycle check that reached this cell.
+        std::string name;
+    };
+
+    enum : unsigned char {
+        Dirty = 1,   ///< Every dependent of a dirty cell is dirty too.
+        Queued = 2   ///< Listed in `pending`.
+    };
+
+    std::vector<Cell> cells;
+    std::vector<double> values;         ///< Current value of each cell.
+    std::vector<int> errors;            ///< Current error code of each cell; 1 for an empty input.
+    std::vector<unsigned char> state;   ///< `Dirty` and `Queued` flags of each cell.
+    std::unordered_map<std::string, CellId> ids;
+    std::vector<CellId> pending;        ///< Cells marked dirty since the last `recompute` (some may be clean again).
+    std::vector<CellId> work;           ///< Explicit stack for marking and recomputing.
+    std::vector<double> arguments;      ///< Input values gathered for one formula run.
+    std::size_t dirty = 0;
+    std::uint64_t evaluated = 0;
+    std::uint32_t epoch = 0;
+    RPNCalculator calculator;
+    InfixCalculator infix;
+
+    bool reaches(CellId from, const std::vector<CellId>& targets); ///< True if a target is `from` or downstream of it.
+    void markDirty(CellId id);          ///< Marks a cell's dependents (and the cell, if it is a formula) dirty.
+    void refresh(CellId id);            ///< Recomputes a dirty cell after its dirty inputs.
+    void evaluate(CellId id);           ///< Runs one formula whose inputs are all clean.
+};
+
+#endif // FORMULAGRAPH_H
@@ -0,0 +1,156 @@
+//##################################################
+// File: FrozenWordIndex.cpp
+// Description: Building the blob and Eytzinger layout, branch-free search, prefix ranges and top-K.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "FrozenWordIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace {
+
+/**
+ * @brief The first eight bytes of a word as a big-endian integer, zero-padded.
+ * @note Integer order of the prefixes agrees with string order whenever the prefixes differ.
+ */
+std::uint64_t keyPrefix(std::string_view word) {
+    unsigned char bytes[8] = {};
+    std::memcpy(bytes, word.data(), word.size() < 8 ? word.size() : 8);
+    std::uint64_t prefix = 0;
+    for (unsigned char byte : bytes) prefix = (prefix << 8) | byte;
+    return prefix;
+}
+
+} // namespace
+
+/**
+ * @brief Builds the index.
+ * @param sortedWords Distinct words with their counts, in word order (as `WordTable::sorted` returns them).
+ */
+FrozenWordIndex::FrozenWordIndex(const std::vector<WordFrequency>& sortedWords) {
+    const std::size_t n = sortedWords.size();
+    std::size_t bytes = 0;
+    for (const WordFrequency& entry : sortedWords) bytes += entry.word.size();
+    blob.reserve(bytes);
+    offsets.reserve(n + 1);
+    counts.reserve(n);
+    for (const WordFrequency& entry : sortedWords) {
+        offsets.push_back(static_cast<std::uint32_t>(blob.size()));
+        blob.append(entry.word);
+        counts.push_back(entry.count);
+    }
+    offsets.push_back(static_cast<std::uint32_t>(blob.size()));
+
+    // An in-order walk of the implicit tree visits the nodes in rank order
+    nodes.resize(n + 1, Node{ 0, 0 });
+    std::uint32_t rank = 0;
+    std::vector<std::size_t> path;
+    std::size_t k = 1;
+    while (k <= n || !path.empty()) {
+        if (k <= n) {
+            path.push_back(k);
+            k = 2 * k;
+            continue;
+        }
+        k = path.back();
+        path.pop_back();
+        nodes[k] = Node{ keyPrefix(word(rank)), rank };
+        rank++;
+        k = 2 * k + 1;
+    }
+
+    byFrequency.resize(n);
+    std::iota(byFrequency.begin(), byFrequency.end(), 0u);
+    std::stable_sort(byFrequency.begin(), byFrequency.end(),
+                     [this](std::uint32_t a, std::uint32_t b) { return counts[a] > counts[b]; });
+}
+
+/**
+ * @brief Finds where a word is or would be in word order.
+ * @param target The word to search for.
+ * @return The rank of the first word not less than `target` (`size()` if there is none).
+ * @note The descent has no data-dependent branch: each step picks child 2k or 2k+1 from the
+ *       comparison, and the answer is recovered from the final index by dropping the trailing
+ *       "went right" bits. The node three levels down is prefetched while the current one is compared.
+ */
+std::size_t FrozenWordIndex::lowerBound(std::string_view target) const {
+    const std::size_t n = counts.size();
+    const std::uint64_t prefix = keyPrefix(target);
+    const std::size_t last = nodes.size() - 1;
+    std::size_t k = 1;
+    while (k <= n) {
+        __builtin_prefetch(nodes.data() + std::min(8 * k, last)); // Near the leaves 8k is past the end
+        const Node& node = nodes[k];
+        bool less = node.prefix < prefix || (node.prefix == prefix && word(node.rank) < target);
+        k = 2 * k + (less ? 1 : 0);
+    }
+    k >>= __builtin_ffsll(static_cast<long long>(~k));
+    return k ? nodes[k].rank : n;
+}
+
+/**
+ * @brief Looks up the count of a word.
+ * @param target The word to look up.
+ * @return Its count, or 0 if it is not in the index.
+ */
+std::uint64_t FrozenWordIndex::count(std::string_view target) const {
+    std::size_t rank = lowerBound(target);
+    return rank < counts.size() && word(rank) == target ? counts[rank] : 0;
+}
+
+/**
+ * @brief Finds the ranks of the words that start with a prefix.
+ * @param prefix The prefix; empty matches every word.
+ * @return [first, last) in rank order; empty when no word matches.
+ * @note The end is the lower bound of the smallest string above every match: the prefix with its
+ *       last byte incremented (after dropping trailing 0xFF bytes, which cannot be incremented).
+ */
+std::pair<std::size_t, std::size_t> FrozenWordIndex::prefixRange(std::string_view prefix) const {
+    std::size_t first = lowerBound(prefix);
+    std::string successor(prefix);
+    while (!successor.empty() && static_cast<unsigned char>(successor.back()) == 0xFF) successor.pop_back();
+    if (successor.empty()) return std::make_pair(first, counts.size());
+    successor.back() = static_cast<char>(static_cast<unsigned char>(successor.back()) + 1);
+    return std::make_pair(first, lowerBound(successor));
+}
+
+/**
+ * @brief Lists the words that start with a prefix.
+ * @param prefix The prefix; empty matches every word.
+ * @param limit At most this many words are returned.
+ * @return The matching words with their counts, in word order.
+ */
+std::vector<WordFrequency> FrozenWordIndex::withPrefix(std::string_view prefix, std::size_t limit) const {
+    std::pair<std::size_t, std::size_t> range = prefixRange(prefix);
+    std::size_t last = range.second - range.first > limit ? range.first + limit : range.second;
+    std::vector<WordFrequency> words;
+    words.reserve(last - range.first);
+    for (std::size_t rank = range.first; rank < last; ++rank) words.push_back(WordFrequency{ word(rank), counts[rank] });
+    return words;
+}
+
+/**
+ * @brief Lists the most frequent words.
+ * @param k How many words to return (fewer if the index is smaller).
+ * @return Words by descending count; equal counts in word order.
+ */
+std::vector<WordFrequency> FrozenWordIndex::topK(std::size_t k) const {
+    if (k > byFrequency.size()) k = byFrequency.size();
+    std::vector<WordFrequency> words;
+    words.reserve(k);
+    for (std::size_t i = 0; i < k; ++i) words.push_back(WordFrequency{ word(byFrequency[i]), counts[byFrequency[i]] });
+    return words;
+}
+
+/**
+ * @brief Adds up the memory the index holds.
+ */
+std::size_t FrozenWordIndex::memoryBytes() const {
+    return blob.capacity() + offsets.capacity() * sizeof(std::uint32_t) + counts.capacity() * sizeof(std::uint64_t) +
+           nodes.capacity() * sizeof(Node) + byFrequency.capacity() * sizeof(std::uint32_t);
+}
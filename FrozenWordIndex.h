@@ -0,0 +1,64 @@
+//##################################################
+// File: FrozenWordIndex.h
+// Description: A read-only word index in one string blob with an Eytzinger search layout, prefix ranges and top-K.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef FROZENWORDINDEX_H
+#define FROZENWORDINDEX_H
+
+#include "WordTable.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Immutable word counts laid out for lookups.
+ * @note The words sit back to back in one blob in word order, addressed by rank through an offset
+ *       array. Search goes through a copy of the order in Eytzinger (breadth-first) layout: the
+ *       nodes a search visits first share cache lines, the next nodes can be prefetched before
+ *       the comparison resolves, and each node carries the first eight bytes of its word
+ *       (big-endian), so most steps compare one integer and never touch the blob. Lookup and
+ *       prefix bounds are O(log n). The frequency order for top-K is computed once, at build time.
+ */
+class FrozenWordIndex {
+public:
+    FrozenWordIndex() = default;
+    explicit FrozenWordIndex(const std::vector<WordFrequency>& sortedWords); ///< Builds from distinct words in word order.
+
+    std::uint64_t count(std::string_view word) const;  ///< Occurrences of `word` (0 if absent).
+    std::size_t lowerBound(std::string_view word) const; ///< Rank of the first word not less than `word`.
+    std::pair<std::size_t, std::size_t> prefixRange(std::string_view prefix) const; ///< Ranks [first, last) of the words starting with `prefix`.
+    std::vector<WordFrequency> withPrefix(std::string_view prefix, std::size_t limit = SIZE_MAX) const; ///< Words starting with `prefix`, in word order.
+    std::vector<WordFrequency> topK(std::size_t k) const; ///< The `k` most frequent words, ties in word order.
+
+    std::size_t size() const { return counts.size(); }                 ///< Number of distinct words.
+    std::string_view word(std::size_t rank) const {                    ///< The word at a rank in word order.
+        return std::string_view(blob.data() + offsets[rank], offsets[rank + 1] - offsets[rank]);
+    }
+    std::uint64_t countAt(std::size_t rank) const { return counts[rank]; } ///< The count at a rank in word order.
+    std::size_t memoryBytes() const;                                   ///< Bytes held by the index.
+
+private:
+    /**
+     * @brief One Eytzinger node: the word's first eight bytes as a big-endian integer and its rank.
+     */
+    struct Node {
+        std::uint64_t prefix;
+        std::uint32_t rank;
+    };
+
+    std::string blob;                       ///< Every word, in word order, without separators.
+    std::vector<std::uint32_t> offsets;     ///< Start of each word in `blob`, plus the end.
+    std::vector<std::uint64_t> counts;      ///< Count of each word, in word order.
+    std::vector<Node> nodes;                ///< Eytzinger layout, 1-based (node k has children 2k and 2k+1).
+    std::vector<std::uint32_t> byFrequency; ///< Ranks by descending count, ties by rank.
+};
+
+#endif // FROZENWORDINDEX_H
@@ -0,0 +1,81 @@
+//##################################################
+// File: Hash.h
+// Description: Fast 64-bit text hash shared by the expression cache and the word counters.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace hash_detail {
+
+const std::uint64_t HashMultiplier0 = 0x9E3779B97F4A7C15ULL;
+const std::uint64_t HashMultiplier1 = 0xBF58476D1CE4E5B9ULL;
+
+/**
+ * @brief Folds the 128-bit product of two words into one.
+ */
+inline std::uint64_t mix(std::uint64_t a, std::uint64_t b) {
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+}
+
+inline std::uint64_t load64(const char* p) {
+    std::uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline std::uint64_t load32(const char* p) {
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+} // namespace hash_detail
+
+/**
+ * @brief Hashes text sixteen bytes per 64x64->128-bit multiply (the wyhash construction).
+ * @param text Any bytes, e.g. a normalized expression, a word or a snapshot payload.
+ * @return A 64-bit hash; equal texts always hash equally.
+ */
+inline std::uint64_t hashText(std::string_view text) {
+    using namespace hash_detail;
+    const char* p = text.data();
+    const std::size_t length = text.size();
+    std::uint64_t hash = mix(length ^ HashMultiplier0, HashMultiplier1);
+
+    // Whole 16-byte blocks, then the last 1-16 bytes read with fixed-size (possibly overlapping) loads
+    std::uint64_t a = 0, b = 0;
+    if (length > 16) {
+        std::size_t remaining = length;
+        while (remaining > 16) {
+            hash = mix(load64(p) ^ HashMultiplier0, load64(p + 8) ^ hash);
+            p += 16;
+            remaining -= 16;
+        }
+        a = load64(text.data() + length - 16);
+        b = load64(text.data() + length - 8);
+    } else if (length >= 8) {
+        a = load64(p);
+        b = load64(p + length - 8);
+    } else if (length >= 4) {
+        a = load32(p);
+        b = load32(p + length - 4);
+    } else if (length > 0) {
+        a = (static_cast<std::uint64_t>(static_cast<unsigned char>(p[0])) << 16) |
+            (static_cast<std::uint64_t>(static_cast<unsigned char>(p[length / 2])) << 8) |
+            static_cast<unsigned char>(p[length - 1]);
+    }
+    hash = mix(a ^ HashMultiplier0, b ^ hash ^ HashMultiplier1);
+    return mix(hash ^ length, HashMultiplier1);
+}
+
+#endif // HASH_H
@@ -0,0 +1,252 @@
+//##################################################
+// File: IncrementalWordCount.cpp
+// Description: Snapshot format, append-only updates with file identity checks, and the polling follow loop.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "IncrementalWordCount.h"
+#include "Hash.h"
+#include "MappedFile.h"
+#include "WordTokenizer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+#include <thread>
+
+namespace {
+
+const char SnapshotMagic[8] = { 'R', 'P', 'N', 'W', 'O', 'R', 'D', 'S' };
+const std::uint64_t SnapshotVersion = 1;
+const std::size_t FingerprintBytes = 4096;
+
+/**
+ * @brief Fixed-size start of a snapshot file.
+ * @note The header is followed by the words' counts (8 bytes each), their stored hashes and their
+ *       lengths (4 bytes each), then their text back to back, all in the table's slot order and in
+ *       host byte order. A snapshot is a cache on the same machine, not an interchange format.
+ */
+struct SnapshotHeader {
+    char magic[8];
+    std::uint64_t version;
+    std::uint64_t device;
+    std::uint64_t inode;
+    std::uint64_t fingerprintLength;
+    std::uint64_t fingerprint;
+    std::uint64_t offset;       ///< Bytes of the file the counts cover.
+    std::uint64_t totalWords;
+    std::uint64_t distinctWords;
+    std::uint64_t textBytes;
+    std::uint64_t payloadHash;  ///< hashText of everything after the header.
+};
+
+std::uint64_t fingerprintOf(const char* data, std::size_t length) {
+    return hashText(std::string_view(data, length));
+}
+
+} // namespace
+
+/**
+ * @brief Loads counts saved by `saveSnapshot`.
+ * @param path The snapshot file.
+ * @return False (leaving the counts untouched) if the file is missing, truncated, from another
+ *         version or fails its checksum.
+ */
+bool IncrementalWordCount::loadSnapshot(const std::string& path) {
+    MappedFile file;
+    if (!file.open(path.c_str()) || file.size() < sizeof(SnapshotHeader)) return false;
+    SnapshotHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, SnapshotMagic, sizeof(SnapshotMagic)) != 0 || header.version != SnapshotVersion) return false;
+
+    const std::uint64_t n = header.distinctWords;
+    const std::uint64_t payload = file.size() - sizeof(SnapshotHeader);
+    if (n > payload / 16 || n * 16 + header.textBytes != payload) return false;
+    const char* body = file.data() + sizeof(SnapshotHeader);
+    if (hashText(std::string_view(body, payload)) != header.payloadHash) return false;
+
+    const char* countBytes = body;
+    const char* hashBytes = countBytes + n * 8;
+    const char* lengthBytes = hashBytes + n * 4;
+    const char* text = lengthBytes + n * 4;
+
+    clear();
+    table.reserve(n);
+    std::uint64_t position = 0;
+    for (std::uint64_t i = 0; i < n; ++i) {
+        std::uint64_t count;
+        std::uint32_t hash, length;
+        std::memcpy(&count, countBytes + i * 8, 8);
+        std::memcpy(&hash, hashBytes + i * 4, 4);
+        std::memcpy(&length, lengthBytes + i * 4, 4);
+        if (length > header.textBytes - position) {
+            clear();
+            return false;
+        }
+        table.addHashed(std::string_view(text + position, length), hash, count);
+        position += length;
+    }
+    identity = CountedFileIdentity{ header.device, header.inode, header.fingerprintLength, header.fingerprint };
+    offset = seenBytes = header.offset;
+    words = header.totalWords;
+    return true;
+}
+
+/**
+ * @brief Saves the counts, the offset and the file identity.
+ * @param path The snapshot file; replaced only once the new one is completely written.
+ * @return False if the snapshot could not be written.
+ * @note The pending word is not saved: its bytes lie past the saved offset and are read again.
+ */
+bool IncrementalWordCount::saveSnapshot(const std::string& path) const {
+    const std::size_t n = table.size();
+    std::vector<std::uint64_t> counts;
+    std::vector<std::uint32_t> hashes, lengths;
+    std::string text;
+    counts.reserve(n);
+    hashes.reserve(n);
+    lengths.reserve(n);
+    table.forEach([&](std::string_view word, std::uint32_t hash, std::uint64_t count) {
+        counts.push_back(count);
+        hashes.push_back(hash);
+        lengths.push_back(static_cast<std::uint32_t>(word.size()));
+        text.append(word);
+    });
+
+    std::string body;
+    body.reserve(n * 16 + text.size());
+    body.append(reinterpret_cast<const char*>(counts.data()), n * 8);
+    body.append(reinterpret_cast<const char*>(hashes.data()), n * 4);
+    body.append(reinterpret_cast<const char*>(lengths.data()), n * 4);
+    body.append(text);
+
+    SnapshotHeader header;
+    std::memcpy(header.magic, SnapshotMagic, sizeof(SnapshotMagic));
+    header.version = SnapshotVersion;
+    header.device = identity.device;
+    header.inode = identity.inode;
+    header.fingerprintLength = identity.fingerprintLength;
+    header.fingerprint = identity.fingerprint;
+    header.offset = offset;
+    header.totalWords = words;
+    header.distinctWords = n;
+    header.textBytes = text.size();
+    header.payloadHash = hashText(body);
+
+    const std::string temporary = path + ".tmp";
+    std::FILE* out = std::fopen(temporary.c_str(), "wb");
+    if (!out) return false;
+    bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1 &&
+              std::fwrite(body.data(), 1, body.size(), out) == body.size();
+    ok = std::fclose(out) == 0 && ok;
+    if (!ok || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Counts the bytes appended to a file since the last update (or loaded snapshot).
+ * @param fileName The file; only its new bytes are read.
+ * @return False if the file cannot be opened.
+ * @note If the file is not the one counted so far (other device or inode, shorter than the offset,
+ *       or different first bytes), the counts are cleared and the whole file is counted;
+ *       `restarted` reports it.
+ */
+bool IncrementalWordCount::update(const std::string& fileName) {
+    MappedFile file;
+    if (!file.open(fileName.c_str())) return false;
+    const char* data = file.data();
+    const std::size_t size = file.size();
+
+    recounted = false;
+    bool known = identity.device != 0 || identity.inode != 0;
+    if (known) {
+        bool same = identity.device == file.device() && identity.inode == file.inode() && size >= offset &&
+                    size >= identity.fingerprintLength &&
+                    fingerprintOf(data, identity.fingerprintLength) == identity.fingerprint;
+        if (!same) {
+            clear();
+            recounted = true;
+        }
+    }
+
+    // Count up to the last separator; a trailing run of word bytes may still be growing
+    std::size_t end = size;
+    while (end > offset && isWordByte(data[end - 1])) end--;
+    if (end > offset) {
+        tokenizeWords(std::string_view(data + offset, end - offset), [this](std::string_view word) {
+            table.add(word);
+            words++;
+        });
+        file.release(offset, end);
+    }
+    offset = end;
+    pending.assign(data + end, size - end);
+    for (char& c : pending) c = static_cast<char>(c | 0x20); // Only letters and digits; digits already have the bit
+
+    std::size_t fingerprintLength = offset < FingerprintBytes ? offset : FingerprintBytes;
+    identity = CountedFileIdentity{ file.device(), file.inode(), fingerprintLength, fingerprintOf(data, fingerprintLength) };
+    seenBytes = size;
+    return true;
+}
+
+/**
+ * @brief Polls a file and counts what is appended until asked to stop.
+ * @param fileName The file to follow.
+ * @param interval Time between polls.
+ * @param stop Checked between polls (at least every 50 ms); set it to return.
+ * @param onGrowth Called after every update that found the file changed in size or replaced.
+ */
+void IncrementalWordCount::follow(const std::string& fileName, std::chrono::milliseconds interval, const std::atomic<bool>& stop,
+                                  const std::function<void()>& onGrowth) {
+    const std::chrono::milliseconds slice(50);
+    while (!stop.load(std::memory_order_relaxed)) {
+        std::uint64_t before = seenBytes;
+        if (update(fileName) && (seenBytes != before || recounted) && onGrowth) onGrowth();
+        for (std::chrono::milliseconds waited(0); waited < interval && !stop.load(std::memory_order_relaxed); waited += slice) {
+            std::this_thread::sleep_for(std::min(slice, interval - waited));
+        }
+    }
+}
+
+/**
+ * @brief Forgets every count, the offset and the file identity.
+ */
+void IncrementalWordCount::clear() {
+    table.clear();
+    identity = CountedFileIdentity();
+    offset = seenBytes = words = 0;
+    pending.clear();
+}
+
+/**
+ * @brief Lists every word with its count, including the pending word at the end of the file.
+ * @return The entries in word order; the pending word's view is valid until the next update.
+ */
+std::vector<WordFrequency> IncrementalWordCount::sorted() const {
+    std::vector<WordFrequency> entries = table.sorted();
+    if (!pending.empty()) {
+        std::string_view word(pending);
+        auto at = std::lower_bound(entries.begin(), entries.end(), word,
+                                   [](const WordFrequency& entry, std::string_view key) { return entry.word < key; });
+        if (at != entries.end() && at->word == word) at->count++;
+        else entries.insert(at, WordFrequency{ word, 1 });
+    }
+    return entries;
+}
+
+/**
+ * @brief Writes one "word - count" line per word, in word order.
+ * @param out The stream to write to.
+ */
+void IncrementalWordCount::print(std::ostream& out) const {
+    for (const WordFrequency& entry : sorted()) {
+        out << entry.word << " - " << entry.count << '\n';
+    }
+    out.flush();
+}
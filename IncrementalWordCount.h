@@ -0,0 +1,74 @@
+//##################################################
+// File: IncrementalWordCount.h
+// Description: Word counts for append-only files, resumed from binary snapshots and updated as the file grows.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef INCREMENTALWORDCOUNT_H
+#define INCREMENTALWORDCOUNT_H
+
+#include "FrozenWordIndex.h"
+#include "WordTable.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Identifies the file a count belongs to, so a replaced or rewritten file is recounted.
+ */
+struct CountedFileIdentity {
+    std::uint64_t device = 0;
+    std::uint64_t inode = 0;
+    std::uint64_t fingerprintLength = 0; ///< Leading bytes covered by `fingerprint`.
+    std::uint64_t fingerprint = 0;       ///< Hash of the first `fingerprintLength` bytes.
+};
+
+/**
+ * @brief Counts the words of a file that only grows, reading each byte once across runs.
+ * @note `update` tokenizes only the bytes after `processedBytes`, and it stops at the last byte
+ *       that cannot belong to a word. A word still being written at the end of the file is kept
+ *       aside as pending. It appears in `sorted` and `print`, but it is counted for good only once
+ *       a separator follows it. The counts and the offset can be saved to a snapshot and loaded by
+ *       a later run. A snapshot is the table's words, hashes and counts stored as flat arrays, so
+ *       loading is one read plus one probe per distinct word, with no tokenizing. Before continuing,
+ *       `update` checks the device, the inode and a hash of the first bytes. A rotated, truncated
+ *       or rewritten file is counted again from the start.
+ */
+class IncrementalWordCount {
+public:
+    bool loadSnapshot(const std::string& path);       ///< Replaces the counts with a snapshot's; false if it is missing or invalid.
+    bool saveSnapshot(const std::string& path) const; ///< Writes the counts atomically (temporary file, then rename).
+    bool update(const std::string& fileName);         ///< Counts the bytes appended since the last update; false if the file cannot be read.
+    void follow(const std::string& fileName, std::chrono::milliseconds interval, const std::atomic<bool>& stop,
+                const std::function<void()>& onGrowth); ///< Updates whenever the file grows until `stop` is set.
+    void clear();                                     ///< Forgets every count and the offset.
+
+    std::vector<WordFrequency> sorted() const;        ///< Every word with its count (pending word included), in word order.
+    void print(std::ostream& out) const;              ///< Writes "word - count" lines in word order.
+    FrozenWordIndex freeze() const { return FrozenWordIndex(sorted()); } ///< Copies the counts into a read-only index.
+
+    std::uint64_t processedBytes() const { return offset; }  ///< Bytes counted for good.
+    std::uint64_t fileBytes() const { return seenBytes; }    ///< File size at the last update.
+    std::uint64_t totalWords() const { return words; }       ///< Words counted for good.
+    std::size_t distinctWords() const { return table.size(); } ///< Distinct words counted for good.
+    bool restarted() const { return recounted; }             ///< The last update found a different file and started over.
+
+private:
+    WordTable table;
+    CountedFileIdentity identity;
+    std::uint64_t offset = 0;
+    std::uint64_t seenBytes = 0;
+    std::uint64_t words = 0;
+    std::string pending;      ///< Lowercased word at the end of the file with no separator after it yet.
+    bool recounted = false;
+};
+
+#endif // INCREMENTALWORDCOUNT_H
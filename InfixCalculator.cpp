@@ -7,34 +7,189 @@
 
 
 #include "InfixCalculator.h"
+#include "ExpressionCache.h"
+#include "Instrumentation.h"
+#include "NumberParser.h"
+#include "OperandStack.h"
+
+#include <cmath>
+
+namespace {
+
+// Deepest nesting of parentheses, signs and right-associative '^' accepted before giving up (error 1).
+const int MaxNesting = 2000;
+
+inline void skipSpaces(const char*& ptr, const char* end) {
+    while (ptr < end && *ptr == ' ') ptr++;
+}
+
+inline bool startsOperand(char c) {
+    return (c >= '0' && c <= '9') || c == '.' || c == '(' || isIdentifierStart(c);
+}
+
+/**
+ * @brief Parser output that computes the value directly instead of emitting instructions.
+ * @tparam Operands `Stack<double, 32>`, or a caller's `EvaluationScratch` for the reentrant overload.
+ * @note Mirrors the ProgramBuilder interface so the same parser serves both. Errors that `run` would
+ *       report (unbound variables, division by a computed zero) are held back until the whole text has
+ *       parsed, so a syntax error later in the expression still wins, exactly as with compile + run.
+ *       A full scratch stack stops the parse with error 6.
+ */
+template <typename Operands>
+class ValueEvaluator {
+public:
+    explicit ValueEvaluator(Operands& operands) : stack(operands), errorCode(0), pendingError(0), topIsLiteral(false) {
+        stack.clear();
+    }
+
+    void pushConstant(double value) {
+        if (!pushOperand(stack, value)) fail(EvaluationScratch::StackExhausted);
+        topIsLiteral = true;
+    }
+
+    void pushVariable(const char*, std::size_t) {
+        pendingError = 1; // Unbound variable; takes priority over division by zero, as in run()
+        if (!pushOperand(stack, 0.0)) fail(EvaluationScratch::StackExhausted);
+        topIsLiteral = false;
+    }
+
+    bool applyOperator(OpCode op) {
+        double operand2 = stack.top();
+        stack.pop_back();
+        double& operand1 = stack.top();
+
+        switch (op) {
+        case OpCode::Add: operand1 += operand2; break;
+        case OpCode::Sub: operand1 -= operand2; break;
+        case OpCode::Mul: operand1 *= operand2; break;
+        case OpCode::Div:
+            if (operand2 == 0) {
+                if (topIsLiteral) {
+                    fail(3); // Division by a literal zero is a compile error
+                    return false;
+                }
+                if (pendingError == 0) pendingError = 3;
+            }
+            operand1 /= operand2;
+            break;
+        default: operand1 = std::pow(operand1, operand2); break;
+        }
+        topIsLiteral = false;
+        return true;
+    }
+
+    bool applyNegate() {
+        stack.top() = -stack.top();
+        return true;
+    }
+
+    bool applyFunction(Function function) {
+        if (functionArity(function) == 1) {
+            stack.top() = callFunction(function, stack.top(), 0.0);
+        } else {
+            double b = stack.top();
+            stack.pop_back();
+            stack.top() = callFunction(function, stack.top(), b);
+        }
+        topIsLiteral = false;
+        return true;
+    }
+
+    void fail(int code) { errorCode = code; }
+    bool failed() const { return errorCode != 0; }
+
+    /**
+     * @brief Returns the value of a fully parsed expression, or 0 with `code` set on error.
+     */
+    double finish(int& code) {
+        code = errorCode != 0 ? errorCode : pendingError;
+        return code == 0 ? stack.top() : 0.0;
+    }
+
+private:
+    Operands& stack;
+    int errorCode;      ///< Parse error; stops the parse.
+    int pendingError;   ///< Evaluation error reported only if the parse succeeds.
+    bool topIsLiteral;  ///< True while the top value is a (possibly negated) numeric literal.
+};
+
+} // namespace
+
+/**
+ * @brief State shared by the recursive parse functions.
+ * @tparam Sink ProgramBuilder to compile, ValueEvaluator to evaluate while parsing.
+ */
+template <typename Sink>
+struct InfixCalculator::ParseState {
+    const char* ptr;  ///< Next unread character.
+    const char* end;  ///< End of the expression.
+    Sink& builder;    ///< Receives the operands and operators.
+    int nesting;      ///< Current recursion depth.
+};
 
 InfixCalculator::InfixCalculator() {}
 
 /**
- * @brief Evaluates an infix expression by converting it to postfix and evaluating the postfix.
+ * @brief Evaluates an infix expression.
  * @param expression The infix expression to evaluate.
  * @param errorCode Error code for evaluation (0 for success).
  * @return The result of the evaluated expression.
- * @note Uses `infixToPostfix` to convert the infix expression, then calls `RPNCalculator::evaluate`.
+ * @note Computes the value while parsing, so the text is read once and nothing is buffered; the
+ *       result and error code match `compileInfix` followed by `run`. With a cache set, a hit returns
+ *       the stored result and a miss compiles, runs and stores the expression.
  */
 double InfixCalculator::evaluateInfix(const char* expression, int& errorCode) {
-    char postfix[256];
-    infixToPostfix(expression, postfix, errorCode);
+    RPN_EVALUATION_SCOPE(errorCode);
+    std::string_view infix(expression);
+    ExpressionCache* cache = getCache();
+    if (cache != nullptr) {
+        double value = 0.0;
+        if (cache->findValue(infix, Notation::Infix, value, errorCode)) return value;
 
-    if (errorCode != 0) return 0.0; // Return on conversion error
+        Program program;
+        compileInfix(infix, program);
+        value = run(program, errorCode);
+        cache->insert(infix, Notation::Infix, program, value, errorCode);
+        return value;
+    }
+
+    RPN_TIME_PHASE(Phase::Execute);
+    Stack<double, 32> stack;
+    ValueEvaluator<Stack<double, 32>> evaluator(stack);
+    ParseState<ValueEvaluator<Stack<double, 32>>> state = { infix.data(), infix.data() + infix.size(), evaluator, 0 };
 
-    // Use the postfix expression with RPNCalculator's evaluate function
-    return RPNCalculator::evaluate(postfix, errorCode);
+    if (parseExpression(state, 0)) {
+        skipSpaces(state.ptr, state.end);
+        if (state.ptr != state.end) {
+            evaluator.fail(startsOperand(*state.ptr) ? 2 : 1); // Too many operands / unexpected character
+        }
+    }
+    return evaluator.finish(errorCode);
 }
 
 /**
- * @brief Checks if a character is an operator.
- * @param c The character to check.
- * @return True if the character is an operator, false otherwise.
- * @note Used in infix-to-postfix conversion for precedence handling.
+ * @brief Evaluates an infix expression without touching the calculator's state.
+ * @param expression The infix expression; it does not need to be null-terminated.
+ * @param scratch Caller-owned operand stack; one per thread.
+ * @return The value and error code: 1-3 as for the other overload, or 6 if the expression needs
+ *         more operands than `scratch` holds.
+ * @note Reentrant and allocation-free. The cache is not consulted, because filling it allocates.
  */
-bool InfixCalculator::isOperator(char c) {
-    return c == '+' || c == '-' || c == '*' || c == '/' || c == '^';
+EvaluationResult InfixCalculator::evaluateInfix(std::string_view expression, EvaluationScratch& scratch) const {
+    EvaluationResult result;
+    RPN_EVALUATION_SCOPE(result.errorCode);
+    RPN_TIME_PHASE(Phase::Execute);
+    ValueEvaluator<EvaluationScratch> evaluator(scratch);
+    ParseState<ValueEvaluator<EvaluationScratch>> state = { expression.data(), expression.data() + expression.size(), evaluator, 0 };
+
+    if (parseExpression(state, 0)) {
+        skipSpaces(state.ptr, state.end);
+        if (state.ptr != state.end) {
+            evaluator.fail(startsOperand(*state.ptr) ? 2 : 1); // Too many operands / unexpected character
+        }
+    }
+    result.value = evaluator.finish(result.errorCode);
+    return result;
 }
 
 /**
@@ -43,7 +198,7 @@ bool InfixCalculator::isOperator(char c) {
  * @return The precedence level (higher number means higher precedence).
  * @note Based on typical operator precedence: ^ > * / > + -
  */
-int InfixCalculator::precedence(char op) {
+int InfixCalculator::precedence(char op) const {
     if (op == '^') return 3;
     if (op == '*' || op == '/') return 2;
     if (op == '+' || op == '-') return 1;
@@ -56,82 +211,196 @@ int InfixCalculator::precedence(char op) {
  * @return True if the operator is left-associative, false otherwise.
  * @note All operators except '^' (exponentiation) are left-associative.
  */
-bool InfixCalculator::isLeftAssociative(char op) {
+bool InfixCalculator::isLeftAssociative(char op) const {
     return op != '^';
 }
 
 /**
- * @brief Converts an infix expression to a postfix expression.
+ * @brief Compiles an infix expression into a reusable Program.
+ * @param expression The infix expression to compile.
+ * @return The compiled Program; its `errorCode` is non-zero if the expression can never evaluate.
+ */
+Program InfixCalculator::compileInfix(const char* expression) {
+    Program program;
+    compileInfix(expression, program);
+    return program;
+}
+
+/**
+ * @brief Compiles an infix expression into an existing Program.
  * @param infix The input infix expression as a C-string.
- * @param postfix The output postfix expression as a C-string.
- * @param errorCode Error code (0 for success).
- * @note Uses the stack to manage operators and apply precedence/associativity rules.
+ * @param program Receives the instructions; its storage is reused.
  */
-void InfixCalculator::infixToPostfix(const char* infix, char* postfix, int& errorCode) {
-    Stack<char> opStack;
-    int postfixIndex = 0;
-    errorCode = 0;
-
-    const char* ptr = infix;
-    while (*ptr != '\0') {
-        // Skip whitespace
-        if (*ptr == ' ') {
-            ptr++;
-            continue;
-        }
+void InfixCalculator::compileInfix(const char* infix, Program& program) {
+    compileInfix(std::string_view(infix), program);
+}
 
-        // Operand: Directly add to postfix expression
-        if ((*ptr >= '0' && *ptr <= '9') || *ptr == '.') {
-            postfix[postfixIndex++] = *ptr;
-        }
-        // Left parenthesis: Push onto the stack
-        else if (*ptr == '(') {
-            opStack.push(*ptr);
+/**
+ * @brief Compiles an infix expression held in a string view.
+ * @param infix The infix expression; it does not need to be null-terminated and may be any length.
+ * @param program Receives the instructions; its storage is reused.
+ * @note Single-pass precedence-climbing (Pratt) parser that emits postfix instructions as it goes.
+ *       Supports unary minus, right-associative '^', and calls such as max(a, b).
+ *        1 - Malformed expression
+ *        2 - An operand follows a complete expression (e.g. "3 4")
+ *        3 - Division by a literal zero
+ */
+void InfixCalculator::compileInfix(std::string_view infix, Program& program) {
+    RPN_TIME_PHASE(Phase::Convert);
+    RPN_COUNT_GROWTH(program.code);
+    RPN_COUNT_GROWTH(program.constants);
+    RPN_COUNT_GROWTH(program.variables);
+    ProgramBuilder builder(program);
+    ParseState<ProgramBuilder> state = { infix.data(), infix.data() + infix.size(), builder, 0 };
+
+    if (!parseExpression(state, 0)) return;
+
+    skipSpaces(state.ptr, state.end);
+    if (state.ptr != state.end) {
+        builder.fail(startsOperand(*state.ptr) ? 2 : 1); // Too many operands / unexpected character
+        return;
+    }
+    builder.finish();
+}
+
+/**
+ * @brief Parses an operand followed by any binary operators with precedence of at least `minPrecedence`.
+ * @param state The parse state.
+ * @param minPrecedence Operators below this precedence are left for the caller.
+ * @return False once an error has been recorded.
+ */
+template <typename Sink>
+bool InfixCalculator::parseExpression(ParseState<Sink>& state, int minPrecedence) const {
+    if (++state.nesting > MaxNesting) {
+        state.builder.fail(1); // Nested too deeply
+        return false;
+    }
+    if (!parseOperand(state)) return false;
+
+    while (true) {
+        skipSpaces(state.ptr, state.end);
+        if (state.ptr == state.end) break;
+
+        char op = *state.ptr;
+        int opPrecedence = precedence(op); // 0 for anything that is not an operator
+        if (opPrecedence == 0 || opPrecedence < minPrecedence) break;
+        state.ptr++;
+        RPN_COUNT(Counter::Tokens, 1);
+
+        // Left-associative operators stop the right operand at their own precedence
+        int nextMin = isLeftAssociative(op) ? opPrecedence + 1 : opPrecedence;
+        if (!parseExpression(state, nextMin)) return false;
+
+        OpCode code = OpCode::Add;
+        operatorToOpCode(op, code);
+        if (!state.builder.applyOperator(code)) return false;
+    }
+
+    state.nesting--;
+    return true;
+}
+
+/**
+ * @brief Parses one operand: a number, a variable, a function call, a parenthesized expression,
+ *        or a signed operand.
+ * @param state The parse state.
+ * @return False once an error has been recorded.
+ * @note A sign binds looser than '^', so -2^2 is -(2^2).
+ */
+template <typename Sink>
+bool InfixCalculator::parseOperand(ParseState<Sink>& state) const {
+    skipSpaces(state.ptr, state.end);
+    if (state.ptr == state.end) {
+        state.builder.fail(1); // Missing operand
+        return false;
+    }
+    RPN_COUNT(Counter::Tokens, 1);
+
+    const char c = *state.ptr;
+    if ((c >= '0' && c <= '9') || c == '.') {
+        double num = 0.0;
+        state.ptr = parseNumber(state.ptr, state.end, num);
+        if (state.ptr == nullptr) {
+            state.builder.fail(1); // Malformed number
+            return false;
         }
-        // Right parenthesis: Pop until left parenthesis
-        else if (*ptr == ')') {
-            while (!opStack.isEmpty() && opStack.peek() != '(') {
-                postfix[postfixIndex++] = ' ';
-                postfix[postfixIndex++] = opStack.peek();
-                opStack.pop();
-            }
-            if (opStack.isEmpty() || opStack.peek() != '(') {
-                errorCode = 1; // Mismatched parentheses
-                return;
+        state.builder.pushConstant(num);
+        return !state.builder.failed();
+    }
+
+    if (isIdentifierStart(c)) {
+        const char* start = state.ptr;
+        while (state.ptr < state.end && isIdentifierChar(*state.ptr)) state.ptr++;
+        std::size_t length = static_cast<std::size_t>(state.ptr - start);
+
+        skipSpaces(state.ptr, state.end);
+        if (state.ptr < state.end && *state.ptr == '(') {
+            Function function;
+            if (!lookupFunction(start, length, function)) {
+                state.builder.fail(1); // Unknown function
+                return false;
             }
-            opStack.pop(); // Discard the '('
+            state.ptr++;
+            return parseCall(state, function);
         }
-        // Operator: Process according to precedence and associativity
-        else if (isOperator(*ptr)) {
-            postfix[postfixIndex++] = ' '; // Space to separate tokens
-            while (!opStack.isEmpty() && isOperator(opStack.peek())) {
-                char topOp = opStack.peek();
-                if ((isLeftAssociative(*ptr) && precedence(*ptr) <= precedence(topOp)) ||
-                    (!isLeftAssociative(*ptr) && precedence(*ptr) < precedence(topOp))) {
-                    postfix[postfixIndex++] = opStack.peek();
-                    opStack.pop();
-                    postfix[postfixIndex++] = ' ';
-                } else {
-                    break;
-                }
-            }
-            opStack.push(*ptr);
-        } else {
-            errorCode = 1; // Invalid character
-            return;
+        state.builder.pushVariable(start, length);
+        return !state.builder.failed();
+    }
+
+    if (c == '(') {
+        state.ptr++;
+        if (!parseExpression(state, 0)) return false;
+        skipSpaces(state.ptr, state.end);
+        if (state.ptr == state.end || *state.ptr != ')') {
+            state.builder.fail(1); // Mismatched parentheses
+            return false;
         }
-        ptr++;
+        state.ptr++;
+        RPN_COUNT(Counter::Tokens, 1);
+        return true;
     }
 
-    // Pop remaining operators
-    while (!opStack.isEmpty()) {
-        postfix[postfixIndex++] = ' ';
-        if (opStack.peek() == '(') {
-            errorCode = 1; // Mismatched parentheses
-            return;
+    if (c == '-' || c == '+') {
+        state.ptr++;
+        if (!parseExpression(state, precedence('^'))) return false;
+        return c == '+' || state.builder.applyNegate();
+    }
+
+    state.builder.fail(1); // Invalid character
+    return false;
+}
+
+/**
+ * @brief Parses the comma-separated arguments of a call whose '(' has been consumed, then emits the call.
+ * @param state The parse state.
+ * @param function The function being called.
+ * @return False once an error has been recorded (including a wrong number of arguments).
+ */
+template <typename Sink>
+bool InfixCalculator::parseCall(ParseState<Sink>& state, Function function) const {
+    int arguments = 0;
+    while (true) {
+        if (!parseExpression(state, 0)) return false;
+        arguments++;
+
+        skipSpaces(state.ptr, state.end);
+        if (state.ptr < state.end && *state.ptr == ',') {
+            state.ptr++;
+            RPN_COUNT(Counter::Tokens, 1);
+            continue;
+        }
+        if (state.ptr == state.end || *state.ptr != ')') {
+            state.builder.fail(1); // Unterminated argument list
+            return false;
         }
-        postfix[postfixIndex++] = opStack.peek();
-        opStack.pop();
+        state.ptr++;
+        RPN_COUNT(Counter::Tokens, 1);
+        break;
+    }
+
+    if (arguments != functionArity(function)) {
+        state.builder.fail(1); // Wrong number of arguments
+        return false;
     }
-    postfix[postfixIndex] = '\0'; // Null-terminate the postfix expression
+    return state.builder.applyFunction(function);
 }
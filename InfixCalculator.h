@@ -1,6 +1,6 @@
 //##################################################
 // File: InfixCalculator.h
-// Description:An infix notation calculator class that converts infix expressions to postfix and then evaluates them using the RPNCalculator.
+// Description:An infix notation calculator class that parses infix expressions in one pass, straight to a value or into a Program run by the RPNCalculator.
 // Date: Nov,10 2024
 //##################################################
 
@@ -16,13 +16,24 @@ public:
     InfixCalculator(); ///< Constructor for initializing the calculator.
     
     double evaluateInfix(const char* expression, int& errorCode); ///< Evaluates an infix expression.
+    EvaluationResult evaluateInfix(std::string_view expression, EvaluationScratch& scratch) const; ///< Reentrant evaluation with operands in `scratch`; never allocates.
+
+    Program compileInfix(const char* expression); ///< Compiles an infix expression into a reusable Program.
+    void compileInfix(const char* expression, Program& program); ///< Compiles into an existing Program, reusing its storage.
+    void compileInfix(std::string_view expression, Program& program); ///< Compiles an expression held in a string view.
 
 private:
-    bool isOperator(char c); ///< Checks if a character is an operator.
-    int precedence(char op); ///< Returns precedence of an operator.
-    bool isLeftAssociative(char op); ///< Checks if an operator is left-associative.
+    template <typename Sink> struct ParseState; ///< Cursor and output of one parse.
+
+    int precedence(char op) const; ///< Returns precedence of an operator.
+    bool isLeftAssociative(char op) const; ///< Checks if an operator is left-associative.
 
-    void infixToPostfix(const char* infix, char* postfix, int& errorCode); ///< Converts infix expression to postfix.
+    template <typename Sink>
+    bool parseExpression(ParseState<Sink>& state, int minPrecedence) const; ///< Parses operators binding at least as tightly as `minPrecedence`.
+    template <typename Sink>
+    bool parseOperand(ParseState<Sink>& state) const; ///< Parses a number, variable, call, parenthesized or signed operand.
+    template <typename Sink>
+    bool parseCall(ParseState<Sink>& state, Function function) const; ///< Parses the argument list of a function call.
 };
 
 #endif // INFIXCALCULATOR_H
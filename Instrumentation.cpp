@@ -0,0 +1,451 @@
+//##################################################
+// File: Instrumentation.cpp
+// Description: Thread-local instrumentation counters, their aggregation and JSON/Prometheus export.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Instrumentation.h"
+
+#include <cstdio>
+
+#ifdef RPN_INSTRUMENTATION
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace instrumentation {
+
+constinit thread_local ThreadState threadState;
+std::atomic<unsigned> sampleInterval{ 64 };
+std::atomic<bool> hardwareRequested{ false };
+
+} // namespace instrumentation
+
+namespace {
+
+using instrumentation::CounterCount;
+using instrumentation::PhaseCount;
+using instrumentation::ThreadCounters;
+
+const int HardwareCount = static_cast<int>(HardwareEvent::Count);
+
+/**
+ * @brief Plain totals, in ticks; used for snapshots, reset baselines and finished threads.
+ */
+struct Totals {
+    std::uint64_t phaseTicks[PhaseCount] = {};
+    std::uint64_t evaluationTicks = 0;
+    std::uint64_t calls = 0;
+    std::uint64_t sampledCalls = 0;
+    std::uint64_t counters[CounterCount] = {};
+    std::uint64_t errors[InstrumentedErrorCodes] = {};
+    std::uint64_t hardware[HardwareCount] = {};
+
+    void add(const Totals& other, bool subtract = false) {
+        auto apply = [subtract](std::uint64_t& to, std::uint64_t from) { to = subtract ? to - from : to + from; };
+        for (int i = 0; i < PhaseCount; ++i) apply(phaseTicks[i], other.phaseTicks[i]);
+        apply(evaluationTicks, other.evaluationTicks);
+        apply(calls, other.calls);
+        apply(sampledCalls, other.sampledCalls);
+        for (int i = 0; i < CounterCount; ++i) apply(counters[i], other.counters[i]);
+        for (int i = 0; i < InstrumentedErrorCodes; ++i) apply(errors[i], other.errors[i]);
+        for (int i = 0; i < HardwareCount; ++i) apply(hardware[i], other.hardware[i]);
+    }
+};
+
+/**
+ * @brief Everything kept for one thread: its counters plus what only this file needs.
+ */
+struct ThreadEntry {
+    ThreadCounters counters;
+    Totals baseline;                                  ///< Values at the last reset; guarded by the registry mutex.
+    int perfFds[HardwareCount] = { -1, -1, -1, -1 };  ///< Group leader first; -1 when not open.
+    bool perfTried = false;                           ///< Owner only: opening was attempted.
+
+    Totals snapshot() const;
+    void closeHardware();
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadEntry*> threads;
+    Totals retired;                   ///< Threads that have exited, net of their reset baselines.
+    std::uint64_t maxStackDepth = 0;  ///< Deepest stack of exited threads.
+    bool hardwareAvailable = false;
+};
+
+Registry& registry() {
+    static Registry* instance = new Registry(); // Never destroyed: threads may exit during static destruction
+    return *instance;
+}
+
+constinit thread_local ThreadEntry* currentEntry = nullptr;
+
+// Reference point for converting ticks to nanoseconds
+const std::chrono::steady_clock::time_point calibrationClock = std::chrono::steady_clock::now();
+const std::uint64_t calibrationTicks = instrumentation::ticks();
+
+double nanosecondsPerTick() {
+#if defined(__x86_64__) || defined(__i386__)
+    auto elapsed = std::chrono::steady_clock::now() - calibrationClock;
+    std::uint64_t ticks = instrumentation::ticks() - calibrationTicks;
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+    return ticks > 0 && ns > 0 ? ns / static_cast<double>(ticks) : 1.0;
+#else
+    return 1.0;
+#endif
+}
+
+#if defined(__linux__)
+/**
+ * @brief Opens one user-space hardware counter for the calling thread; the group starts disabled.
+ */
+int openCounter(std::uint64_t config, int groupFd) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = groupFd == -1 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+}
+#endif
+
+/**
+ * @brief Opens the four counters as one group so they start and stop together.
+ * @return False if the kernel or the hardware refuses (no PMU, perf_event_paranoid, seccomp, ...).
+ */
+bool openHardware(ThreadEntry& entry) {
+#if defined(__linux__)
+    const std::uint64_t configs[HardwareCount] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES
+    };
+    for (int i = 0; i < HardwareCount; ++i) {
+        entry.perfFds[i] = openCounter(configs[i], i == 0 ? -1 : entry.perfFds[0]);
+        if (entry.perfFds[i] < 0) {
+            entry.closeHardware();
+            return false;
+        }
+    }
+    return true;
+#else
+    (void)entry;
+    return false;
+#endif
+}
+
+Totals ThreadEntry::snapshot() const {
+    Totals totals;
+    for (int i = 0; i < PhaseCount; ++i) totals.phaseTicks[i] = counters.phaseTicks[i].load(std::memory_order_relaxed);
+    totals.evaluationTicks = counters.evaluationTicks.load(std::memory_order_relaxed);
+    totals.calls = counters.calls.load(std::memory_order_relaxed);
+    totals.sampledCalls = counters.sampledCalls.load(std::memory_order_relaxed);
+    for (int i = 0; i < CounterCount; ++i) totals.counters[i] = counters.counters[i].load(std::memory_order_relaxed);
+    for (int i = 0; i < InstrumentedErrorCodes; ++i) totals.errors[i] = counters.errors[i].load(std::memory_order_relaxed);
+#if defined(__linux__)
+    // The group can be read from any thread; the layout is { count, value... } for PERF_FORMAT_GROUP
+    if (perfFds[0] >= 0) {
+        std::uint64_t buffer[1 + HardwareCount] = {};
+        if (read(perfFds[0], buffer, sizeof(buffer)) == static_cast<ssize_t>(sizeof(buffer))) {
+            for (int i = 0; i < HardwareCount; ++i) totals.hardware[i] = buffer[1 + i];
+        }
+    }
+#endif
+    return totals;
+}
+
+void ThreadEntry::closeHardware() {
+#if defined(__linux__)
+    for (int& fd : perfFds) {
+        if (fd >= 0) close(fd);
+        fd = -1;
+    }
+#endif
+}
+
+/**
+ * @brief Folds a thread's counters into the retired totals when the thread exits.
+ */
+struct ThreadHandle {
+    ThreadEntry* entry = nullptr;
+
+    ~ThreadHandle() {
+        if (!entry) return;
+        Registry& r = registry();
+        {
+            std::lock_guard<std::mutex> lock(r.mutex);
+            Totals totals = entry->snapshot();
+            totals.add(entry->baseline, true);
+            r.retired.add(totals);
+            std::uint64_t depth = entry->counters.maxStackDepth.load(std::memory_order_relaxed);
+            if (depth > r.maxStackDepth) r.maxStackDepth = depth;
+            for (std::size_t i = 0; i < r.threads.size(); ++i) {
+                if (r.threads[i] == entry) {
+                    r.threads[i] = r.threads.back();
+                    r.threads.pop_back();
+                    break;
+                }
+            }
+        }
+        entry->closeHardware();
+        currentEntry = nullptr;
+        instrumentation::threadState.counters = nullptr;
+        delete entry;
+    }
+};
+
+} // namespace
+
+namespace instrumentation {
+
+/**
+ * @brief Creates and registers the calling thread's counters on its first instrumented call.
+ */
+ThreadCounters& registerThread() {
+    thread_local ThreadHandle handle;
+    ThreadEntry* entry = new ThreadEntry();
+    {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.threads.push_back(entry);
+    }
+    handle.entry = entry;
+    currentEntry = entry;
+    threadState.counters = &entry->counters;
+    return entry->counters;
+}
+
+/**
+ * @brief Starts this thread's hardware counters, opening them on first use.
+ */
+void startHardware() {
+    ThreadEntry* entry = currentEntry;
+    if (!entry) return;
+    if (!entry->perfTried) {
+        entry->perfTried = true;
+        if (openHardware(*entry)) {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.hardwareAvailable = true;
+        }
+    }
+#if defined(__linux__)
+    if (entry->perfFds[0] >= 0) ioctl(entry->perfFds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+/**
+ * @brief Stops this thread's hardware counters.
+ */
+void stopHardware() {
+#if defined(__linux__)
+    ThreadEntry* entry = currentEntry;
+    if (entry && entry->perfFds[0] >= 0) ioctl(entry->perfFds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+} // namespace instrumentation
+
+/**
+ * @brief Sums the counters of every thread, live or exited, since the last reset.
+ * @return The totals, with sampled times and hardware events scaled up to all calls.
+ * @note Live threads keep counting while this runs, so the totals are close to, but not exactly,
+ *       a single instant.
+ */
+EvaluationStats collectEvaluationStats() {
+    Registry& r = registry();
+    Totals totals;
+    EvaluationStats stats;
+    stats.enabled = true;
+    stats.sampleInterval = instrumentation::sampleInterval.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        totals = r.retired;
+        stats.maxStackDepth = r.maxStackDepth;
+        for (const ThreadEntry* entry : r.threads) {
+            Totals current = entry->snapshot();
+            current.add(entry->baseline, true);
+            totals.add(current);
+            std::uint64_t depth = entry->counters.maxStackDepth.load(std::memory_order_relaxed);
+            if (depth > stats.maxStackDepth) stats.maxStackDepth = depth;
+        }
+        stats.hardwareAvailable = r.hardwareAvailable;
+    }
+
+    stats.calls = totals.calls;
+    stats.sampledCalls = totals.sampledCalls;
+    const double extrapolation = totals.sampledCalls ? static_cast<double>(totals.calls) / static_cast<double>(totals.sampledCalls) : 0.0;
+    const double scale = nanosecondsPerTick() * extrapolation;
+    for (int i = 0; i < PhaseCount; ++i) stats.phaseNs[i] = static_cast<std::uint64_t>(static_cast<double>(totals.phaseTicks[i]) * scale);
+    stats.evaluationNs = static_cast<std::uint64_t>(static_cast<double>(totals.evaluationTicks) * scale);
+    for (int i = 0; i < CounterCount; ++i) stats.counters[i] = totals.counters[i];
+    for (int i = 0; i < InstrumentedErrorCodes; ++i) stats.errors[i] = totals.errors[i];
+    for (int i = 0; i < HardwareCount; ++i) stats.hardware[i] = static_cast<std::uint64_t>(static_cast<double>(totals.hardware[i]) * extrapolation);
+    return stats;
+}
+
+/**
+ * @brief Starts every counter from zero again.
+ * @note Live threads are reset by remembering their current values rather than writing to them, so
+ *       the owning threads never race with a reset (only the stack-depth high-water mark is cleared).
+ */
+void resetEvaluationStats() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.retired = Totals();
+    r.maxStackDepth = 0;
+    for (ThreadEntry* entry : r.threads) {
+        entry->baseline = entry->snapshot();
+        entry->counters.maxStackDepth.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Sets how often top-level calls are timed.
+ * @param interval Time one call in `interval` per thread; 1 times every call. Counters stay exact.
+ * @note Each timed call reads the timestamp counter around every token, which costs more than the
+ *       token itself, so the default samples one call in 64.
+ */
+void setInstrumentationSampleInterval(unsigned interval) {
+    instrumentation::sampleInterval.store(interval ? interval : 1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Turns hardware event counting on or off for sampled evaluations.
+ * @param enable True to count cycles, instructions, branch misses and cache misses.
+ * @return False if the counters cannot be opened here (checked on the calling thread).
+ * @note Each sampled evaluation costs two ioctl system calls while this is on.
+ */
+bool enableHardwareCounters(bool enable) {
+    if (!enable) {
+        instrumentation::hardwareRequested.store(false, std::memory_order_relaxed);
+        return true;
+    }
+    ThreadEntry probe;
+    if (!openHardware(probe)) return false;
+    probe.closeHardware();
+    instrumentation::hardwareRequested.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+#else
+
+EvaluationStats collectEvaluationStats() {
+    return EvaluationStats();
+}
+
+void resetEvaluationStats() {}
+
+void setInstrumentationSampleInterval(unsigned) {}
+
+bool enableHardwareCounters(bool) {
+    return false;
+}
+
+#endif // RPN_INSTRUMENTATION
+
+namespace {
+
+const char* const phaseNames[] = { "tokenize", "convert", "parse_number", "execute" };
+const char* const hardwareNames[] = { "cycles", "instructions", "branch_misses", "cache_misses" };
+
+void appendf(std::string& out, const char* format, unsigned long long value, const char* label = "") {
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer), format, label, value);
+    out += buffer;
+}
+
+} // namespace
+
+/**
+ * @brief Formats stats as a single JSON object.
+ * @param stats Totals from `collectEvaluationStats`.
+ * @return The JSON text; hardware events appear only when they were counted.
+ */
+std::string evaluationStatsJson(const EvaluationStats& stats) {
+    std::string out = stats.enabled ? "{\"enabled\":true" : "{\"enabled\":false";
+    appendf(out, "%s,\"sample_interval\":%llu", stats.sampleInterval);
+    appendf(out, "%s,\"calls\":%llu", stats.calls);
+    appendf(out, "%s,\"sampled_calls\":%llu", stats.sampledCalls);
+    appendf(out, "%s,\"evaluations\":%llu", stats.counters[static_cast<int>(Counter::Evaluations)]);
+    appendf(out, "%s,\"evaluation_ns\":%llu", stats.evaluationNs);
+    appendf(out, "%s,\"tokens\":%llu", stats.counters[static_cast<int>(Counter::Tokens)]);
+    appendf(out, "%s,\"allocations\":%llu", stats.counters[static_cast<int>(Counter::Allocations)]);
+    appendf(out, "%s,\"max_stack_depth\":%llu", stats.maxStackDepth);
+    out += ",\"phase_ns\":{";
+    for (int i = 0; i < static_cast<int>(Phase::Count); ++i) {
+        appendf(out, i == 0 ? "\"%s\":%llu" : ",\"%s\":%llu", stats.phaseNs[i], phaseNames[i]);
+    }
+    out += "},\"errors\":{";
+    for (int i = 0; i < InstrumentedErrorCodes; ++i) {
+        char code[8];
+        std::snprintf(code, sizeof(code), "%d", i);
+        appendf(out, i == 0 ? "\"%s\":%llu" : ",\"%s\":%llu", stats.errors[i], code);
+    }
+    out += "}";
+    if (stats.hardwareAvailable) {
+        out += ",\"hardware\":{";
+        for (int i = 0; i < static_cast<int>(HardwareEvent::Count); ++i) {
+            appendf(out, i == 0 ? "\"%s\":%llu" : ",\"%s\":%llu", stats.hardware[i], hardwareNames[i]);
+        }
+        out += "}";
+    }
+    out += "}";
+    return out;
+}
+
+/**
+ * @brief Formats stats in the Prometheus text exposition format.
+ * @param stats Totals from `collectEvaluationStats`.
+ * @return One metric family per counter, labelled by phase, error code or hardware event.
+ */
+std::string evaluationStatsPrometheus(const EvaluationStats& stats) {
+    std::string out;
+    out += "# HELP rpn_calls_total Top-level calculator calls, compiles included.\n# TYPE rpn_calls_total counter\n";
+    appendf(out, "rpn_calls_total%s %llu\n", stats.calls);
+    out += "# HELP rpn_sampled_calls_total Calls whose times were measured.\n# TYPE rpn_sampled_calls_total counter\n";
+    appendf(out, "rpn_sampled_calls_total%s %llu\n", stats.sampledCalls);
+    out += "# HELP rpn_sample_interval Times one top-level call in this many.\n# TYPE rpn_sample_interval gauge\n";
+    appendf(out, "rpn_sample_interval%s %llu\n", stats.sampleInterval);
+    out += "# HELP rpn_evaluations_total Top-level evaluations.\n# TYPE rpn_evaluations_total counter\n";
+    appendf(out, "rpn_evaluations_total%s %llu\n", stats.counters[static_cast<int>(Counter::Evaluations)]);
+    out += "# HELP rpn_evaluation_seconds_total Time inside top-level calculator calls.\n# TYPE rpn_evaluation_seconds_total counter\n";
+    out += "rpn_evaluation_seconds_total " + std::to_string(static_cast<double>(stats.evaluationNs) / 1e9) + "\n";
+    out += "# HELP rpn_phase_seconds_total Exclusive time per evaluation phase.\n# TYPE rpn_phase_seconds_total counter\n";
+    for (int i = 0; i < static_cast<int>(Phase::Count); ++i) {
+        out += std::string("rpn_phase_seconds_total{phase=\"") + phaseNames[i] + "\"} "
+             + std::to_string(static_cast<double>(stats.phaseNs[i]) / 1e9) + "\n";
+    }
+    out += "# HELP rpn_tokens_total Tokens read.\n# TYPE rpn_tokens_total counter\n";
+    appendf(out, "rpn_tokens_total%s %llu\n", stats.counters[static_cast<int>(Counter::Tokens)]);
+    out += "# HELP rpn_allocations_total Heap allocations by operand stacks and Programs.\n# TYPE rpn_allocations_total counter\n";
+    appendf(out, "rpn_allocations_total%s %llu\n", stats.counters[static_cast<int>(Counter::Allocations)]);
+    out += "# HELP rpn_max_stack_depth Deepest operand stack seen.\n# TYPE rpn_max_stack_depth gauge\n";
+    appendf(out, "rpn_max_stack_depth%s %llu\n", stats.maxStackDepth);
+    out += "# HELP rpn_evaluation_errors_total Top-level calls by error code (0 = success).\n# TYPE rpn_evaluation_errors_total counter\n";
+    for (int i = 0; i < InstrumentedErrorCodes; ++i) {
+        char line[96];
+        std::snprintf(line, sizeof(line), "rpn_evaluation_errors_total{code=\"%d\"} %llu\n", i,
+                      static_cast<unsigned long long>(stats.errors[i]));
+        out += line;
+    }
+    if (stats.hardwareAvailable) {
+        out += "# HELP rpn_hardware_events_total Hardware events inside top-level calls.\n# TYPE rpn_hardware_events_total counter\n";
+        for (int i = 0; i < static_cast<int>(HardwareEvent::Count); ++i) {
+            appendf(out, "rpn_hardware_events_total{event=\"%s\"} %llu\n", stats.hardware[i], hardwareNames[i]);
+        }
+    }
+    return out;
+}
@@ -0,0 +1,298 @@
+//##################################################
+// File: Instrumentation.h
+// Description: Opt-in per-phase timers, counters and hardware events for the calculators.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+/**
+ * @brief Where evaluation time is spent. Times are exclusive: a phase nested in another (number
+ *        parsing inside tokenizing, say) is subtracted from the outer one.
+ */
+enum class Phase {
+    Tokenize,     ///< Splitting RPN text into tokens.
+    Convert,      ///< Building a Program: `compile`, `compileInfix`.
+    ParseNumber,  ///< Converting numeric literals.
+    Execute,      ///< Running operators: `run`, uncached `evaluate`, and direct `evaluateInfix` (which also scans its text).
+    Count
+};
+
+/**
+ * @brief Event counters kept per thread.
+ */
+enum class Counter {
+    Evaluations,  ///< Top-level `evaluate`, `evaluateInfix` and `run` calls.
+    Tokens,       ///< Tokens read: RPN tokens, infix operands, operators and parentheses.
+    Allocations,  ///< Heap allocations made by operand stacks and Program storage.
+    Count
+};
+
+/**
+ * @brief Hardware events read through perf_event_open (Linux only).
+ */
+enum class HardwareEvent {
+    Cycles,
+    Instructions,
+    BranchMisses,
+    CacheMisses,
+    Count
+};
+
+const int InstrumentedErrorCodes = 8; ///< Error codes 0..7 are tallied separately.
+
+/**
+ * @brief Totals over every thread, live or finished, since the last reset.
+ * @note Counters are exact. Times and hardware events are measured on one top-level call in
+ *       `sampleInterval` and scaled up by calls / sampled calls.
+ */
+struct EvaluationStats {
+    bool enabled = false;                                         ///< False when built without RPN_INSTRUMENTATION.
+    unsigned sampleInterval = 0;                                  ///< Current sampling interval (1 = every call).
+    std::uint64_t calls = 0;                                      ///< Top-level calculator calls, compiles included.
+    std::uint64_t sampledCalls = 0;                               ///< Calls whose times and hardware events were measured.
+    std::uint64_t phaseNs[static_cast<int>(Phase::Count)] = {};   ///< Estimated exclusive time per phase.
+    std::uint64_t evaluationNs = 0;                               ///< Estimated time inside evaluations, cache lookups included.
+    std::uint64_t counters[static_cast<int>(Counter::Count)] = {};
+    std::uint64_t maxStackDepth = 0;                              ///< Deepest operand stack seen.
+    std::uint64_t errors[InstrumentedErrorCodes] = {};            ///< Evaluations by resulting error code (0 = success).
+    bool hardwareAvailable = false;                               ///< True once any thread opened hardware counters.
+    std::uint64_t hardware[static_cast<int>(HardwareEvent::Count)] = {}; ///< Estimated events inside evaluations.
+};
+
+EvaluationStats collectEvaluationStats();                      ///< Sums the counters of every thread.
+void resetEvaluationStats();                                   ///< Starts every thread's counters from zero.
+void setInstrumentationSampleInterval(unsigned interval);      ///< Times one top-level call in `interval` (1 = all).
+bool enableHardwareCounters(bool enable);                      ///< Turns perf_event_open counting on or off; false if unavailable.
+std::string evaluationStatsJson(const EvaluationStats& stats);       ///< Formats stats as a JSON object.
+std::string evaluationStatsPrometheus(const EvaluationStats& stats); ///< Formats stats in the Prometheus text format.
+
+#ifdef RPN_INSTRUMENTATION
+
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace instrumentation {
+
+const int PhaseCount = static_cast<int>(Phase::Count);
+const int CounterCount = static_cast<int>(Counter::Count);
+
+/**
+ * @brief One thread's totals. Only the owning thread writes them (load + store, no locked
+ *        read-modify-write); collection reads them with relaxed loads from any thread.
+ */
+struct ThreadCounters {
+    std::atomic<std::uint64_t> phaseTicks[PhaseCount] = {};
+    std::atomic<std::uint64_t> evaluationTicks{ 0 };
+    std::atomic<std::uint64_t> calls{ 0 };
+    std::atomic<std::uint64_t> sampledCalls{ 0 };
+    std::atomic<std::uint64_t> counters[CounterCount] = {};
+    std::atomic<std::uint64_t> errors[InstrumentedErrorCodes] = {};
+    std::atomic<std::uint64_t> maxStackDepth{ 0 };
+};
+
+/**
+ * @brief Owner-only state, constant-initialized so that reaching it needs no TLS guard.
+ */
+struct ThreadState {
+    ThreadCounters* counters = nullptr;  ///< Registered on first use.
+    std::uint64_t childTicks = 0;        ///< Ticks of phases nested in the running one.
+    std::uint64_t calls = 0;             ///< Top-level calls so far; drives sampling.
+    int depth = 0;                       ///< Nesting of instrumented scopes.
+    bool sampled = false;                ///< The current top-level call is being timed.
+};
+
+extern constinit thread_local ThreadState threadState;
+extern std::atomic<unsigned> sampleInterval;
+extern std::atomic<bool> hardwareRequested;
+
+ThreadCounters& registerThread();                              ///< Slow path of `counters`.
+void startHardware();                                          ///< Enables this thread's hardware counters.
+void stopHardware();                                           ///< Disables this thread's hardware counters.
+
+inline ThreadCounters& counters() {
+    ThreadCounters* registered = threadState.counters;
+    return registered ? *registered : registerThread();
+}
+
+inline void bump(std::atomic<std::uint64_t>& value, std::uint64_t amount) {
+    value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns a timestamp for short intervals: the TSC on x86, steady_clock elsewhere.
+ */
+inline std::uint64_t ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+/**
+ * @brief Enters an instrumented scope; the outermost one on the thread is a top-level call and
+ *        decides whether the call is timed.
+ * @return True for the outermost scope.
+ */
+inline bool enterScope() {
+    ThreadState& state = threadState;
+    if (state.depth++ > 0) return false;
+    ThreadCounters& totals = counters();
+    bump(totals.calls, 1);
+    state.sampled = state.calls++ % sampleInterval.load(std::memory_order_relaxed) == 0;
+    if (state.sampled) bump(totals.sampledCalls, 1);
+    return true;
+}
+
+inline void addCount(Counter counter, std::uint64_t amount) {
+    bump(counters().counters[static_cast<int>(counter)], amount);
+}
+
+inline void recordStackDepth(std::size_t depth) {
+    std::atomic<std::uint64_t>& deepest = counters().maxStackDepth;
+    if (depth > deepest.load(std::memory_order_relaxed)) deepest.store(depth, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Adds the time until the end of the scope, minus nested phases, to one phase, on sampled calls.
+ */
+class PhaseTimer {
+public:
+    explicit PhaseTimer(Phase phase) : phase(phase) {
+        enterScope();
+        ThreadState& state = threadState;
+        active = state.sampled;
+        if (active) {
+            outerChildTicks = state.childTicks;
+            state.childTicks = 0;
+            start = ticks();
+        }
+    }
+
+    ~PhaseTimer() {
+        ThreadState& state = threadState;
+        state.depth--;
+        if (!active) return;
+        std::uint64_t total = ticks() - start;
+        bump(counters().phaseTicks[static_cast<int>(phase)], total - state.childTicks);
+        state.childTicks = outerChildTicks + total;
+    }
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+    Phase phase;
+    bool active;
+    std::uint64_t start = 0;
+    std::uint64_t outerChildTicks = 0;
+};
+
+/**
+ * @brief Marks an evaluation: counts it and tallies its error code; on sampled calls also times it
+ *        and, when enabled, runs the hardware counters. Nested evaluations (a cache miss compiling
+ *        and running, say) are not counted again.
+ */
+class EvaluationScope {
+public:
+    explicit EvaluationScope(const int& errorCode) : errorCode(errorCode), outermost(enterScope()) {
+        if (outermost && threadState.sampled) {
+            if (hardwareRequested.load(std::memory_order_relaxed)) startHardware();
+            start = ticks();
+        }
+    }
+
+    ~EvaluationScope() {
+        ThreadState& state = threadState;
+        state.depth--;
+        if (!outermost) return;
+        ThreadCounters& totals = counters();
+        if (state.sampled) {
+            bump(totals.evaluationTicks, ticks() - start);
+            if (hardwareRequested.load(std::memory_order_relaxed)) stopHardware();
+        }
+        bump(totals.counters[static_cast<int>(Counter::Evaluations)], 1);
+        int slot = errorCode >= 0 && errorCode < InstrumentedErrorCodes ? errorCode : InstrumentedErrorCodes - 1;
+        bump(totals.errors[slot], 1);
+    }
+
+    EvaluationScope(const EvaluationScope&) = delete;
+    EvaluationScope& operator=(const EvaluationScope&) = delete;
+
+private:
+    const int& errorCode;
+    bool outermost;
+    std::uint64_t start = 0;
+};
+
+/**
+ * @brief Number of allocations a doubling std::vector made to go from one capacity to another.
+ */
+inline std::uint64_t growthAllocations(std::size_t before, std::size_t after) {
+    std::uint64_t count = 0;
+    if (after > before && before == 0) {
+        count++;
+        before = 1;
+    }
+    while (after > before) {
+        before *= 2;
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Counts the reallocations a std::vector makes between construction and the end of the scope.
+ */
+template <typename Container>
+class GrowthCounter {
+public:
+    explicit GrowthCounter(const Container& container) : container(container), before(container.capacity()) {}
+    ~GrowthCounter() {
+        if (container.capacity() != before) addCount(Counter::Allocations, growthAllocations(before, container.capacity()));
+    }
+
+    GrowthCounter(const GrowthCounter&) = delete;
+    GrowthCounter& operator=(const GrowthCounter&) = delete;
+
+private:
+    const Container& container;
+    std::size_t before;
+};
+
+} // namespace instrumentation
+
+#define RPN_INSTRUMENT_CONCAT_(a, b) a##b
+#define RPN_INSTRUMENT_CONCAT(a, b) RPN_INSTRUMENT_CONCAT_(a, b)
+#define RPN_TIME_PHASE(phase) ::instrumentation::PhaseTimer RPN_INSTRUMENT_CONCAT(rpnPhaseTimer, __LINE__)(phase)
+#define RPN_EVALUATION_SCOPE(errorCode) ::instrumentation::EvaluationScope RPN_INSTRUMENT_CONCAT(rpnEvaluationScope, __LINE__)(errorCode)
+#define RPN_COUNT(counter, amount) ::instrumentation::addCount(counter, amount)
+#define RPN_RECORD_STACK_DEPTH(depth) ::instrumentation::recordStackDepth(depth)
+#define RPN_COUNT_GROWTH(container) ::instrumentation::GrowthCounter<std::remove_cvref_t<decltype(container)>> RPN_INSTRUMENT_CONCAT(rpnGrowthCounter, __LINE__)(container)
+
+#else
+
+// Compiled out: every hook disappears, arguments included
+#define RPN_TIME_PHASE(phase) ((void)0)
+#define RPN_EVALUATION_SCOPE(errorCode) ((void)0)
+#define RPN_COUNT(counter, amount) ((void)0)
+#define RPN_RECORD_STACK_DEPTH(depth) ((void)0)
+#define RPN_COUNT_GROWTH(container) ((void)0)
+
+#endif // RPN_INSTRUMENTATION
+
+#endif // INSTRUMENTATION_H
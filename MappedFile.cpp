@@ -0,0 +1,79 @@
+//##################################################
+// File: MappedFile.cpp
+// Description: POSIX mmap/madvise implementation of MappedFile.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile() : bytes(nullptr), length(0) {}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+/**
+ * @brief Maps a file read-only.
+ * @param path The file to map.
+ * @return True on success; an empty file succeeds with a null `data()`.
+ */
+bool MappedFile::open(const char* path) {
+    close();
+
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    length = static_cast<std::size_t>(info.st_size);
+    deviceId = static_cast<unsigned long long>(info.st_dev);
+    inodeId = static_cast<unsigned long long>(info.st_ino);
+    if (length > 0) {
+        void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            length = 0;
+            ::close(fd);
+            return false;
+        }
+        bytes = static_cast<const char*>(mapping);
+    }
+
+    ::close(fd); // The mapping keeps its own reference to the file
+    return true;
+}
+
+void MappedFile::close() {
+    if (bytes) munmap(const_cast<char*>(bytes), length);
+    bytes = nullptr;
+    length = 0;
+}
+
+void MappedFile::adviseSequential() const {
+    if (bytes) madvise(const_cast<char*>(bytes), length, MADV_SEQUENTIAL);
+}
+
+/**
+ * @brief Drops the pages that lie entirely inside [begin, end) from this process's resident set.
+ * @param begin Offset of the first byte that is no longer needed.
+ * @param end Offset one past the last byte that is no longer needed.
+ * @note The pages are clean file pages, so the kernel can simply re-read them if they are touched again.
+ */
+void MappedFile::release(std::size_t begin, std::size_t end) const {
+    if (!bytes || end > length) return;
+
+    const std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    std::size_t first = (begin + pageSize - 1) / pageSize * pageSize;
+    std::size_t last = end / pageSize * pageSize;
+    if (first < last) madvise(const_cast<char*>(bytes) + first, last - first, MADV_DONTNEED);
+}
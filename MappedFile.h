@@ -0,0 +1,40 @@
+//##################################################
+// File: MappedFile.h
+// Description: Read-only memory mapping of a whole file with paging hints for streaming access.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+
+class MappedFile {
+public:
+    MappedFile();  ///< Constructor initializes an unmapped file.
+    ~MappedFile(); ///< Destructor unmaps the file if it is mapped.
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const char* path); ///< Maps the whole file read-only; returns false on failure.
+    void close();                ///< Unmaps the file.
+
+    const char* data() const { return bytes; } ///< First byte of the mapping (null for an empty file).
+    std::size_t size() const { return length; } ///< Size of the file in bytes.
+    unsigned long long device() const { return deviceId; } ///< Device of the mapped file, from fstat.
+    unsigned long long inode() const { return inodeId; }   ///< Inode of the mapped file, from fstat.
+
+    void adviseSequential() const;                       ///< Tells the kernel the mapping will be read front to back.
+    void release(std::size_t begin, std::size_t end) const; ///< Drops resident pages fully inside [begin, end).
+
+private:
+    const char* bytes;
+    std::size_t length;
+    unsigned long long deviceId = 0;
+    unsigned long long inodeId = 0;
+};
+
+#endif // MAPPEDFILE_H
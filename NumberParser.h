@@ -0,0 +1,41 @@
+//##################################################
+// File: NumberParser.h
+// Description: Correctly rounded decimal-to-double parsing for calculator tokens.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef NUMBERPARSER_H
+#define NUMBERPARSER_H
+
+#include <string_view>
+
+/**
+ * @brief Converts a numeric token to the nearest double.
+ * @param text The token; it does not need to be null-terminated and must be consumed entirely.
+ * @param value Receives the converted value on success.
+ * @return True if the token is a number: [+-] digits [. digits] [(e|E) [+-] digits], or a hex float.
+ */
+bool parseDouble(std::string_view text, double& value);
+
+/**
+ * @brief Finds the end of the numeric literal that starts at `begin`.
+ * @param begin First character of the literal (a digit or '.').
+ * @param end End of the input.
+ * @return One past the last character that belongs to the literal, including any exponent.
+ * @note Used by the infix front end, where a literal is followed directly by an operator.
+ */
+const char* scanNumber(const char* begin, const char* end);
+
+/**
+ * @brief Scans and converts the numeric literal that starts at `begin` in one pass.
+ * @param begin First character of the literal (a digit or '.').
+ * @param end End of the input.
+ * @param value Receives the converted value on success.
+ * @return One past the literal, or nullptr if it is malformed (e.g. "1.2.3").
+ * @note Same result as `scanNumber` followed by `parseDouble`; short plain decimals skip the second pass.
+ */
+const char* parseNumber(const char* begin, const char* end, double& value);
+
+#endif // NUMBERPARSER_H
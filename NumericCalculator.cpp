@@ -0,0 +1,475 @@
+//##################################################
+// File: NumericCalculator.cpp
+// Description: Arithmetic for each numeric type, the shared RPN loops and the int64-then-double fallback.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "NumericCalculator.h"
+#include "NumberParser.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+namespace {
+
+const int NotRepresentable = 4;
+
+/**
+ * @brief Converts a literal that `parseDouble` accepted to `T`, rounding it once.
+ * @param token The literal.
+ * @param parsed Its correctly rounded double value.
+ * @note Rounding `parsed` again is wrong only for some literals:
+ *       - For float, only when `parsed` fell exactly halfway between two floats. For example,
+ *         "1.00000005960464477539062500001" would become 1.0f instead of the next float up.
+ *       - For a wider long double, whenever the literal is not a double.
+ *       Whole numbers and short decimals are exact in a 64-bit long double, so one division
+ *       rounds them. Everything else goes through std::from_chars, which reads the text in
+ *       place, does not allocate and ignores the locale.
+ */
+template <typename T>
+T convertLiteral(std::string_view token, double parsed) {
+    const char* first = token.data();
+    const char* last = first + token.size();
+    const bool negative = *first == '-';
+    if (*first == '-' || *first == '+') first++;
+
+    if constexpr (std::numeric_limits<T>::digits < std::numeric_limits<double>::digits) {
+        T rounded = static_cast<T>(parsed);
+        double back = static_cast<double>(rounded);
+        if (back == parsed) return rounded;
+        T other = std::nextafter(rounded, parsed > back ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity());
+        if (parsed - back != static_cast<double>(other) - parsed) return rounded;
+    } else if constexpr (std::numeric_limits<T>::digits == std::numeric_limits<double>::digits) {
+        return static_cast<T>(parsed);
+    } else {
+        std::uint64_t mantissa = 0;
+        int digits = 0;
+        int fraction = 0;
+        bool point = false;
+        const char* p = first;
+        for (; p < last && digits <= 19; ++p) {
+            if (*p >= '0' && *p <= '9') {
+                mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+                digits++;
+                fraction += point ? 1 : 0;
+            } else if (*p == '.' && !point) {
+                point = true;
+            } else {
+                break;
+            }
+        }
+        if (p == last && digits <= 19) {
+            T power = 1;
+            for (int i = 0; i < fraction; ++i) power *= 10;
+            T magnitude = static_cast<T>(mantissa) / power;
+            return negative ? -magnitude : magnitude;
+        }
+    }
+
+    std::chars_format format = std::chars_format::general;
+    if (last - first >= 2 && first[0] == '0' && (first[1] == 'x' || first[1] == 'X')) {
+        first += 2;
+        format = std::chars_format::hex;
+    }
+    T magnitude = 0;
+    std::from_chars_result result = std::from_chars(first, last, magnitude, format);
+    if (result.ec != std::errc() || result.ptr != last) return static_cast<T>(parsed); // Out of T's range
+    return negative ? -magnitude : magnitude;
+}
+
+/**
+ * @brief Literal parsing and arithmetic for float, double and long double.
+ * @note Each operation returns an error code (0, 3 or 4) like the calculators. As in
+ *       RPNCalculator, only division by zero is an error; domain errors give NaN or infinity.
+ */
+template <typename T>
+struct NumericTraits {
+    /**
+     * @brief Converts a literal token.
+     * @param token The token.
+     * @param value Receives the value.
+     * @param exact Set to false if the literal has no exact value in `T` (never for floating types).
+     * @return False if the token is not a number.
+     */
+    static bool parse(std::string_view token, T& value, bool& exact) {
+        double parsed = 0.0;
+        if (!parseDouble(token, parsed)) return false; // Accepts the same grammar for every type
+        if constexpr (std::is_same_v<T, double>) value = parsed;
+        else value = convertLiteral<T>(token, parsed);
+        exact = true;
+        return true;
+    }
+
+    static int negate(T& a) {
+        a = -a;
+        return 0;
+    }
+
+    static int apply(OpCode op, T& a, T b) {
+        switch (op) {
+        case OpCode::Add: a += b; break;
+        case OpCode::Sub: a -= b; break;
+        case OpCode::Mul: a *= b; break;
+        case OpCode::Div:
+            if (b == 0) return 3; // Division by zero
+            a /= b;
+            break;
+        case OpCode::Pow: a = std::pow(a, b); break;
+        default: break;
+        }
+        return 0;
+    }
+
+    static int call(Function function, T& a, T b) {
+        switch (function) {
+        case Function::Sqrt: a = std::sqrt(a); break;
+        case Function::Abs: a = std::fabs(a); break;
+        case Function::Exp: a = std::exp(a); break;
+        case Function::Log: a = std::log(a); break;
+        case Function::Sin: a = std::sin(a); break;
+        case Function::Cos: a = std::cos(a); break;
+        case Function::Tan: a = std::tan(a); break;
+        case Function::Min: a = a < b ? a : b; break;
+        case Function::Max: a = a > b ? a : b; break;
+        case Function::Pow: a = std::pow(a, b); break;
+        }
+        return 0;
+    }
+};
+
+/**
+ * @brief Raises an integer to a non-negative integer power by squaring, checking every product.
+ * @return 0, or 4 if the result does not fit.
+ */
+int integerPower(std::int64_t& a, std::int64_t exponent) {
+    if (exponent < 0) {
+        if (a == 1) return 0;
+        if (a == -1) {
+            a = exponent % 2 == 0 ? 1 : -1;
+            return 0;
+        }
+        return NotRepresentable; // A fraction, or infinity for 0
+    }
+    std::int64_t result = 1;
+    std::int64_t base = a;
+    while (exponent != 0) {
+        if ((exponent & 1) != 0 && __builtin_mul_overflow(result, base, &result)) return NotRepresentable;
+        exponent >>= 1;
+        if (exponent != 0 && __builtin_mul_overflow(base, base, &base)) return NotRepresentable;
+    }
+    a = result;
+    return 0;
+}
+
+/**
+ * @brief Exact arithmetic on int64_t: any result that is not a whole number in range reports error 4.
+ */
+template <>
+struct NumericTraits<std::int64_t> {
+    /**
+     * @brief Converts a literal token.
+     * @note Plain integers are accumulated directly with no floating-point step, so every value in
+     *       range is exact. Other numeric forms ("1e3", "2.0") are accepted when their double
+     *       value is a whole number of at most 2^53, where it cannot have been rounded.
+     */
+    static bool parse(std::string_view token, std::int64_t& value, bool& exact) {
+        std::size_t i = token[0] == '-' || token[0] == '+' ? 1 : 0;
+        bool digits = i < token.size();
+        for (std::size_t j = i; digits && j < token.size(); ++j) digits = token[j] >= '0' && token[j] <= '9';
+        if (digits) {
+            // Accumulate towards the sign so that INT64_MIN parses
+            const bool negative = token[0] == '-';
+            std::int64_t result = 0;
+            exact = true;
+            for (; i < token.size(); ++i) {
+                std::int64_t digit = token[i] - '0';
+                if (__builtin_mul_overflow(result, 10, &result) ||
+                    (negative ? __builtin_sub_overflow(result, digit, &result) : __builtin_add_overflow(result, digit, &result))) {
+                    exact = false;
+                    break;
+                }
+            }
+            value = exact ? result : 0;
+            return true;
+        }
+
+        double parsed = 0.0;
+        if (!parseDouble(token, parsed)) return false;
+        exact = std::trunc(parsed) == parsed && std::fabs(parsed) <= 9007199254740992.0;
+        value = exact ? static_cast<std::int64_t>(parsed) : 0;
+        return true;
+    }
+
+    static int negate(std::int64_t& a) {
+        return __builtin_sub_overflow(std::int64_t(0), a, &a) ? NotRepresentable : 0;
+    }
+
+    static int apply(OpCode op, std::int64_t& a, std::int64_t b) {
+        switch (op) {
+        case OpCode::Add: return __builtin_add_overflow(a, b, &a) ? NotRepresentable : 0;
+        case OpCode::Sub: return __builtin_sub_overflow(a, b, &a) ? NotRepresentable : 0;
+        case OpCode::Mul: return __builtin_mul_overflow(a, b, &a) ? NotRepresentable : 0;
+        case OpCode::Div:
+            if (b == 0) return 3; // Division by zero
+            if (b == -1) return negate(a);
+            if (a % b != 0) return NotRepresentable; // Inexact division
+            a /= b;
+            return 0;
+        case OpCode::Pow: return integerPower(a, b);
+        default: return 0;
+        }
+    }
+
+    /**
+     * @brief Applies a function when its result is a whole number.
+     * @note sqrt is exact for perfect squares; the transcendental functions only for the inputs
+     *       with integer results (exp 0, log 1, sin/cos/tan 0).
+     */
+    static int call(Function function, std::int64_t& a, std::int64_t b) {
+        switch (function) {
+        case Function::Sqrt: {
+            if (a < 0) return NotRepresentable;
+            // Correct the double estimate; unsigned squares cannot overflow for roots below 2^32
+            std::uint64_t n = static_cast<std::uint64_t>(a);
+            std::uint64_t root = static_cast<std::uint64_t>(std::sqrt(static_cast<double>(a)));
+            while (root * root > n) root--;
+            while ((root + 1) * (root + 1) <= n) root++;
+            if (root * root != n) return NotRepresentable;
+            a = static_cast<std::int64_t>(root);
+            return 0;
+        }
+        case Function::Abs: return a < 0 ? negate(a) : 0;
+        case Function::Exp:
+        case Function::Cos:
+            if (a != 0) return NotRepresentable;
+            a = 1;
+            return 0;
+        case Function::Log:
+            if (a != 1) return NotRepresentable;
+            a = 0;
+            return 0;
+        case Function::Sin:
+        case Function::Tan: return a == 0 ? 0 : NotRepresentable;
+        case Function::Min: a = a < b ? a : b; return 0;
+        case Function::Max: a = a > b ? a : b; return 0;
+        case Function::Pow: return integerPower(a, b);
+        }
+        return 0;
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Evaluates an RPN expression in `T`.
+ * @param expression The RPN expression, e.g. "3 2 5 * +".
+ * @param errorCode Error code (0 for success, non-zero for errors).
+ *        1 - Insufficient operands, invalid token or unbound variables
+ *        2 - Too many operands
+ *        3 - Division by zero
+ *        4 - A literal or result not representable in `T`
+ * @return The result of the evaluation, or 0 in case of error.
+ * @note Compiles into a program kept by the calculator and runs it, so the error for any text is
+ *       the one `run(compile(expression))` reports. The program's storage is reused between calls.
+ */
+template <typename T>
+T BasicRPNCalculator<T>::evaluate(std::string_view expression, int& errorCode) {
+    compile(expression, compiled);
+    return run(compiled, errorCode);
+}
+
+/**
+ * @brief Compiles an RPN expression into an existing NumericProgram.
+ * @param expression The RPN expression.
+ * @param compiled Receives the instructions and both forms of every literal; its storage is reused.
+ * @note Uses ProgramBuilder, so compile errors are those of `RPNCalculator::compile`.
+ */
+template <typename T>
+void BasicRPNCalculator<T>::compile(std::string_view expression, NumericProgram<T>& compiled) {
+    ProgramBuilder builder(compiled.program);
+    compiled.constants.clear();
+    compiled.exact = true;
+    std::size_t pos = 0;
+    std::string_view token;
+
+    while (nextToken(expression, pos, token)) {
+        T value = 0;
+        bool exact = true;
+        if (NumericTraits<T>::parse(token, value, exact)) {
+            double real = 0.0;
+            parseDouble(token, real);
+            builder.pushConstant(real);
+            compiled.constants.push_back(value);
+            compiled.exact = compiled.exact && exact;
+            continue;
+        }
+
+        if (isIdentifierStart(token[0])) {
+            std::size_t length = 1;
+            while (length < token.size() && isIdentifierChar(token[length])) length++;
+            if (length != token.size()) {
+                builder.fail(1); // Invalid token
+                break;
+            }
+            Function function;
+            if (lookupFunction(token.data(), length, function)) {
+                if (!builder.applyFunction(function)) break;
+            } else {
+                builder.pushVariable(token.data(), length);
+            }
+            continue;
+        }
+
+        OpCode op;
+        if (token.size() != 1 || !operatorToOpCode(token[0], op)) {
+            builder.fail(1); // Invalid token
+            break;
+        }
+        if (!builder.applyOperator(op)) break;
+    }
+    if (builder.finish() != 0) compiled.constants.clear();
+}
+
+/**
+ * @brief Runs a compiled program that has no variables.
+ * @param program A program produced by `compile`.
+ * @param errorCode Error code (0 for success, non-zero for errors).
+ * @return The result of the program, or 0 in case of error.
+ */
+template <typename T>
+T BasicRPNCalculator<T>::run(const NumericProgram<T>& program, int& errorCode) {
+    return run(program, nullptr, errorCode);
+}
+
+/**
+ * @brief Runs a compiled program in `T`.
+ * @param program A program produced by `compile`.
+ * @param variables Values for the program's variable slots, in `program.program.variables` order.
+ * @param errorCode Error code (0 for success, non-zero for errors).
+ *        1 - Insufficient operands (compile time) or unbound variables
+ *        2 - Too many operands (compile time)
+ *        3 - Division by zero
+ *        4 - A literal or result not representable in `T`
+ * @return The result of the program, or 0 in case of error.
+ * @note Stack depth was validated by the compiler, so operators pop without checks.
+ */
+template <typename T>
+T BasicRPNCalculator<T>::run(const NumericProgram<T>& program, const T* variables, int& errorCode) {
+    using Traits = NumericTraits<T>;
+    errorCode = program.program.errorCode;
+    if (errorCode == 0 && !program.exact) errorCode = NotRepresentable;
+    if (errorCode == 0 && variables == nullptr && !program.program.variables.empty()) errorCode = 1; // Unbound variables
+    if (errorCode != 0) return 0;
+
+    stack.clear();
+    stack.reserve(static_cast<std::size_t>(program.program.maxDepth));
+
+    const T* constants = program.constants.data();
+    for (const Instruction& ins : program.program.code) {
+        switch (ins.op) {
+        case OpCode::PushConst:
+            stack.push(constants[ins.operand]);
+            continue;
+        case OpCode::PushVar:
+            stack.push(variables[ins.operand]);
+            continue;
+        case OpCode::Neg:
+            errorCode = Traits::negate(stack.top());
+            break;
+        case OpCode::Call1:
+            errorCode = Traits::call(static_cast<Function>(ins.operand), stack.top(), 0);
+            break;
+        default: {
+            T operand2 = stack.top();
+            stack.pop_back();
+            errorCode = ins.op == OpCode::Call2 ? Traits::call(static_cast<Function>(ins.operand), stack.top(), operand2)
+                                                : Traits::apply(ins.op, stack.top(), operand2);
+            break;
+        }
+        }
+        if (errorCode != 0) {
+            stack.clear();
+            return 0;
+        }
+    }
+
+    T result = stack.top();
+    stack.pop_back();
+    return result;
+}
+
+template class BasicRPNCalculator<std::int64_t>;
+template class BasicRPNCalculator<float>;
+template class BasicRPNCalculator<double>;
+template class BasicRPNCalculator<long double>;
+
+/**
+ * @brief Evaluates an RPN expression exactly in int64_t, or in double if that is not possible.
+ * @param expression The RPN expression.
+ * @param errorCode Error code (0 for success, 1-3 as for RPNCalculator).
+ * @return The exact integer result, or the double result after a promotion.
+ * @note The double pass uses the same token loop as the int64_t one, so text that is malformed
+ *       fails the same way whether or not it has a decimal literal.
+ */
+AdaptiveResult AdaptiveCalculator::evaluate(std::string_view expression, int& errorCode) {
+    AdaptiveResult result;
+    result.integer = integers.evaluate(expression, errorCode);
+    if (errorCode == NotRepresentable) {
+        promoted++;
+        result.isInteger = false;
+        result.integer = 0;
+        result.real = reals.evaluate(expression, errorCode);
+    }
+    return result;
+}
+
+/**
+ * @brief Compiles an RPN expression for `run`; the program keeps both integer and double literals.
+ * @param expression The RPN expression.
+ * @param program Receives the compiled program; its storage is reused.
+ */
+void AdaptiveCalculator::compile(std::string_view expression, NumericProgram<std::int64_t>& program) {
+    BasicRPNCalculator<std::int64_t>::compile(expression, program);
+}
+
+/**
+ * @brief Runs a compiled program that has no variables.
+ * @param program A program produced by `compile`.
+ * @param errorCode Error code (0 for success, 1-3 as for RPNCalculator).
+ * @return The exact integer result, or the double result after a promotion.
+ */
+AdaptiveResult AdaptiveCalculator::run(const NumericProgram<std::int64_t>& program, int& errorCode) {
+    return run(program, nullptr, errorCode);
+}
+
+/**
+ * @brief Runs a compiled program in int64_t, or again in double if that is not possible.
+ * @param program A program produced by `compile`.
+ * @param variables Values for the program's variable slots; converted to double for a fallback run.
+ * @param errorCode Error code (0 for success, 1-3 as for RPNCalculator).
+ * @return The exact integer result, or the double result after a promotion.
+ * @note The double run reuses the program's double literals, so no text is parsed again.
+ */
+AdaptiveResult AdaptiveCalculator::run(const NumericProgram<std::int64_t>& program, const std::int64_t* variables, int& errorCode) {
+    AdaptiveResult result;
+    result.integer = integers.run(program, variables, errorCode);
+    if (errorCode != NotRepresentable) return result;
+
+    promoted++;
+    result.isInteger = false;
+    result.integer = 0;
+    const double* values = nullptr;
+    if (variables != nullptr) {
+        realVariables.assign(variables, variables + program.program.variables.size());
+        values = realVariables.data();
+    }
+    result.real = realPrograms.run(program.program, values, errorCode);
+    return result;
+}
@@ -0,0 +1,100 @@
+//##################################################
+// File: NumericCalculator.h
+// Description: RPN calculators templated on the numeric type, and an adaptive int64-then-double calculator.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef NUMERICCALCULATOR_H
+#define NUMERICCALCULATOR_H
+
+#include "Program.h"
+#include "RPNCalculator.h"
+#include "Stack.h"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief A compiled Program with its literals converted to the numeric type `T`.
+ * @note `program.constants` keeps the double values, so the same program also runs on RPNCalculator.
+ *       `constants` holds the values that `BasicRPNCalculator<T>` pushes. For int64_t, a literal
+ *       with no exact integer value (e.g. "2.5" or "1e30") clears `exact`, and running the program
+ *       reports error 4.
+ */
+template <typename T>
+struct NumericProgram {
+    Program program;              ///< Instructions, variables and the double value of every literal.
+    std::vector<T> constants;     ///< Literals as `T`, indexed like `program.constants`.
+    bool exact = true;            ///< False if a literal cannot be represented exactly in `T`.
+};
+
+/**
+ * @brief An RPN calculator that computes in `T` instead of double.
+ * @note Instantiated for std::int64_t, float, double and long double. The int64_t version never
+ *       returns a rounded or wrapped value. Overflow (checked with the compiler's overflow
+ *       builtins), a division with a remainder, a non-integer literal and a function with no
+ *       integer result all report error 4.
+ *       Error codes: 1 - insufficient operands, invalid token or unbound variables;
+ *       2 - too many operands; 3 - division by zero; 4 - result not representable in `T`.
+ */
+template <typename T>
+class BasicRPNCalculator {
+public:
+    T evaluate(std::string_view expression, int& errorCode); ///< Parses and evaluates an RPN expression in `T`.
+
+    static void compile(std::string_view expression, NumericProgram<T>& program); ///< Compiles into an existing program, reusing its storage.
+    T run(const NumericProgram<T>& program, int& errorCode); ///< Runs a program that has no variables.
+    T run(const NumericProgram<T>& program, const T* variables, int& errorCode); ///< Runs a program with values for its variable slots.
+
+private:
+    Stack<T, 32> stack;          ///< Keeps its capacity between evaluations.
+    NumericProgram<T> compiled;  ///< What `evaluate` compiles into; keeps its storage between calls.
+};
+
+extern template class BasicRPNCalculator<std::int64_t>;
+extern template class BasicRPNCalculator<float>;
+extern template class BasicRPNCalculator<double>;
+extern template class BasicRPNCalculator<long double>;
+
+/**
+ * @brief Result of the adaptive calculator: an exact integer, or a double once promoted.
+ */
+struct AdaptiveResult {
+    std::int64_t integer = 0; ///< The exact result when `isInteger`.
+    double real = 0.0;        ///< The double result when not `isInteger`.
+    bool isInteger = true;
+
+    double value() const { return isInteger ? static_cast<double>(integer) : real; } ///< The result as a double either way.
+};
+
+/**
+ * @brief Evaluates in int64_t and falls back to double only when the integer result would be wrong.
+ * @note An expression is run first with checked int64_t arithmetic. If that reports error 4
+ *       (overflow, inexact division or a non-integer literal), the whole expression is run again
+ *       in double: text with `BasicRPNCalculator<double>`, which rejects malformed input exactly as
+ *       the int64_t pass does, and compiled programs with RPNCalculator. Integer-only formulas
+ *       therefore stay exact past 2^53 and do no floating-point conversion. Any other error is
+ *       returned as it is.
+ */
+class AdaptiveCalculator {
+public:
+    AdaptiveResult evaluate(std::string_view expression, int& errorCode); ///< Evaluates text, promoting to double if needed.
+
+    static void compile(std::string_view expression, NumericProgram<std::int64_t>& program); ///< Compiles for `run`.
+    AdaptiveResult run(const NumericProgram<std::int64_t>& program, int& errorCode); ///< Runs a program that has no variables.
+    AdaptiveResult run(const NumericProgram<std::int64_t>& program, const std::int64_t* variables, int& errorCode); ///< Runs with variable values.
+
+    std::uint64_t promotions() const { return promoted; } ///< Evaluations that had to fall back to double.
+
+private:
+    BasicRPNCalculator<std::int64_t> integers;
+    BasicRPNCalculator<double> reals;  ///< Fallback for `evaluate`.
+    RPNCalculator realPrograms;        ///< Fallback for `run`, on the program's double literals.
+    std::vector<double> realVariables; ///< Variable values converted for a fallback run.
+    std::uint64_t promoted = 0;
+};
+
+#endif // NUMERICCALCULATOR_H
@@ -0,0 +1,37 @@
+//##################################################
+// File: OperandStack.h
+// Description: Instrumented pushes onto either operand stack, shared by the RPN and infix evaluators.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef OPERANDSTACK_H
+#define OPERANDSTACK_H
+
+#include "EvaluationScratch.h"
+#include "Instrumentation.h"
+#include "Stack.h"
+
+/**
+ * @brief Pushes onto a growable operand stack.
+ * @return Always true: the stack makes room.
+ */
+inline bool pushOperand(Stack<double, 32>& stack, double value) {
+    RPN_COUNT(Counter::Allocations, stack.size() == stack.capacity() ? 1 : 0);
+    stack.push(value);
+    RPN_RECORD_STACK_DEPTH(stack.size());
+    return true;
+}
+
+/**
+ * @brief Pushes onto a caller's fixed scratch stack.
+ * @return False if the scratch is full.
+ */
+inline bool pushOperand(EvaluationScratch& stack, double value) {
+    if (!stack.tryPush(value)) return false;
+    RPN_RECORD_STACK_DEPTH(stack.size());
+    return true;
+}
+
+#endif // OPERANDSTACK_H
@@ -0,0 +1,58 @@
+//##################################################
+// File: ParallelEvaluator.cpp
+// Description: Per-worker calculator contexts for parallel batch evaluation.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "ParallelEvaluator.h"
+#include "InfixCalculator.h"
+
+#include <memory>
+
+namespace {
+
+// Expressions per stealable chunk: large enough to amortize the deque lock, small enough to balance.
+const std::size_t ChunkSize = 1024;
+
+/**
+ * @brief Everything one worker needs to evaluate expressions without sharing state.
+ * @note Cache-line aligned so neighbouring workers never write to the same line.
+ */
+struct alignas(64) WorkerContext {
+    InfixCalculator calculator;
+    Program program;
+};
+
+} // namespace
+
+/**
+ * @brief Evaluates every expression on the pool's workers.
+ * @param pool The pool to run on.
+ * @param expressions Null-terminated expressions.
+ * @param notation How to parse the expressions.
+ * @param results Receives one result per expression, in input order.
+ * @param errorCodes Receives one error code per expression, in input order.
+ * @note Each expression is compiled into the worker's reusable Program and run, so a failed
+ *       expression never leaves operands behind for the next one on the same worker.
+ */
+void evaluateBatch(WorkStealingPool& pool, std::span<const char* const> expressions, Notation notation,
+                   std::span<double> results, std::span<int> errorCodes) {
+    std::unique_ptr<WorkerContext[]> contexts(new WorkerContext[pool.size()]);
+
+    pool.parallelFor(expressions.size(), ChunkSize, [&](unsigned worker, std::size_t begin, std::size_t end) {
+        WorkerContext& context = contexts[worker];
+        for (std::size_t i = begin; i < end; ++i) {
+            if (notation == Notation::RPN) RPNCalculator::compile(expressions[i], context.program);
+            else context.calculator.compileInfix(expressions[i], context.program);
+            results[i] = context.calculator.run(context.program, errorCodes[i]);
+        }
+    });
+}
+
+void evaluateBatch(std::span<const char* const> expressions, Notation notation,
+                   std::span<double> results, std::span<int> errorCodes, unsigned threadCount) {
+    WorkStealingPool pool(threadCount);
+    evaluateBatch(pool, expressions, notation, results, errorCodes);
+}
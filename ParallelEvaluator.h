@@ -0,0 +1,34 @@
+//##################################################
+// File: ParallelEvaluator.h
+// Description: Evaluates many independent RPN or infix expressions across a work-stealing thread pool.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef PARALLELEVALUATOR_H
+#define PARALLELEVALUATOR_H
+
+#include "Program.h"
+#include "WorkStealingPool.h"
+
+#include <span>
+
+/**
+ * @brief Evaluates every expression on the pool's workers.
+ * @param pool The pool to run on; each worker gets its own calculator context.
+ * @param expressions Null-terminated expressions.
+ * @param notation How to parse the expressions.
+ * @param results Receives one result per expression, in input order.
+ * @param errorCodes Receives one error code per expression, in input order.
+ */
+void evaluateBatch(WorkStealingPool& pool, std::span<const char* const> expressions, Notation notation,
+                   std::span<double> results, std::span<int> errorCodes);
+
+/**
+ * @brief Convenience overload that runs on a temporary pool of `threadCount` workers (0 = hardware threads).
+ */
+void evaluateBatch(std::span<const char* const> expressions, Notation notation,
+                   std::span<double> results, std::span<int> errorCodes, unsigned threadCount = 0);
+
+#endif // PARALLELEVALUATOR_H
@@ -0,0 +1,182 @@
+//##################################################
+// File: ParallelWordCount.cpp
+// Description: Word-aligned chunking, per-worker counting, the partitioned merge and the sorted k-way merge.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "ParallelWordCount.h"
+#include "MappedFile.h"
+#include "WordTokenizer.h"
+
+#include <chrono>
+#include <ostream>
+#include <queue>
+
+namespace {
+
+const std::size_t MinChunk = 1u << 20;     // Smaller chunks cost more in scheduling than they gain in balance
+const std::size_t ChunksPerWorker = 8;
+const unsigned MaxPartitions = 256;
+
+typedef std::chrono::steady_clock Clock;
+
+std::uint64_t nanosecondsSince(Clock::time_point start) {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+
+/**
+ * @brief Cuts text into chunks of about equal size that end between words.
+ * @return The chunk boundaries, starting with 0 and ending with `size`.
+ */
+std::vector<std::size_t> chunkBounds(const char* data, std::size_t size, unsigned workers) {
+    std::size_t target = size / (static_cast<std::size_t>(workers) * ChunksPerWorker) + 1;
+    if (target < MinChunk) target = MinChunk;
+    std::vector<std::size_t> bounds(1, 0);
+    for (std::size_t pos = 0; pos < size;) {
+        std::size_t end = size - pos > target ? pos + target : size;
+        while (end < size && isWordByte(data[end])) end++;
+        bounds.push_back(end);
+        pos = end;
+    }
+    return bounds;
+}
+
+} // namespace
+
+/**
+ * @brief Creates an empty count and starts the pool.
+ * @param threadCount Workers, including the calling thread (0 = one per hardware thread).
+ * @note There are about four partitions per worker so the merge tasks balance too.
+ */
+ParallelWordCount::ParallelWordCount(unsigned threadCount) : pool(threadCount), partitionCount(1) {
+    while (partitionCount < 4 * pool.size() && partitionCount < MaxPartitions) partitionCount *= 2;
+    partitions.reset(new WordTable[partitionCount]);
+    sortedPartitions.resize(partitionCount);
+    totals.threads = pool.size();
+    totals.partitions = partitionCount;
+}
+
+/**
+ * @brief Counts every word of a file through a read-only memory mapping.
+ * @param fileName The file to count.
+ * @return False if the file cannot be opened or mapped.
+ */
+bool ParallelWordCount::readFile(const std::string& fileName) {
+    MappedFile file;
+    if (!file.open(fileName.c_str())) return false;
+    file.adviseSequential();
+    countChunks(file.data(), file.size(), chunkBounds(file.data(), file.size(), pool.size()));
+    return true;
+}
+
+/**
+ * @brief Counts every word of a span of text.
+ * @param text The text; counts add to those of earlier calls.
+ */
+void ParallelWordCount::processText(std::string_view text) {
+    countChunks(text.data(), text.size(), chunkBounds(text.data(), text.size(), pool.size()));
+}
+
+/**
+ * @brief Counts the chunks in parallel, then merges and sorts each partition in parallel.
+ * @param data The text.
+ * @param size Bytes of text.
+ * @param bounds Chunk boundaries from `chunkBounds`.
+ */
+void ParallelWordCount::countChunks(const char* data, std::size_t size, const std::vector<std::size_t>& bounds) {
+    const unsigned workers = pool.size();
+    std::unique_ptr<WordTable[]> local(new WordTable[static_cast<std::size_t>(workers) * partitionCount]);
+
+    Clock::time_point start = Clock::now();
+    pool.parallelFor(bounds.size() - 1, 1, [&](unsigned worker, std::size_t begin, std::size_t end) {
+        WordTable* tables = &local[static_cast<std::size_t>(worker) * partitionCount];
+        for (std::size_t chunk = begin; chunk < end; ++chunk) {
+            std::string_view text(data + bounds[chunk], bounds[chunk + 1] - bounds[chunk]);
+            tokenizeWords(text, [&](std::string_view word) {
+                std::uint64_t hash = WordTable::hashWord(word);
+                tables[partitionOf(hash)].addHashed(word, hash);
+            });
+        }
+    });
+    totals.countNs = nanosecondsSince(start);
+
+    start = Clock::now();
+    pool.parallelFor(partitionCount, 1, [&](unsigned, std::size_t begin, std::size_t end) {
+        for (std::size_t p = begin; p < end; ++p) {
+            WordTable& merged = partitions[p];
+            for (unsigned worker = 0; worker < workers; ++worker) {
+                WordTable& part = local[static_cast<std::size_t>(worker) * partitionCount + p];
+                merged.merge(part);
+                part.clear();
+            }
+            sortedPartitions[p] = merged.sorted();
+        }
+    });
+    totals.mergeNs = nanosecondsSince(start);
+    totals.bytes = size;
+    totals.chunks = bounds.size() - 1;
+}
+
+/**
+ * @brief Merges the sorted partitions into one list.
+ * @return Every word with its count, in the order `std::string` comparison gives.
+ */
+std::vector<WordFrequency> ParallelWordCount::sorted() const {
+    struct Head {
+        std::string_view word;
+        unsigned partition;
+        std::size_t index;
+        bool operator<(const Head& other) const { return other.word < word; } // Smallest word on top
+    };
+    std::priority_queue<Head> heads;
+    std::size_t total = 0;
+    for (unsigned p = 0; p < partitionCount; ++p) {
+        total += sortedPartitions[p].size();
+        if (!sortedPartitions[p].empty()) heads.push(Head{ sortedPartitions[p][0].word, p, 0 });
+    }
+
+    std::vector<WordFrequency> entries;
+    entries.reserve(total);
+    while (!heads.empty()) {
+        Head head = heads.top();
+        heads.pop();
+        const std::vector<WordFrequency>& partition = sortedPartitions[head.partition];
+        entries.push_back(partition[head.index]);
+        if (++head.index < partition.size()) {
+            head.word = partition[head.index].word;
+            heads.push(head);
+        }
+    }
+    return entries;
+}
+
+/**
+ * @brief Writes one "word - count" line per word, in word order.
+ * @param out The stream to write to.
+ */
+void ParallelWordCount::print(std::ostream& out) const {
+    for (const WordFrequency& entry : sorted()) {
+        out << entry.word << " - " << entry.count << '\n';
+    }
+    out.flush();
+}
+
+/**
+ * @brief Looks up the count of a word.
+ * @param word The word to look up.
+ * @return Its occurrences, or 0 if it was never counted.
+ */
+std::uint64_t ParallelWordCount::count(std::string_view word) const {
+    return partitions[partitionOf(WordTable::hashWord(word))].count(word);
+}
+
+/**
+ * @brief Counts the distinct words across all partitions.
+ */
+std::size_t ParallelWordCount::size() const {
+    std::size_t words = 0;
+    for (unsigned p = 0; p < partitionCount; ++p) words += partitions[p].size();
+    return words;
+}
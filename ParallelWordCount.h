@@ -0,0 +1,77 @@
+//##################################################
+// File: ParallelWordCount.h
+// Description: Counts words on a work-stealing pool with per-thread tables and a merge partitioned by hash.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef PARALLELWORDCOUNT_H
+#define PARALLELWORDCOUNT_H
+
+#include "FrozenWordIndex.h"
+#include "WordTable.h"
+#include "WorkStealingPool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Sizes and phase timings of the last counting run.
+ */
+struct ParallelWordCountStats {
+    std::size_t bytes = 0;          ///< Bytes tokenized.
+    std::size_t chunks = 0;         ///< Chunks the input was split into.
+    unsigned threads = 0;           ///< Workers, including the calling thread.
+    unsigned partitions = 0;        ///< Hash partitions merged independently.
+    std::uint64_t countNs = 0;      ///< Tokenizing into the per-worker tables.
+    std::uint64_t mergeNs = 0;      ///< Merging and sorting the partitions.
+};
+
+/**
+ * @brief Word counts built by every worker of a pool at once.
+ * @note The input is cut into chunks that end between words, and the pool balances them by work
+ *       stealing. Each worker counts into its own tables, one per partition, so counting takes no
+ *       lock. The partition of a word is taken from the high bits of its hash (WordTable uses the
+ *       low bits), which splits the words evenly. A word lands in the same partition on every
+ *       worker, so the merge runs one partition per task with no sharing. Each merged partition is
+ *       then sorted in its task, and `sorted` only has to merge the sorted partitions. The order is
+ *       `std::string` order, the same as AVLTree's in-order walk.
+ */
+class ParallelWordCount {
+public:
+    explicit ParallelWordCount(unsigned threadCount = 0); ///< Starts the pool (0 = one worker per hardware thread).
+
+    ParallelWordCount(const ParallelWordCount&) = delete;
+    ParallelWordCount& operator=(const ParallelWordCount&) = delete;
+
+    bool readFile(const std::string& fileName);   ///< Counts every word of a memory-mapped file; false if it cannot be opened.
+    void processText(std::string_view text);      ///< Counts every word of `text` in parallel.
+
+    std::vector<WordFrequency> sorted() const;    ///< Every word with its count, in word order.
+    void print(std::ostream& out) const;          ///< Writes "word - count" lines in word order.
+    std::uint64_t count(std::string_view word) const; ///< Occurrences of `word` (0 if never counted).
+    std::size_t size() const;                     ///< Number of distinct words.
+    FrozenWordIndex freeze() const { return FrozenWordIndex(sorted()); } ///< Copies the counts into a read-only index for lookups.
+
+    const ParallelWordCountStats& stats() const { return totals; } ///< Sizes and timings of the last run.
+
+private:
+    WorkStealingPool pool;
+    unsigned partitionCount;                      ///< A power of two.
+    std::unique_ptr<WordTable[]> partitions;      ///< The merged counts, split by hash.
+    std::vector<std::vector<WordFrequency>> sortedPartitions; ///< Each partition in word order.
+    ParallelWordCountStats totals;
+
+    void countChunks(const char* data, std::size_t size, const std::vector<std::size_t>& bounds); ///< Counts and merges the chunks between consecutive bounds.
+    unsigned partitionOf(std::uint64_t hash) const { ///< Partition picked by the high bits of a word's hash.
+        return static_cast<unsigned>(hash >> 32) & (partitionCount - 1);
+    }
+};
+
+#endif // PARALLELWORDCOUNT_H
@@ -0,0 +1,229 @@
+//##################################################
+// File: Program.cpp
+// Description: Builds compiled expression programs and validates their stack usage.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Program.h"
+
+#include <cmath>
+#include <cstring>
+
+/**
+ * @brief Empties the program while keeping the allocated storage for reuse.
+ */
+void Program::clear() {
+    code.clear();
+    constants.clear();
+    variables.clear();
+    maxDepth = 0;
+    errorCode = 0;
+}
+
+/**
+ * @brief Looks up the slot assigned to a variable.
+ * @param name The variable name.
+ * @return The slot index, or -1 if the program does not reference the variable.
+ */
+int Program::variableIndex(const char* name) const {
+    for (std::size_t i = 0; i < variables.size(); ++i) {
+        if (variables[i] == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+ProgramBuilder::ProgramBuilder(Program& program) : program(program), depth(0) {
+    program.clear();
+}
+
+/**
+ * @brief Emits an instruction that pushes a constant.
+ * @param value The pre-parsed numeric literal.
+ */
+void ProgramBuilder::pushConstant(double value) {
+    Instruction ins;
+    ins.op = OpCode::PushConst;
+    ins.operand = static_cast<unsigned int>(program.constants.size());
+    program.constants.push_back(value);
+    program.code.push_back(ins);
+
+    if (++depth > program.maxDepth) program.maxDepth = depth;
+}
+
+/**
+ * @brief Emits an instruction that pushes a variable.
+ * @param name Start of the variable name (not necessarily null-terminated).
+ * @param length Number of characters in the name.
+ * @note Slots are numbered in order of first appearance, so "x y * x +" binds x to 0 and y to 1.
+ */
+void ProgramBuilder::pushVariable(const char* name, std::size_t length) {
+    std::size_t slot = 0;
+    while (slot < program.variables.size() &&
+           program.variables[slot].compare(0, std::string::npos, name, length) != 0) {
+        slot++;
+    }
+    if (slot == program.variables.size()) {
+        program.variables.emplace_back(name, length);
+    }
+
+    Instruction ins;
+    ins.op = OpCode::PushVar;
+    ins.operand = static_cast<unsigned int>(slot);
+    program.code.push_back(ins);
+
+    if (++depth > program.maxDepth) program.maxDepth = depth;
+}
+
+/**
+ * @brief Emits a binary operator.
+ * @param op The operator to emit.
+ * @return False if the operator fails at compile time.
+ *        1 - Insufficient operands
+ *        3 - Division by a literal zero
+ */
+bool ProgramBuilder::applyOperator(OpCode op) {
+    if (depth < 2) {
+        fail(1); // Insufficient operands
+        return false;
+    }
+    if (op == OpCode::Div) {
+        const Instruction& divisor = program.code.back();
+        if (divisor.op == OpCode::PushConst && program.constants[divisor.operand] == 0) {
+            fail(3); // Division by zero
+            return false;
+        }
+    }
+
+    Instruction ins;
+    ins.op = op;
+    ins.operand = 0;
+    program.code.push_back(ins);
+    depth--;
+    return true;
+}
+
+/**
+ * @brief Emits a unary minus.
+ * @return False if there is no operand to negate.
+ * @note A literal directly before the minus is negated in place, so "-3" compiles to a single constant.
+ */
+bool ProgramBuilder::applyNegate() {
+    if (depth < 1) {
+        fail(1); // Insufficient operands
+        return false;
+    }
+    Instruction& last = program.code.back();
+    if (last.op == OpCode::PushConst && last.operand + 1 == program.constants.size()) {
+        program.constants.back() = -program.constants.back();
+        return true;
+    }
+
+    Instruction ins;
+    ins.op = OpCode::Neg;
+    ins.operand = 0;
+    program.code.push_back(ins);
+    return true;
+}
+
+/**
+ * @brief Emits a call to a built-in function.
+ * @param function The function to call; its arguments must already be on the stack.
+ * @return False if there are fewer values on the stack than the function takes.
+ */
+bool ProgramBuilder::applyFunction(Function function) {
+    int arity = functionArity(function);
+    if (depth < arity) {
+        fail(1); // Insufficient operands
+        return false;
+    }
+
+    Instruction ins;
+    ins.op = arity == 1 ? OpCode::Call1 : OpCode::Call2;
+    ins.operand = static_cast<unsigned int>(function);
+    program.code.push_back(ins);
+    depth -= arity - 1;
+    return true;
+}
+
+/**
+ * @brief Checks that exactly one value is left once the program has run.
+ * @return The program's error code (0 for success).
+ *        1 - Insufficient operands
+ *        2 - Too many operands
+ */
+int ProgramBuilder::finish() {
+    if (failed()) return program.errorCode;
+    if (depth == 0) fail(1);
+    else if (depth > 1) fail(2);
+    return program.errorCode;
+}
+
+/**
+ * @brief Records a compile error.
+ * @param errorCode The error to record.
+ * @note The instructions are dropped so that a failed program can never run.
+ */
+void ProgramBuilder::fail(int errorCode) {
+    program.code.clear();
+    program.constants.clear();
+    program.variables.clear();
+    program.errorCode = errorCode;
+}
+
+namespace {
+
+struct FunctionInfo {
+    const char* name;
+    Function function;
+};
+
+const FunctionInfo Functions[] = {
+    { "sqrt", Function::Sqrt }, { "abs", Function::Abs }, { "exp", Function::Exp }, { "log", Function::Log },
+    { "sin", Function::Sin }, { "cos", Function::Cos }, { "tan", Function::Tan },
+    { "min", Function::Min }, { "max", Function::Max }, { "pow", Function::Pow },
+};
+
+} // namespace
+
+/**
+ * @brief Finds a built-in function by name.
+ * @param name Start of the name (not necessarily null-terminated).
+ * @param length Number of characters in the name.
+ * @param function Receives the function when found.
+ * @return True if the name is a built-in function.
+ */
+bool lookupFunction(const char* name, std::size_t length, Function& function) {
+    for (const FunctionInfo& info : Functions) {
+        if (std::strlen(info.name) == length && std::memcmp(info.name, name, length) == 0) {
+            function = info.function;
+            return true;
+        }
+    }
+    return false;
+}
+
+int functionArity(Function function) {
+    return function >= Function::Min ? 2 : 1;
+}
+
+/**
+ * @brief Applies a built-in function.
+ * @note Domain errors follow IEEE (e.g. sqrt(-1) is NaN, log(0) is -inf); only division reports error 3.
+ */
+double callFunction(Function function, double a, double b) {
+    switch (function) {
+    case Function::Sqrt: return std::sqrt(a);
+    case Function::Abs: return std::fabs(a);
+    case Function::Exp: return std::exp(a);
+    case Function::Log: return std::log(a);
+    case Function::Sin: return std::sin(a);
+    case Function::Cos: return std::cos(a);
+    case Function::Tan: return std::tan(a);
+    case Function::Min: return a < b ? a : b;
+    case Function::Max: return a > b ? a : b;
+    case Function::Pow: return std::pow(a, b);
+    }
+    return 0.0;
+}
@@ -0,0 +1,150 @@
+//##################################################
+// File: Program.h
+// Description: A compiled, flat instruction stream for RPN and infix expressions.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef PROGRAM_H
+#define PROGRAM_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Selects how expression text is parsed.
+ */
+enum class Notation {
+    RPN,   ///< Postfix, e.g. "3 2 5 * +".
+    Infix  ///< Conventional, e.g. "3 + 2 * 5".
+};
+
+/**
+ * @brief Operations understood by `RPNCalculator::run`.
+ */
+enum class OpCode : unsigned char {
+    PushConst, ///< Pushes `constants[operand]`.
+    PushVar,   ///< Pushes the value bound to `variables[operand]`.
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Pow,       ///< Exponentiation (`^`).
+    Neg,       ///< Unary minus of the top value.
+    Call1,     ///< Replaces the top value with `Function(operand)` applied to it.
+    Call2      ///< Replaces the top two values with `Function(operand)` applied to them.
+};
+
+/**
+ * @brief Built-in functions callable as `name(args)` in infix or as a `name` token in RPN.
+ */
+enum class Function : unsigned char {
+    Sqrt, Abs, Exp, Log, Sin, Cos, Tan, ///< One argument.
+    Min, Max, Pow                       ///< Two arguments.
+};
+
+/**
+ * @brief A single instruction; `operand` is the constant, variable slot or function for the ops that take one.
+ */
+struct Instruction {
+    OpCode op;
+    unsigned int operand;
+};
+
+/**
+ * @brief A compiled expression: postfix instructions plus their pre-parsed constants.
+ * @note A Program that failed to compile keeps the error code (1, 2 or 3) so that running it reports the same error.
+ */
+struct Program {
+    std::vector<Instruction> code;   ///< Postfix instruction stream.
+    std::vector<double> constants;   ///< Numeric literals referenced by `PushConst`.
+    std::vector<std::string> variables; ///< Variable names in slot order (first appearance).
+    int maxDepth;                    ///< Deepest operand stack reached while running.
+    int errorCode;                   ///< Error detected while compiling, 0 if none.
+
+    Program() : maxDepth(0), errorCode(0) {}
+
+    void clear(); ///< Empties the program while keeping its storage.
+    int variableIndex(const char* name) const; ///< Returns the slot of a variable, or -1 if unused.
+};
+
+/**
+ * @brief Appends instructions to a Program while tracking the operand stack depth.
+ * @note Used by both the RPN and the infix compilers so that they detect errors the same way.
+ */
+class ProgramBuilder {
+public:
+    explicit ProgramBuilder(Program& program); ///< Clears `program` and starts emitting into it.
+
+    void pushConstant(double value);      ///< Emits a `PushConst` for the value.
+    void pushVariable(const char* name, std::size_t length); ///< Emits a `PushVar`, assigning a slot on first use.
+    bool applyOperator(OpCode op);        ///< Emits a binary operator; returns false on a compile error.
+    bool applyNegate();                   ///< Emits a unary minus (folded into a preceding literal); false on error.
+    bool applyFunction(Function function); ///< Emits a call; returns false if its arguments are missing.
+    int finish();                         ///< Validates the final stack depth and returns the program's error code.
+
+    bool failed() const { return program.errorCode != 0; } ///< True once an error has been recorded.
+    int stackDepth() const { return depth; } ///< Values the emitted code leaves on the stack.
+    void fail(int errorCode);             ///< Records an error and drops the partially emitted code.
+
+private:
+    Program& program;
+    int depth;
+};
+
+/**
+ * @brief Maps an operator character to its opcode.
+ * @param c The operator character.
+ * @param op Receives the opcode when `c` is a supported operator.
+ * @return True if `c` is one of + - * / ^.
+ */
+inline bool operatorToOpCode(char c, OpCode& op) {
+    switch (c) {
+    case '+': op = OpCode::Add; return true;
+    case '-': op = OpCode::Sub; return true;
+    case '*': op = OpCode::Mul; return true;
+    case '/': op = OpCode::Div; return true;
+    case '^': op = OpCode::Pow; return true;
+    default: return false;
+    }
+}
+
+bool lookupFunction(const char* name, std::size_t length, Function& function); ///< Finds a built-in function by name.
+int functionArity(Function function);                          ///< Number of arguments a function takes.
+double callFunction(Function function, double a, double b);    ///< Applies a function (`b` is ignored for one-argument functions).
+
+/**
+ * @brief Checks whether a character can start a variable name (letter or underscore).
+ */
+inline bool isIdentifierStart(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+/**
+ * @brief Checks whether a character can continue a variable name (letter, digit or underscore).
+ */
+inline bool isIdentifierChar(char c) {
+    return isIdentifierStart(c) || (c >= '0' && c <= '9');
+}
+
+/**
+ * @brief Finds the next space-separated RPN token without copying it.
+ * @param expression The whole expression.
+ * @param pos Current position; advanced past the token.
+ * @param token Receives a view of the token inside `expression`.
+ * @return False once the end of the expression is reached.
+ */
+inline bool nextToken(std::string_view expression, std::size_t& pos, std::string_view& token) {
+    while (pos < expression.size() && expression[pos] == ' ') pos++;
+    if (pos == expression.size()) return false;
+
+    std::size_t start = pos;
+    while (pos < expression.size() && expression[pos] != ' ') pos++;
+    token = expression.substr(start, pos - start);
+    return true;
+}
+
+#endif // PROGRAM_H
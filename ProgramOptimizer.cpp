@@ -0,0 +1,201 @@
+//##################################################
+// File: ProgramOptimizer.cpp
+// Description: Folds constant subtrees and removes exact identities from compiled Programs.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "ProgramOptimizer.h"
+#include "Stack.h"
+
+#include <cmath>
+
+namespace {
+
+/**
+ * @brief One value on the symbolic stack: the output instructions that compute it.
+ * @note Postfix code keeps every operand contiguous, so an operand is fully described by where its
+ *       instructions start; a constant operand is always a single `PushConst`.
+ */
+struct Operand {
+    std::size_t start;
+    bool isConstant;
+    double value;
+};
+
+/**
+ * @brief Checks whether `value` is +1 or -1 times a power of two whose reciprocal is also a normal double.
+ * @note For such divisors x / c and x * (1 / c) round the same exact quotient, so they are bit-identical.
+ */
+bool hasExactReciprocal(double value) {
+    if (!std::isnormal(value)) return false;
+    int exponent = 0;
+    double fraction = std::frexp(value, &exponent);
+    if (fraction != 0.5 && fraction != -0.5) return false;
+    return std::isnormal(1.0 / value);
+}
+
+bool isNegativeZero(double value) {
+    return value == 0 && std::signbit(value);
+}
+
+double fold(const Instruction& ins, double a, double b) {
+    switch (ins.op) {
+    case OpCode::Add: return a + b;
+    case OpCode::Sub: return a - b;
+    case OpCode::Mul: return a * b;
+    case OpCode::Div: return a / b;
+    case OpCode::Pow: return std::pow(a, b);
+    case OpCode::Neg: return -a;
+    default: return callFunction(static_cast<Function>(ins.operand), a, b);
+    }
+}
+
+/**
+ * @brief Checks whether `x op c` always equals x, bit for bit.
+ * @note x + 0 is not an identity (-0 + 0 is +0), but x + -0 and x - 0 are.
+ */
+bool isRightIdentity(OpCode op, double c) {
+    switch (op) {
+    case OpCode::Add: return isNegativeZero(c);
+    case OpCode::Sub: return c == 0 && !std::signbit(c);
+    case OpCode::Mul:
+    case OpCode::Div:
+    case OpCode::Pow: return c == 1;
+    default: return false;
+    }
+}
+
+/**
+ * @brief Checks whether `c op x` always equals x, bit for bit.
+ */
+bool isLeftIdentity(OpCode op, double c) {
+    switch (op) {
+    case OpCode::Add: return isNegativeZero(c);
+    case OpCode::Mul: return c == 1;
+    default: return false;
+    }
+}
+
+/**
+ * @brief Drops constants no instruction refers to any more and renumbers the rest.
+ */
+void compactConstants(Program& program) {
+    std::vector<double> used;
+    used.reserve(program.code.size());
+    for (Instruction& ins : program.code) {
+        if (ins.op != OpCode::PushConst) continue;
+        used.push_back(program.constants[ins.operand]);
+        ins.operand = static_cast<unsigned int>(used.size() - 1);
+    }
+    program.constants.swap(used);
+}
+
+/**
+ * @brief Recomputes the deepest stack the optimized code reaches.
+ */
+int stackDepthOf(const Program& program) {
+    int depth = 0;
+    int maxDepth = 0;
+    for (const Instruction& ins : program.code) {
+        switch (ins.op) {
+        case OpCode::PushConst:
+        case OpCode::PushVar: depth++; break;
+        case OpCode::Neg: break;
+        case OpCode::Call1:
+        case OpCode::Call2: depth -= functionArity(static_cast<Function>(ins.operand)) - 1; break;
+        default: depth--; break;
+        }
+        if (depth > maxDepth) maxDepth = depth;
+    }
+    return maxDepth;
+}
+
+} // namespace
+
+/**
+ * @brief Folds constant subtrees, removes identities and replaces exact divisions by multiplications.
+ * @param program A compiled expression; left untouched if it carries a compile error.
+ * @return The number of instructions removed.
+ * @note One pass over the postfix code with a symbolic stack:
+ *        - operators whose operands are all constants are evaluated now, except division by zero,
+ *          which is kept so that running the program still reports error 3;
+ *        - x*1, 1*x, x/1, x^1, x-0, x+(-0) and -(-x) are reduced to x;
+ *        - x/c becomes x*(1/c) when c is a power of two, the only case where the two always agree.
+ *       Nothing that could change a result bit is rewritten: x+0, x*0 and reassociation stay as they are.
+ */
+int optimizeProgram(Program& program) {
+    if (program.errorCode != 0) return 0;
+
+    const std::size_t originalSize = program.code.size();
+    std::vector<Instruction> input;
+    input.swap(program.code);
+    program.code.reserve(input.size());
+
+    Stack<Operand, 32> operands;
+    std::vector<Instruction>& out = program.code;
+
+    for (const Instruction& ins : input) {
+        if (ins.op == OpCode::PushConst) {
+            operands.push(Operand{ out.size(), true, program.constants[ins.operand] });
+            out.push_back(ins);
+            continue;
+        }
+        if (ins.op == OpCode::PushVar) {
+            operands.push(Operand{ out.size(), false, 0.0 });
+            out.push_back(ins);
+            continue;
+        }
+
+        if (ins.op == OpCode::Neg || ins.op == OpCode::Call1) {
+            Operand& top = operands.top();
+            if (top.isConstant) {
+                top.value = fold(ins, top.value, 0.0);
+                out[top.start].operand = static_cast<unsigned int>(program.constants.size());
+                program.constants.push_back(top.value);
+            } else if (ins.op == OpCode::Neg && out.back().op == OpCode::Neg) {
+                out.pop_back(); // -(-x) is x
+            } else {
+                out.push_back(ins);
+            }
+            continue;
+        }
+
+        Operand rhs = operands.top();
+        operands.pop_back();
+        Operand& lhs = operands.top();
+
+        if (lhs.isConstant && rhs.isConstant && !(ins.op == OpCode::Div && rhs.value == 0)) {
+            lhs.value = fold(ins, lhs.value, rhs.value);
+            out.resize(lhs.start + 1);
+            out[lhs.start].operand = static_cast<unsigned int>(program.constants.size());
+            program.constants.push_back(lhs.value);
+            continue;
+        }
+        if (rhs.isConstant && isRightIdentity(ins.op, rhs.value)) {
+            out.pop_back(); // x op identity: keep x
+            continue;
+        }
+        if (lhs.isConstant && isLeftIdentity(ins.op, lhs.value)) {
+            out.erase(out.begin() + static_cast<std::ptrdiff_t>(lhs.start)); // identity op x: keep x
+            lhs.isConstant = false;
+            continue;
+        }
+        if (rhs.isConstant && ins.op == OpCode::Div && hasExactReciprocal(rhs.value)) {
+            out.back().operand = static_cast<unsigned int>(program.constants.size());
+            program.constants.push_back(1.0 / rhs.value);
+            Instruction multiply = { OpCode::Mul, 0 };
+            out.push_back(multiply);
+            lhs.isConstant = false;
+            continue;
+        }
+
+        out.push_back(ins);
+        lhs.isConstant = false;
+    }
+
+    compactConstants(program);
+    program.maxDepth = stackDepthOf(program);
+    return static_cast<int>(originalSize - program.code.size());
+}
@@ -0,0 +1,23 @@
+//##################################################
+// File: ProgramOptimizer.h
+// Description: Constant folding, identity removal and strength reduction for compiled Programs.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef PROGRAMOPTIMIZER_H
+#define PROGRAMOPTIMIZER_H
+
+#include "Program.h"
+
+/**
+ * @brief Rewrites `program` into an equivalent, shorter instruction stream.
+ * @param program A compiled expression; programs that failed to compile are left untouched.
+ * @return The number of instructions removed.
+ * @note Every rewrite is exact under IEEE arithmetic: the optimized program returns bit-identical
+ *       results and the same error codes (including 3 for division by zero) for every variable binding.
+ */
+int optimizeProgram(Program& program);
+
+#endif // PROGRAMOPTIMIZER_H
@@ -1,6 +1,6 @@
 //##################################################
 // File: Queue.h
-// Description: A Queue class implemented using a doubly linked list.
+// Description: A Queue class backed by a growable power-of-two ring buffer, with batch enqueue and dequeue.
 // Date: Nov,10 2024
 //##################################################
 
@@ -9,84 +9,299 @@
 #ifndef QUEUE_H
 #define QUEUE_H
 
-#include "DoublyLinkedList.h"
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 template <typename T>
 class Queue {
 public:
-    Queue();                     ///< Constructor initializes an empty queue.
+    Queue();                     ///< Constructor initializes an empty queue without allocating.
     ~Queue();                    ///< Destructor to clean up queue.
 
+    Queue(const Queue& other);              ///< Copies the elements of another queue.
+    Queue& operator=(const Queue& other);   ///< Replaces the contents with a copy of another queue.
+    Queue(Queue&& other) noexcept;          ///< Takes over the buffer of another queue.
+    Queue& operator=(Queue&& other) noexcept; ///< Releases this queue's elements and takes over another's buffer.
+
     void enqueue(const T& data); ///< Adds an element to the end of the queue.
+    void enqueue(T&& data);      ///< Adds an element to the end of the queue by moving it.
     bool dequeue();              ///< Removes the front element from the queue.
+    bool dequeue(T& out);        ///< Moves the front element into `out` and removes it.
     T peek() const;              ///< Returns the front element without removing it.
+    T& front();                  ///< Returns a reference to the front element (queue must not be empty).
+
+    template <typename Iterator>
+    void enqueueBatch(Iterator first, std::size_t batchCount); ///< Appends `batchCount` elements; use a move iterator to move them.
+    std::size_t dequeueBatch(T* out, std::size_t maxCount); ///< Moves up to `maxCount` front elements into `out`.
 
     bool isEmpty() const;        ///< Checks if the queue is empty.
+    std::size_t size() const;    ///< Returns the number of queued elements.
+    std::size_t capacity() const; ///< Returns the number of elements that fit without reallocating.
+    void reserve(std::size_t newCapacity); ///< Grows storage to hold at least `newCapacity` elements.
+    void clear();                ///< Removes all elements, keeping the allocated storage.
 
 private:
-    DoublyLinkedList<T> list;    ///< The underlying doubly linked list for queue storage.
+    T* items;                    ///< Ring buffer of `cap` slots; null until the first enqueue.
+    std::size_t head;            ///< Slot of the front element.
+    std::size_t count;           ///< Number of live elements.
+    std::size_t cap;             ///< Power of two, or 0 before the first allocation.
+
+    static constexpr std::size_t MinCapacity = 16;
+
+    std::size_t slot(std::size_t index) const { return (head + index) & (cap - 1); }
+    void grow(std::size_t minCapacity);
+    void release();
 };
 
 /**
  * @brief Initializes an empty queue.
- * @note Constructor follows unit 11 with no modifications.
+ * @note No storage is allocated until the first element arrives.
  */
 template <typename T>
-Queue<T>::Queue() {}
+Queue<T>::Queue() : items(nullptr), head(0), count(0), cap(0) {}
 
 /**
- * @brief Destructor automatically cleans up the linked list.
- * @note follows lecture material.
+ * @brief Destroys the remaining elements and frees the ring buffer.
  */
 template <typename T>
-Queue<T>::~Queue() {}
+Queue<T>::~Queue() {
+    release();
+}
+
+template <typename T>
+Queue<T>::Queue(const Queue& other) : Queue() {
+    reserve(other.count);
+    for (std::size_t i = 0; i < other.count; ++i) {
+        new (items + i) T(other.items[other.slot(i)]);
+    }
+    count = other.count;
+}
+
+template <typename T>
+Queue<T>& Queue<T>::operator=(const Queue& other) {
+    if (this != &other) {
+        clear();
+        reserve(other.count);
+        head = 0;
+        for (std::size_t i = 0; i < other.count; ++i) {
+            new (items + i) T(other.items[other.slot(i)]);
+        }
+        count = other.count;
+    }
+    return *this;
+}
+
+template <typename T>
+Queue<T>::Queue(Queue&& other) noexcept : items(other.items), head(other.head), count(other.count), cap(other.cap) {
+    other.items = nullptr;
+    other.head = other.count = other.cap = 0;
+}
+
+template <typename T>
+Queue<T>& Queue<T>::operator=(Queue&& other) noexcept {
+    if (this != &other) {
+        release();
+        items = other.items;
+        head = other.head;
+        count = other.count;
+        cap = other.cap;
+        other.items = nullptr;
+        other.head = other.count = other.cap = 0;
+    }
+    return *this;
+}
 
 /**
  * @brief Adds an element to the end of the queue.
  * @param data The data to be added to the queue.
- * @note Uses addToEnd function from `DoublyLinkedList` to maintain queue order.
+ * @note Amortized O(1); only allocates when the ring buffer is full.
  */
 template <typename T>
 void Queue<T>::enqueue(const T& data) {
-    list.addToEnd(data); // Adds to the end to represent the rear of the queue.
+    if (count == cap) {
+        T copy(data); // `data` may live inside the buffer that is about to move
+        grow(count + 1);
+        new (items + slot(count)) T(std::move(copy));
+    } else {
+        new (items + slot(count)) T(data);
+    }
+    ++count;
+}
+
+template <typename T>
+void Queue<T>::enqueue(T&& data) {
+    if (count == cap) {
+        T moved(std::move(data));
+        grow(count + 1);
+        new (items + slot(count)) T(std::move(moved));
+    } else {
+        new (items + slot(count)) T(std::move(data));
+    }
+    ++count;
 }
 
 /**
  * @brief Removes the front element from the queue.
  * @return True if the dequeue was successful, false if queue was empty.
- * @note Uses deleteNode to remove the head element, simulating queue dequeue.
+ * @note O(1): destroys the front slot and advances the head index.
  */
 template <typename T>
 bool Queue<T>::dequeue() {
-    if (!isEmpty()) {
-        T frontData = list.head->data; // Get data at the front of the queue
-        list.deleteNode(frontData);     // Delete the first node
-        return true;
-    }
-    return false; // Queue was empty
+    if (isEmpty()) return false; // Queue was empty
+    items[head].~T();
+    head = (head + 1) & (cap - 1);
+    --count;
+    return true;
+}
+
+/**
+ * @brief Moves the front element out and removes it; works for move-only element types.
+ * @param out Receives the front element.
+ * @return True if an element was dequeued, false if the queue was empty (`out` is untouched).
+ */
+template <typename T>
+bool Queue<T>::dequeue(T& out) {
+    if (isEmpty()) return false;
+    out = std::move(items[head]);
+    return dequeue();
 }
 
 /**
  * @brief Returns the front element without removing it.
  * @return The front element of the queue.
- * @note Accesses the first element in the list to simulate queue peek.
+ * @note Returns a default-constructed value if the queue is empty.
  */
 template <typename T>
 T Queue<T>::peek() const {
     if (!isEmpty()) {
-        return list.head->data; // Access the first element as the front
+        return items[head];
     }
     return T(); // Return default value if queue is empty
 }
 
+template <typename T>
+T& Queue<T>::front() {
+    return items[head];
+}
+
+/**
+ * @brief Appends `batchCount` elements read from `first`, growing the buffer at most once.
+ * @param first Start of the elements; wrap it in std::make_move_iterator to move rather than copy.
+ * @param batchCount Number of elements to append.
+ * @note Trivially copyable elements read from a `T*` are copied with at most two memcpy calls, one on
+ *       each side of the wrap-around point. Pointers to any other type (e.g. `int*` into a
+ *       `Queue<double>`) are converted element by element.
+ */
+template <typename T>
+template <typename Iterator>
+void Queue<T>::enqueueBatch(Iterator first, std::size_t batchCount) {
+    if (batchCount == 0) return;
+    if (count + batchCount > cap) grow(count + batchCount);
+    std::size_t tail = slot(count);
+    if constexpr (std::is_trivially_copyable_v<T> && std::is_pointer_v<Iterator> &&
+                  std::is_same_v<std::remove_cv_t<std::remove_pointer_t<Iterator>>, T>) {
+        std::size_t firstPart = cap - tail < batchCount ? cap - tail : batchCount;
+        std::memcpy(items + tail, first, firstPart * sizeof(T));
+        std::memcpy(items, first + firstPart, (batchCount - firstPart) * sizeof(T));
+    } else {
+        for (std::size_t i = 0; i < batchCount; ++i, ++first) {
+            new (items + ((tail + i) & (cap - 1))) T(*first);
+        }
+    }
+    count += batchCount;
+}
+
+/**
+ * @brief Moves up to `maxCount` elements from the front into `out` and removes them.
+ * @param out Destination of at least `maxCount` constructed elements, which are assigned to.
+ * @param maxCount Maximum number of elements to take.
+ * @return The number of elements dequeued.
+ */
+template <typename T>
+std::size_t Queue<T>::dequeueBatch(T* out, std::size_t maxCount) {
+    std::size_t taken = count < maxCount ? count : maxCount;
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        std::size_t firstPart = cap - head < taken ? cap - head : taken;
+        if (taken) {
+            std::memcpy(out, items + head, firstPart * sizeof(T));
+            std::memcpy(out + firstPart, items, (taken - firstPart) * sizeof(T));
+        }
+    } else {
+        for (std::size_t i = 0; i < taken; ++i) {
+            T& item = items[slot(i)];
+            out[i] = std::move(item);
+            item.~T();
+        }
+    }
+    if (taken) head = slot(taken);
+    count -= taken;
+    return taken;
+}
+
 /**
  * @brief Checks if the queue is empty.
  * @return True if empty, false otherwise.
- * @note Uses head pointer to determine if the list is empty.
  */
 template <typename T>
 bool Queue<T>::isEmpty() const {
-    return list.head == nullptr;
+    return count == 0;
+}
+
+template <typename T>
+std::size_t Queue<T>::size() const {
+    return count;
+}
+
+template <typename T>
+std::size_t Queue<T>::capacity() const {
+    return cap;
+}
+
+template <typename T>
+void Queue<T>::reserve(std::size_t newCapacity) {
+    if (newCapacity > cap) grow(newCapacity);
+}
+
+template <typename T>
+void Queue<T>::clear() {
+    while (dequeue()) {}
+    head = 0;
+}
+
+/**
+ * @brief Moves the elements, front first, into a larger ring buffer.
+ * @param minCapacity The minimum number of elements the new buffer must hold.
+ * @note Capacity doubles (and stays a power of two, so wrapping is a mask) so that a sequence of
+ *       enqueues costs amortized O(1).
+ */
+template <typename T>
+void Queue<T>::grow(std::size_t minCapacity) {
+    std::size_t newCapacity = cap ? cap * 2 : MinCapacity;
+    while (newCapacity < minCapacity) newCapacity *= 2;
+
+    T* newData = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+    for (std::size_t i = 0; i < count; ++i) {
+        T& item = items[slot(i)];
+        new (newData + i) T(std::move(item));
+        item.~T();
+    }
+    ::operator delete(items);
+
+    items = newData;
+    head = 0;
+    cap = newCapacity;
+}
+
+template <typename T>
+void Queue<T>::release() {
+    clear();
+    ::operator delete(items);
+    items = nullptr;
+    cap = 0;
 }
 
 #endif // QUEUE_H
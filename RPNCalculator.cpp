@@ -7,99 +7,140 @@
 
 
 #include "RPNCalculator.h"
+#include "ExpressionCache.h"
+#include "Instrumentation.h"
+#include "NumberParser.h"
+#include "OperandStack.h"
+
+#include <cmath>
 
 /**
  * @brief Custom function to convert a C-string to a double.
  * @param str The input C-string representing a numeric value.
  * @param success A reference to a boolean variable to indicate success or failure.
  * @return The converted double value, or 0.0 if the conversion fails.
+ * @note Kept for existing callers; the conversion itself is `parseDouble`.
  */
 double stringToDouble(const char* str, bool& success) {
-    double result = 0.0;
-    bool isNegative = false;
-    success = true;
-    int i = 0;
-    double decimalPlace = 0.1;
-
-    // Check for a negative sign at the beginning
-    if (str[i] == '-') {
-        isNegative = true;
-        i++;
+    double value = 0.0;
+    success = parseDouble(std::string_view(str), value);
+    return success ? value : 0.0;
+}
+
+/**
+ * @brief `nextToken`, timed and counted as the tokenize phase.
+ */
+static bool nextTimedToken(std::string_view expression, std::size_t& pos, std::string_view& token) {
+    RPN_TIME_PHASE(Phase::Tokenize);
+    if (!nextToken(expression, pos, token)) return false;
+    RPN_COUNT(Counter::Tokens, 1);
+    return true;
+}
+
+/**
+ * @brief Parses and evaluates a single token: a number, a function, a variable or an operator.
+ * @param token The token to parse and evaluate (a view into the expression).
+ * @param stack The operand stack.
+ * @param errorCode Error code that stops the evaluation (0 for success, non-zero for errors).
+ *        1 - Insufficient operands or an invalid token
+ *        3 - Division by a literal zero
+ *        6 - A fixed scratch stack is full
+ * @param pendingError Error reported only if the whole expression is well formed: 1 once a variable
+ *        is seen (it is unbound), else 3 after a division by a computed zero, as `run` would report them.
+ * @param topIsLiteral True while the top value is a numeric literal.
+ * @note This function uses `parseDouble` to convert tokens to numbers and performs basic arithmetic operations.
+ */
+template <typename Operands>
+static void evaluateToken(std::string_view token, Operands& stack, int& errorCode, int& pendingError, bool& topIsLiteral) {
+    double num = 0.0;
+
+    if (parseDouble(token, num)) {
+        // Token is a valid number, push to stack
+        if (!pushOperand(stack, num)) errorCode = EvaluationScratch::StackExhausted;
+        topIsLiteral = true;
+        return;
     }
+    const bool literalOperand = topIsLiteral;
+    topIsLiteral = false;
 
-    // Process integer part
-    while (str[i] != '\0' && str[i] != '.') {
-        if (str[i] < '0' || str[i] > '9') {
-            success = false;
-            return 0.0;
+    if (Function function; lookupFunction(token.data(), token.size(), function)) {
+        // Token names a built-in function, apply it to the values before it
+        int arity = functionArity(function);
+        if (stack.size() < static_cast<std::size_t>(arity)) {
+            errorCode = 1; // Insufficient operands
+            return;
         }
-        result = result * 10 + (str[i] - '0');
-        i++;
-    }
+        double operand2 = 0.0;
+        if (arity == 2) {
+            operand2 = stack.top();
+            stack.pop_back();
+        }
+        stack.top() = callFunction(function, stack.top(), operand2);
+    } else if (isIdentifierStart(token[0])) {
+        // Any other name is a variable, which `compile` accepts and `run` leaves unbound
+        for (char c : token) {
+            if (!isIdentifierChar(c)) {
+                errorCode = 1; // Invalid token
+                return;
+            }
+        }
+        pendingError = 1;
+        if (!pushOperand(stack, 0.0)) errorCode = EvaluationScratch::StackExhausted;
+    } else {
+        // Anything else must be a single-character operator, as in `compile`
+        OpCode op;
+        if (token.size() != 1 || !operatorToOpCode(token[0], op)) {
+            errorCode = 1; // Invalid token
+            return;
+        }
+        if (stack.size() < 2) {
+            errorCode = 1; // Insufficient operands
+            return;
+        }
+        double operand2 = stack.top();
+        stack.pop_back();
+        double& operand1 = stack.top();
 
-    // Process decimal part if any
-    if (str[i] == '.') {
-        i++;
-        while (str[i] != '\0') {
-            if (str[i] < '0' || str[i] > '9') {
-                success = false;
-                return 0.0;
+        switch (op) {
+        case OpCode::Add: operand1 += operand2; break;
+        case OpCode::Sub: operand1 -= operand2; break;
+        case OpCode::Mul: operand1 *= operand2; break;
+        case OpCode::Div:
+            if (operand2 == 0) {
+                if (literalOperand) {
+                    errorCode = 3; // Division by a literal zero, which `compile` rejects
+                    return;
+                }
+                if (pendingError == 0) pendingError = 3; // Division by a computed zero
             }
-            result += (str[i] - '0') * decimalPlace;
-            decimalPlace *= 0.1;
-            i++;
+            operand1 /= operand2;
+            break;
+        default: operand1 = std::pow(operand1, operand2); break;
         }
     }
-
-    return isNegative ? -result : result;
 }
 
 /**
- * @brief Constructor for RPNCalculator.
- */
-RPNCalculator::RPNCalculator() {}
-
-/**
- * @brief Evaluates an RPN expression and returns the result.
- * @param expression The RPN expression to evaluate, e.g., "3 2 5 * +".
+ * @brief Evaluates an RPN expression token by token.
+ * @param expression The RPN expression.
+ * @param stack The operand stack; emptied first, so operands left by an earlier failed call are ignored.
  * @param errorCode Error code (0 for success, non-zero for errors).
- *        1 - Insufficient operands
- *        2 - Too many operands
- *        3 - Division by zero
  * @return The result of the evaluation, or 0 in case of error.
- * @note Manually parses tokens without any standard library functions.
+ * @note Reports the same error as `compile` followed by `run` on every input: malformed expressions
+ *       and division by a literal zero first, then unbound variables, then division by a computed zero.
  */
-double RPNCalculator::evaluate(const char* expression, int& errorCode) {
+template <typename Operands>
+static double evaluateTokens(std::string_view expression, Operands& stack, int& errorCode) {
     errorCode = 0;
-    const char* ptr = expression;
-
-    // Temporary buffer to store each token
-    char token[32];
-    int tokenIndex = 0;
-
-    while (*ptr != '\0') {
-        // Skip whitespace
-        if (*ptr == ' ') {
-            if (tokenIndex > 0) {
-                token[tokenIndex] = '\0';
-                parseAndEvaluateToken(token, errorCode);
-                if (errorCode != 0) return 0.0; // Early exit on error
-                tokenIndex = 0; // Reset token
-            }
-        } else {
-            // Collect characters into the token buffer
-            if (tokenIndex < 31) {
-                token[tokenIndex++] = *ptr;
-            }
-        }
-        ptr++;
-    }
+    stack.clear();
+    int pendingError = 0;
+    bool topIsLiteral = false;
+    std::size_t pos = 0;
+    std::string_view token;
 
-    // Evaluate the last token if any
-    if (tokenIndex > 0) {
-        token[tokenIndex] = '\0';
-        parseAndEvaluateToken(token, errorCode);
-        if (errorCode != 0) return 0.0;
+    while (nextTimedToken(expression, pos, token)) {
+        evaluateToken(token, stack, errorCode, pendingError, topIsLiteral);
+        if (errorCode != 0) return 0.0; // Early exit on error
     }
 
     // The final result should be the only item left in the stack
@@ -108,8 +149,8 @@ double RPNCalculator::evaluate(const char* expression, int& errorCode) {
         return 0.0;
     }
 
-    double result = stack.peek();
-    stack.pop();
+    double result = stack.top();
+    stack.pop_back();
 
     // If stack is not empty, there were too many operands
     if (!stack.isEmpty()) {
@@ -117,56 +158,264 @@ double RPNCalculator::evaluate(const char* expression, int& errorCode) {
         return 0.0;
     }
 
+    errorCode = pendingError;
+    return errorCode == 0 ? result : 0.0;
+}
+
+/**
+ * @brief Runs a compiled Program's instructions.
+ * @param program A Program without a compile error.
+ * @param variables Values for the program's variable slots.
+ * @param stack An empty operand stack with room for `program.maxDepth` values.
+ * @param errorCode Set to 3 on division by zero.
+ * @return The result of the program, or 0 in case of error.
+ * @note Stack depth was validated by the compiler, so operators pop without checks.
+ */
+template <typename Operands>
+static double execute(const Program& program, const double* variables, Operands& stack, int& errorCode) {
+    const double* constants = program.constants.data();
+    for (const Instruction& ins : program.code) {
+        switch (ins.op) {
+        case OpCode::PushConst:
+            stack.push(constants[ins.operand]);
+            continue;
+        case OpCode::PushVar:
+            stack.push(variables[ins.operand]);
+            continue;
+        case OpCode::Neg:
+            stack.top() = -stack.top();
+            continue;
+        case OpCode::Call1:
+            stack.top() = callFunction(static_cast<Function>(ins.operand), stack.top(), 0.0);
+            continue;
+        default:
+            break;
+        }
+
+        double operand2 = stack.top();
+        stack.pop_back();
+        double& operand1 = stack.top();
+
+        switch (ins.op) {
+        case OpCode::Add: operand1 += operand2; break;
+        case OpCode::Sub: operand1 -= operand2; break;
+        case OpCode::Mul: operand1 *= operand2; break;
+        case OpCode::Div:
+            if (operand2 == 0) {
+                errorCode = 3; // Division by zero
+                stack.clear();
+                return 0.0;
+            }
+            operand1 /= operand2;
+            break;
+        case OpCode::Pow: operand1 = std::pow(operand1, operand2); break;
+        case OpCode::Call2: operand1 = callFunction(static_cast<Function>(ins.operand), operand1, operand2); break;
+        default: break;
+        }
+    }
+
+    double result = stack.top();
+    stack.pop_back();
     return result;
 }
 
 /**
- * @brief Parses and evaluates a single token, either an operator or a number.
- * @param token The token to parse and evaluate.
+ * @brief Constructor for RPNCalculator.
+ */
+RPNCalculator::RPNCalculator() {}
+
+/**
+ * @brief Evaluates an RPN expression and returns the result.
+ * @param expression The RPN expression to evaluate, e.g., "3 2 5 * +".
  * @param errorCode Error code (0 for success, non-zero for errors).
  *        1 - Insufficient operands
+ *        2 - Too many operands
  *        3 - Division by zero
- * @note This function uses `stringToDouble` to convert tokens to numbers and performs basic arithmetic operations.
+ * @return The result of the evaluation, or 0 in case of error.
+ * @note Manually parses tokens without any standard library functions.
  */
-void RPNCalculator::parseAndEvaluateToken(const char* token, int& errorCode) {
-    bool success = false;
-    double num = stringToDouble(token, success);
+double RPNCalculator::evaluate(const char* expression, int& errorCode) {
+    return evaluate(std::string_view(expression), errorCode);
+}
 
-    if (success) {
-        // Token is a valid number, push to stack
-        stack.push(num);
-    } else {
-        // Token is not a number, assume it's an operator
-        if (stack.isEmpty()) {
-            errorCode = 1; // Insufficient operands
-            return;
-        }
-        double operand2 = stack.peek();
-        stack.pop();
+/**
+ * @brief Evaluates an RPN expression held in a string view.
+ * @param expression The RPN expression; tokens are read in place, so they can be any length.
+ * @param errorCode Error code (0 for success, non-zero for errors).
+ * @return The result of the evaluation, or 0 in case of error.
+ * @note With a cache set, a hit returns the stored result; a miss compiles and runs the expression
+ *       and stores the outcome.
+ */
+double RPNCalculator::evaluate(std::string_view expression, int& errorCode) {
+    RPN_EVALUATION_SCOPE(errorCode);
+    if (cache != nullptr) {
+        double value = 0.0;
+        if (cache->findValue(expression, Notation::RPN, value, errorCode)) return value;
 
-        if (stack.isEmpty()) {
-            errorCode = 1; // Insufficient operands
-            return;
+        Program program;
+        compile(expression, program);
+        value = run(program, errorCode);
+        cache->insert(expression, Notation::RPN, program, value, errorCode);
+        return value;
+    }
+
+    RPN_TIME_PHASE(Phase::Execute);
+    return evaluateTokens(expression, stack, errorCode);
+}
+
+/**
+ * @brief Evaluates an RPN expression without touching the calculator's state.
+ * @param expression The RPN expression; tokens are read in place, so they can be any length.
+ * @param scratch Caller-owned operand stack; one per thread.
+ * @return The value and error code: 1-3 as for the other overloads, or 6 if the expression needs
+ *         more operands than `scratch` holds.
+ * @note Reentrant and allocation-free: any number of threads may call this on one calculator at
+ *       once. The cache is not consulted, because filling it allocates.
+ */
+EvaluationResult RPNCalculator::evaluate(std::string_view expression, EvaluationScratch& scratch) const {
+    EvaluationResult result;
+    RPN_EVALUATION_SCOPE(result.errorCode);
+    RPN_TIME_PHASE(Phase::Execute);
+    result.value = evaluateTokens(expression, scratch, result.errorCode);
+    return result;
+}
+
+/**
+ * @brief Compiles an RPN expression into a reusable Program.
+ * @param expression The RPN expression to compile, e.g., "3 2 5 * +".
+ * @return The compiled Program; its `errorCode` is non-zero if the expression can never evaluate.
+ */
+Program RPNCalculator::compile(const char* expression) {
+    Program program;
+    compile(expression, program);
+    return program;
+}
+
+/**
+ * @brief Compiles an RPN expression into an existing Program.
+ * @param expression The RPN expression to compile.
+ * @param program Receives the instructions; its storage is reused.
+ * @note Detects insufficient/too many operands and division by a literal zero without running anything.
+ *       Names of built-in functions (e.g. "sqrt", "max") are calls on the values before them; any other
+ *       name (e.g. "x", "rate_2") becomes a variable, bound when the Program runs.
+ */
+void RPNCalculator::compile(const char* expression, Program& program) {
+    compile(std::string_view(expression), program);
+}
+
+/**
+ * @brief Compiles an RPN expression held in a string view into an existing Program.
+ * @param expression The RPN expression; tokens are read in place, so they can be any length.
+ * @param program Receives the instructions; its storage is reused.
+ */
+void RPNCalculator::compile(std::string_view expression, Program& program) {
+    RPN_TIME_PHASE(Phase::Convert);
+    RPN_COUNT_GROWTH(program.code);
+    RPN_COUNT_GROWTH(program.constants);
+    RPN_COUNT_GROWTH(program.variables);
+    ProgramBuilder builder(program);
+    std::size_t pos = 0;
+    std::string_view token;
+
+    while (nextTimedToken(expression, pos, token)) {
+        double num = 0.0;
+        if (parseDouble(token, num)) {
+            builder.pushConstant(num);
+            continue;
         }
-        double operand1 = stack.peek();
-        stack.pop();
-
-        double result = 0.0;
-        if (*token == '+') result = operand1 + operand2;
-        else if (*token == '-') result = operand1 - operand2;
-        else if (*token == '*') result = operand1 * operand2;
-        else if (*token == '/') {
-            if (operand2 == 0) {
-                errorCode = 3; // Division by zero
+
+        if (isIdentifierStart(token[0])) {
+            std::size_t length = 1;
+            while (length < token.size() && isIdentifierChar(token[length])) length++;
+            if (length != token.size()) {
+                builder.fail(1); // Invalid token
                 return;
             }
-            result = operand1 / operand2;
-        } else {
-            errorCode = 1; // Invalid token
+
+            Function function;
+            if (lookupFunction(token.data(), length, function)) {
+                if (!builder.applyFunction(function)) return;
+            } else {
+                builder.pushVariable(token.data(), length);
+            }
+            continue;
+        }
+
+        OpCode op;
+        if (token.size() != 1 || !operatorToOpCode(token[0], op)) {
+            builder.fail(1); // Invalid token
             return;
         }
+        if (!builder.applyOperator(op)) return;
+    }
+    builder.finish();
+}
+
+/**
+ * @brief Runs a compiled Program that has no variables.
+ * @param program A Program produced by `compile`.
+ * @param errorCode Error code (0 for success, non-zero for errors).
+ * @return The result of the program, or 0 in case of error.
+ */
+double RPNCalculator::run(const Program& program, int& errorCode) {
+    return run(program, nullptr, errorCode);
+}
+
+/**
+ * @brief Runs a compiled Program.
+ * @param program A Program produced by `compile`.
+ * @param variables Values for the program's variable slots, in `program.variables` order.
+ * @param errorCode Error code (0 for success, non-zero for errors).
+ *        1 - Insufficient operands (compile time) or unbound variables
+ *        2 - Too many operands (compile time)
+ *        3 - Division by zero
+ * @return The result of the program, or 0 in case of error.
+ * @note Stack depth was validated by the compiler, so operators pop without checks.
+ */
+double RPNCalculator::run(const Program& program, const double* variables, int& errorCode) {
+    RPN_EVALUATION_SCOPE(errorCode);
+    RPN_TIME_PHASE(Phase::Execute);
+    errorCode = program.errorCode;
+    if (errorCode != 0) return 0.0;
+    if (variables == nullptr && !program.variables.empty()) {
+        errorCode = 1; // Unbound variables
+        return 0.0;
+    }
 
-        // Push the result back onto the stack
-        stack.push(result);
+    stack.clear();
+    RPN_COUNT(Counter::Allocations, stack.capacity() < static_cast<std::size_t>(program.maxDepth) ? 1 : 0);
+    RPN_RECORD_STACK_DEPTH(static_cast<std::size_t>(program.maxDepth));
+    stack.reserve(static_cast<std::size_t>(program.maxDepth));
+
+    return execute(program, variables, stack, errorCode);
+}
+
+/**
+ * @brief Runs a compiled Program without touching the calculator's state.
+ * @param program A Program produced by `compile`.
+ * @param variables Values for the program's variable slots, or null if it has none.
+ * @param scratch Caller-owned operand stack; one per thread.
+ * @return The value and error code: 1-3 as for the other overloads, or 6 if `program.maxDepth`
+ *         exceeds the scratch's capacity (checked once, before running).
+ * @note Reentrant and allocation-free.
+ */
+EvaluationResult RPNCalculator::run(const Program& program, const double* variables, EvaluationScratch& scratch) const {
+    EvaluationResult result;
+    RPN_EVALUATION_SCOPE(result.errorCode);
+    RPN_TIME_PHASE(Phase::Execute);
+    result.errorCode = program.errorCode;
+    if (result.errorCode != 0) return result;
+    if (variables == nullptr && !program.variables.empty()) {
+        result.errorCode = 1; // Unbound variables
+        return result;
+    }
+    if (static_cast<std::size_t>(program.maxDepth) > scratch.capacity()) {
+        result.errorCode = EvaluationScratch::StackExhausted;
+        return result;
     }
+
+    scratch.clear();
+    RPN_RECORD_STACK_DEPTH(static_cast<std::size_t>(program.maxDepth));
+    result.value = execute(program, variables, scratch, result.errorCode);
+    return result;
 }
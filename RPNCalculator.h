@@ -9,18 +9,39 @@
 #ifndef RPNCALCULATOR_H
 #define RPNCALCULATOR_H
 
+#include "EvaluationScratch.h"
+#include "Program.h"
 #include "Stack.h"
 
+#include <string_view>
+
+class ExpressionCache;
+
+double stringToDouble(const char* str, bool& success); ///< Converts a numeric token to a double.
+
 class RPNCalculator {
 public:
     RPNCalculator(); ///< Constructor initializes an empty RPN calculator.
     
     double evaluate(const char* expression, int& errorCode); ///< Evaluates an RPN expression and returns the result.
+    double evaluate(std::string_view expression, int& errorCode); ///< Evaluates an RPN expression held in a string view.
+
+    static Program compile(const char* expression); ///< Compiles an RPN expression into a reusable Program.
+    static void compile(const char* expression, Program& program); ///< Compiles into an existing Program, reusing its storage.
+    static void compile(std::string_view expression, Program& program); ///< Compiles an expression held in a string view.
+    double run(const Program& program, int& errorCode); ///< Runs a compiled Program without parsing or allocating.
+    double run(const Program& program, const double* variables, int& errorCode); ///< Runs a Program with values for its variable slots.
+
+    EvaluationResult evaluate(std::string_view expression, EvaluationScratch& scratch) const; ///< Reentrant evaluation with operands in `scratch`; never allocates.
+    EvaluationResult run(const Program& program, const double* variables, EvaluationScratch& scratch) const; ///< Reentrant run with operands in `scratch`; never allocates.
+
+    void setCache(ExpressionCache* expressionCache) { cache = expressionCache; } ///< Opts in to caching results (null turns it off).
+    ExpressionCache* getCache() const { return cache; } ///< Returns the cache in use, or null.
     
 private:
-    Stack<double> stack; ///< Stack to hold operands for RPN calculations.
+    ExpressionCache* cache = nullptr; ///< Shared, thread-safe result cache; not owned.
 
-    void parseAndEvaluateToken(const char* token, int& errorCode); ///< Parses and evaluates a single token.
+    Stack<double, 32> stack; ///< Contiguous operand stack; keeps its capacity between evaluations.
 };
 
 #endif // RPNCALCULATOR_H
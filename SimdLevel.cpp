@@ -0,0 +1,22 @@
+//##################################################
+// File: SimdLevel.cpp
+// Description: Detects the widest instruction set the running CPU supports.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "SimdLevel.h"
+
+/**
+ * @brief Detects the widest kernel set the running CPU supports.
+ * @return AVX2 or SSE2 on x86-64, Scalar elsewhere.
+ */
+SimdLevel detectSimdLevel() {
+#if defined(__x86_64__)
+    static const SimdLevel level = __builtin_cpu_supports("avx2") ? SimdLevel::AVX2 : SimdLevel::SSE2;
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
@@ -0,0 +1,24 @@
+//##################################################
+// File: SimdLevel.h
+// Description: Instruction-set levels shared by the SIMD column kernels and the word tokenizer.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef SIMDLEVEL_H
+#define SIMDLEVEL_H
+
+/**
+ * @brief Instruction sets the SIMD kernels can run on.
+ */
+enum class SimdLevel {
+    Auto,   ///< Best level supported by the running CPU.
+    Scalar, ///< Portable one-element-at-a-time loops.
+    SSE2,   ///< 128-bit vectors.
+    AVX2    ///< 256-bit vectors.
+};
+
+SimdLevel detectSimdLevel(); ///< Returns the best level supported by the running CPU.
+
+#endif // SIMDLEVEL_H
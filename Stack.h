@@ -1,6 +1,6 @@
 //##################################################
 // File: Stack.h
-// Description: A Stack class implemented using a doubly linked list.
+// Description: A Stack class backed by a contiguous buffer with inline small-buffer storage.
 // Date: Nov,10 2024
 //##################################################
 
@@ -9,50 +9,116 @@
 #ifndef STACK_H
 #define STACK_H
 
-#include "DoublyLinkedList.h"
+#include <cstddef>
+#include <new>
+#include <utility>
 
-template <typename T>
+template <typename T, std::size_t InlineCapacity = 16>
 class Stack {
 public:
-    Stack();                    ///< Constructor initializes an empty stack.
-    ~Stack();                   ///< Destructor cleans up stack.
+    Stack();                    ///< Constructor initializes an empty stack using the inline buffer.
+    ~Stack();                   ///< Destructor destroys remaining elements and releases heap storage.
+
+    Stack(const Stack& other);              ///< Copies the elements of another stack.
+    Stack& operator=(const Stack& other);   ///< Replaces the contents with a copy of another stack.
 
     void push(const T& data);   ///< Pushes an element onto the stack.
+    void push(T&& data);        ///< Pushes an element onto the stack by moving it.
     bool pop();                 ///< Removes the top element from the stack.
     T peek() const;             ///< Returns the top element without removing it.
 
+    T& top();                   ///< Returns a reference to the top element (stack must not be empty).
+    const T& top() const;       ///< Returns a const reference to the top element (stack must not be empty).
+    void pop_back();            ///< Removes the top element (stack must not be empty).
+
     bool isEmpty() const;       ///< Checks if the stack is empty.
+    std::size_t size() const;   ///< Returns the number of elements on the stack.
+    std::size_t capacity() const; ///< Returns the number of elements that fit without reallocating.
+    void reserve(std::size_t newCapacity); ///< Grows storage to hold at least `newCapacity` elements.
+    void clear();               ///< Removes all elements, keeping the allocated storage.
 
 private:
-    DoublyLinkedList<T> list;   ///< The underlying doubly linked list for stack storage.
+    T* items;                   ///< Points at the inline buffer or at the heap buffer once grown.
+    std::size_t count;          ///< Number of live elements.
+    std::size_t cap;            ///< Capacity of the buffer `items` points at.
+    alignas(T) unsigned char inlineBuffer[InlineCapacity * sizeof(T)]; ///< Inline storage used until the stack outgrows it.
+
+    T* inlineData() { return reinterpret_cast<T*>(inlineBuffer); }
+    bool isInline() const { return items == reinterpret_cast<const T*>(inlineBuffer); }
+    void grow(std::size_t minCapacity);
 };
 
-template <typename T>
-Stack<T>::Stack() {}
+template <typename T, std::size_t InlineCapacity>
+Stack<T, InlineCapacity>::Stack() : items(inlineData()), count(0), cap(InlineCapacity) {
+    static_assert(InlineCapacity > 0, "Stack requires a non-zero inline capacity");
+}
+
+template <typename T, std::size_t InlineCapacity>
+Stack<T, InlineCapacity>::~Stack() {
+    clear();
+    if (!isInline()) ::operator delete(items);
+}
+
+template <typename T, std::size_t InlineCapacity>
+Stack<T, InlineCapacity>::Stack(const Stack& other) : Stack() {
+    reserve(other.count);
+    for (std::size_t i = 0; i < other.count; ++i) {
+        new (items + i) T(other.items[i]);
+    }
+    count = other.count;
+}
 
-template <typename T>
-Stack<T>::~Stack() {}
+template <typename T, std::size_t InlineCapacity>
+Stack<T, InlineCapacity>& Stack<T, InlineCapacity>::operator=(const Stack& other) {
+    if (this != &other) {
+        clear();
+        reserve(other.count);
+        for (std::size_t i = 0; i < other.count; ++i) {
+            new (items + i) T(other.items[i]);
+        }
+        count = other.count;
+    }
+    return *this;
+}
 
 /**
  * @brief Pushes an element onto the stack.
  * @param data The data to push.
- * @note Uses `addToEnd` function from `DoublyLinkedList` as per lecture material.
+ * @note Amortized O(1); only allocates when the stack outgrows its current buffer.
  */
-template <typename T>
-void Stack<T>::push(const T& data) {
-    list.addToEnd(data);
+template <typename T, std::size_t InlineCapacity>
+void Stack<T, InlineCapacity>::push(const T& data) {
+    if (count == cap) {
+        T copy(data); // `data` may live inside the buffer that is about to move
+        grow(count + 1);
+        new (items + count) T(std::move(copy));
+    } else {
+        new (items + count) T(data);
+    }
+    ++count;
+}
+
+template <typename T, std::size_t InlineCapacity>
+void Stack<T, InlineCapacity>::push(T&& data) {
+    if (count == cap) {
+        T moved(std::move(data));
+        grow(count + 1);
+        new (items + count) T(std::move(moved));
+    } else {
+        new (items + count) T(std::move(data));
+    }
+    ++count;
 }
 
 /**
  * @brief Removes the top element from the stack.
  * @return True if the pop was successful, false if stack was empty.
- * @note Uses `deleteNode` to remove the last element, as outlined in lecture material.
+ * @note O(1): destroys the last element of the buffer instead of searching the list for a matching value.
  */
-template <typename T>
-bool Stack<T>::pop() {
+template <typename T, std::size_t InlineCapacity>
+bool Stack<T, InlineCapacity>::pop() {
     if (!isEmpty()) {
-        T topData = list.getTail()->data;
-        list.deleteNode(topData);
+        pop_back();
         return true;
     }
     return false;
@@ -61,24 +127,80 @@ bool Stack<T>::pop() {
 /**
  * @brief Returns the top element without removing it.
  * @return The top element of the stack.
- * @note Uses `getTail` to access the top element, adhering to lecture material.
+ * @note Returns a default-constructed value if the stack is empty.
  */
-template <typename T>
-T Stack<T>::peek() const {
+template <typename T, std::size_t InlineCapacity>
+T Stack<T, InlineCapacity>::peek() const {
     if (!isEmpty()) {
-        return list.getTail()->data;
+        return items[count - 1];
     }
     return T(); // Default return if stack is empty
 }
 
+template <typename T, std::size_t InlineCapacity>
+T& Stack<T, InlineCapacity>::top() {
+    return items[count - 1];
+}
+
+template <typename T, std::size_t InlineCapacity>
+const T& Stack<T, InlineCapacity>::top() const {
+    return items[count - 1];
+}
+
+template <typename T, std::size_t InlineCapacity>
+void Stack<T, InlineCapacity>::pop_back() {
+    --count;
+    items[count].~T();
+}
+
 /**
  * @brief Checks if the stack is empty.
  * @return True if empty, false otherwise.
- * @note Determines if stack is empty by checking if `getHead()` is nullptr, following lecture material.
  */
-template <typename T>
-bool Stack<T>::isEmpty() const {
-    return list.getHead() == nullptr;
+template <typename T, std::size_t InlineCapacity>
+bool Stack<T, InlineCapacity>::isEmpty() const {
+    return count == 0;
+}
+
+template <typename T, std::size_t InlineCapacity>
+std::size_t Stack<T, InlineCapacity>::size() const {
+    return count;
+}
+
+template <typename T, std::size_t InlineCapacity>
+std::size_t Stack<T, InlineCapacity>::capacity() const {
+    return cap;
+}
+
+template <typename T, std::size_t InlineCapacity>
+void Stack<T, InlineCapacity>::reserve(std::size_t newCapacity) {
+    if (newCapacity > cap) grow(newCapacity);
+}
+
+template <typename T, std::size_t InlineCapacity>
+void Stack<T, InlineCapacity>::clear() {
+    while (count > 0) pop_back();
+}
+
+/**
+ * @brief Moves the elements into a larger heap buffer.
+ * @param minCapacity The minimum number of elements the new buffer must hold.
+ * @note Capacity doubles so that a sequence of pushes costs amortized O(1).
+ */
+template <typename T, std::size_t InlineCapacity>
+void Stack<T, InlineCapacity>::grow(std::size_t minCapacity) {
+    std::size_t newCapacity = cap * 2;
+    if (newCapacity < minCapacity) newCapacity = minCapacity;
+
+    T* newData = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+    for (std::size_t i = 0; i < count; ++i) {
+        new (newData + i) T(std::move(items[i]));
+        items[i].~T();
+    }
+    if (!isInline()) ::operator delete(items);
+
+    items = newData;
+    cap = newCapacity;
 }
 
 #endif // STACK_H
@@ -0,0 +1,226 @@
+//##################################################
+// File: WordCount.cpp
+// Description: AVL tree insertion, traversal and the memory-mapped word counter.
+// Date: Nov,10 2024
+//##################################################
+
+
+
+#include "WordCount.h"
+#include "MappedFile.h"
+#include "WordTokenizer.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+// Bytes of the mapping tokenized before the pages behind are released
+const std::size_t ReleaseWindow = 16u << 20;
+
+} // namespace
+
+AVLTree::~AVLTree() {
+    destroy(root);
+}
+
+void AVLTree::destroy(AVLNode* node) {
+    while (node) {
+        destroy(node->left);
+        AVLNode* right = node->right;
+        delete node;
+        node = right;
+    }
+}
+
+// Helper function to get the height of a node
+int AVLTree::height(AVLNode* node) const {
+    return node ? node->height : 0;
+}
+
+// Helper function to calculate the balance factor
+int AVLTree::getBalanceFactor(AVLNode* node) const {
+    return node ? height(node->left) - height(node->right) : 0;
+}
+
+// Right rotation
+AVLNode* AVLTree::rightRotate(AVLNode* y) {
+    AVLNode* x = y->left;
+    AVLNode* T2 = x->right;
+
+    // Perform rotation
+    x->right = y;
+    y->left = T2;
+
+    // Update heights
+    y->height = std::max(height(y->left), height(y->right)) + 1;
+    x->height = std::max(height(x->left), height(x->right)) + 1;
+
+    return x;
+}
+
+// Left rotation
+AVLNode* AVLTree::leftRotate(AVLNode* x) {
+    AVLNode* y = x->right;
+    AVLNode* T2 = y->left;
+
+    // Perform rotation
+    y->left = x;
+    x->right = T2;
+
+    // Update heights
+    x->height = std::max(height(x->left), height(x->right)) + 1;
+    y->height = std::max(height(y->left), height(y->right)) + 1;
+
+    return y;
+}
+
+// Insert helper
+AVLNode* AVLTree::insert(AVLNode* node, const std::string& word) {
+    if (!node)
+        return new AVLNode(word);
+
+    if (word < node->word) {
+        node->left = insert(node->left, word);
+    } else if (word > node->word) {
+        node->right = insert(node->right, word);
+    } else {
+        // Word already exists, increment count
+        node->count++;
+        return node;
+    }
+
+    // Update height
+    node->height = std::max(height(node->left), height(node->right)) + 1;
+
+    // Balance the node
+    int balance = getBalanceFactor(node);
+
+    // Left Left Case
+    if (balance > 1 && word < node->left->word)
+        return rightRotate(node);
+
+    // Right Right Case
+    if (balance < -1 && word > node->right->word)
+        return leftRotate(node);
+
+    // Left Right Case
+    if (balance > 1 && word > node->left->word) {
+        node->left = leftRotate(node->left);
+        return rightRotate(node);
+    }
+
+    // Right Left Case
+    if (balance < -1 && word < node->right->word) {
+        node->right = rightRotate(node->right);
+        return leftRotate(node);
+    }
+
+    return node;
+}
+
+// In-order traversal to print the tree
+void AVLTree::printTree(AVLNode* node, std::ostream& out) const {
+    if (node) {
+        printTree(node->left, out);
+        out << node->word << " - " << node->count << std::endl;
+        printTree(node->right, out);
+    }
+}
+
+void AVLTree::insert(const std::string& word) {
+    root = insert(root, word);
+}
+
+int AVLTree::find(std::string_view word) const {
+    AVLNode* node = root;
+    while (node) {
+        if (word < node->word)
+            node = node->left;
+        else if (word > node->word)
+            node = node->right;
+        else
+            return node->count;
+    }
+    return 0;
+}
+
+// Iterative in-order walk; the views point into the tree's nodes
+std::vector<WordFrequency> AVLTree::sorted() const {
+    std::vector<WordFrequency> words;
+    std::vector<AVLNode*> path;
+    AVLNode* node = root;
+    while (node || !path.empty()) {
+        while (node) {
+            path.push_back(node);
+            node = node->left;
+        }
+        node = path.back();
+        path.pop_back();
+        words.push_back(WordFrequency{ node->word, static_cast<std::uint64_t>(node->count) });
+        node = node->right;
+    }
+    return words;
+}
+
+void AVLTree::printTree() const {
+    printTree(root, std::cout);
+}
+
+void AVLTree::printTree(std::ostream& out) const {
+    printTree(root, out);
+}
+
+void WordCount::addWord(std::string_view text) {
+    if (backend == WordCountBackend::HashTable) {
+        table.add(text);
+    } else {
+        word.assign(text);
+        tree.insert(word);
+    }
+}
+
+// Split text into lowercase words of ASCII letters and digits
+void WordCount::processText(std::string_view text) {
+    tokenizeWords(text, [this](std::string_view found) { addWord(found); });
+}
+
+void WordCount::processLine(const std::string& line) {
+    processText(line);
+}
+
+// Map the file and tokenize it in windows that end between words, releasing pages already counted
+void WordCount::readFile(const std::string& fileName) {
+    MappedFile file;
+    if (!file.open(fileName.c_str())) {
+        std::cerr << "Error opening file: " << fileName << std::endl;
+        return;
+    }
+    file.adviseSequential();
+
+    const char* data = file.data();
+    const std::size_t size = file.size();
+    std::size_t pos = 0;
+    while (pos < size) {
+        std::size_t end = size - pos > ReleaseWindow ? pos + ReleaseWindow : size;
+        while (end < size && isWordByte(data[end])) end++;
+        processText(std::string_view(data + pos, end - pos));
+        file.release(pos, end);
+        pos = end;
+    }
+}
+
+void WordCount::printWordCounts() const {
+    printWordCounts(std::cout);
+}
+
+FrozenWordIndex WordCount::freeze() const {
+    return FrozenWordIndex(backend == WordCountBackend::HashTable ? table.sorted() : tree.sorted());
+}
+
+void WordCount::printWordCounts(std::ostream& out) const {
+    if (backend == WordCountBackend::HashTable)
+        table.print(out);
+    else
+        tree.printTree(out);
+}
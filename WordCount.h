@@ -0,0 +1,86 @@
+//##################################################
+// File: WordCount.h
+// Description: Counts word frequencies in text files using a hash table or an AVL tree keyed by word.
+// Date: Nov,10 2024
+//##################################################
+
+
+
+#ifndef WORDCOUNT_H
+#define WORDCOUNT_H
+
+#include "FrozenWordIndex.h"
+#include "WordTable.h"
+
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Node structure for AVL Tree
+struct AVLNode {
+    std::string word;
+    int count;  // Frequency of the word
+    AVLNode* left;
+    AVLNode* right;
+    int height;
+
+    AVLNode(std::string w, int c = 1) : word(std::move(w)), count(c), left(nullptr), right(nullptr), height(1) {}
+};
+
+// AVL Tree class
+class AVLTree {
+public:
+    AVLTree() : root(nullptr) {}
+    ~AVLTree();                                  ///< Frees every node.
+
+    AVLTree(const AVLTree&) = delete;
+    AVLTree& operator=(const AVLTree&) = delete;
+
+    void insert(const std::string& word);        ///< Adds one occurrence of `word`.
+    int find(std::string_view word) const;       ///< Occurrences of `word` (0 if absent).
+    std::vector<WordFrequency> sorted() const;   ///< Every word with its count, in word order.
+    void printTree() const;                      ///< Prints "word - count" lines in word order.
+    void printTree(std::ostream& out) const;     ///< Writes "word - count" lines in word order to `out`.
+
+private:
+    AVLNode* root;
+
+    int height(AVLNode* node) const;
+    int getBalanceFactor(AVLNode* node) const;
+    AVLNode* rightRotate(AVLNode* y);
+    AVLNode* leftRotate(AVLNode* x);
+    AVLNode* insert(AVLNode* node, const std::string& word);
+    void printTree(AVLNode* node, std::ostream& out) const;
+    static void destroy(AVLNode* node);
+};
+
+// Where WordCount keeps its counts; both print the same output
+enum class WordCountBackend {
+    HashTable,  ///< WordTable: one hash probe per word, sorted only when printed.
+    AVLTree     ///< AVLTree: an ordered tree with one node allocation per distinct word.
+};
+
+// WordCount class
+class WordCount {
+public:
+    explicit WordCount(WordCountBackend backend = WordCountBackend::HashTable) : backend(backend) {}
+
+    void readFile(const std::string& fileName);  ///< Counts every word in a text file.
+    void processLine(const std::string& line);   ///< Counts the words of one line of text.
+    void processText(std::string_view text);     ///< Counts the words of any span of text, line breaks included.
+    void printWordCounts() const;                ///< Prints the counts in word order.
+    void printWordCounts(std::ostream& out) const; ///< Writes the counts in word order to `out`.
+    FrozenWordIndex freeze() const;              ///< Copies the counts into a read-only index for lookups.
+
+private:
+    WordCountBackend backend;
+    AVLTree tree;
+    WordTable table;
+    std::string word;                            ///< Reused key buffer for AVLTree::insert.
+
+    void addWord(std::string_view text);         ///< Counts one lowercase word in the selected backend.
+};
+
+#endif // WORDCOUNT_H
@@ -0,0 +1,203 @@
+//##################################################
+// File: WordTable.cpp
+// Description: String arena, robin-hood probing and sorted output for WordTable.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "WordTable.h"
+#include "Hash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+
+namespace {
+
+const std::size_t MinSlots = 64;
+
+} // namespace
+
+/**
+ * @brief Copies text into the arena.
+ * @param text The bytes to keep.
+ * @return A view of the copy, valid until `clear` or destruction.
+ * @note Text longer than the block size gets a block of its own.
+ */
+std::string_view StringArena::intern(std::string_view text) {
+    if (static_cast<std::size_t>(limit - cursor) < text.size()) {
+        std::size_t size = text.size() > blockSize ? text.size() : blockSize;
+        blocks.emplace_back(new char[size]);
+        cursor = blocks.back().get();
+        limit = cursor + size;
+        reserved += size;
+    }
+    char* copy = cursor;
+    if (!text.empty()) std::memcpy(copy, text.data(), text.size());
+    cursor += text.size();
+    return std::string_view(copy, text.size());
+}
+
+/**
+ * @brief Frees every block; earlier views become dangling.
+ */
+void StringArena::clear() {
+    blocks.clear();
+    cursor = limit = nullptr;
+    reserved = 0;
+}
+
+/**
+ * @brief Hashes a word.
+ * @param word The word.
+ * @return The 64-bit hash; the table keeps the low 32 bits, so callers can partition on the high ones.
+ */
+std::uint64_t WordTable::hashWord(std::string_view word) {
+    return hashText(word);
+}
+
+/**
+ * @brief Adds occurrences of a word.
+ * @param word The word; copied into the arena the first time it is seen.
+ * @param occurrences How many occurrences to add.
+ */
+void WordTable::add(std::string_view word, std::uint64_t occurrences) {
+    addHashed(word, hashWord(word), occurrences);
+}
+
+/**
+ * @brief Adds occurrences of a word whose hash the caller already has.
+ * @param word The word; copied into the arena the first time it is seen.
+ * @param hash `hashWord(word)`.
+ * @param occurrences How many occurrences to add.
+ * @note The lookup gives up at the first slot whose entry is closer to home than the probe is,
+ *       because robin-hood insertion would have placed the word there or earlier.
+ */
+void WordTable::addHashed(std::string_view word, std::uint64_t hash, std::uint64_t occurrences) {
+    if ((used + 1) * 8 > slots.size() * 7) rehash(slots.empty() ? MinSlots : slots.size() * 2);
+    const std::uint32_t low = static_cast<std::uint32_t>(hash);
+    const std::uint32_t length = static_cast<std::uint32_t>(word.size());
+    const std::size_t mask = slots.size() - 1;
+    for (std::size_t index = low & mask, probe = 0;; index = (index + 1) & mask, ++probe) {
+        Slot& slot = slots[index];
+        if (!slot.text || distance(slot, index) < probe) break;
+        if (slot.hash == low && slot.length == length && std::memcmp(slot.text, word.data(), length) == 0) {
+            slot.count += occurrences;
+            return;
+        }
+    }
+    place(Slot{ arena.intern(word).data(), length, low, occurrences });
+    used++;
+}
+
+/**
+ * @brief Adds every count of another table.
+ * @param other The table to merge in; its words are copied into this table's arena as needed.
+ * @note The stored 32-bit hashes are reused, so no word is hashed again.
+ */
+void WordTable::merge(const WordTable& other) {
+    reserve(used + other.used);
+    for (const Slot& slot : other.slots) {
+        if (slot.text) addHashed(std::string_view(slot.text, slot.length), slot.hash, slot.count);
+    }
+}
+
+/**
+ * @brief Sizes the slots so `words` distinct words fit without growing.
+ * @param words Expected number of distinct words.
+ */
+void WordTable::reserve(std::size_t words) {
+    std::size_t slotCount = slots.empty() ? MinSlots : slots.size();
+    while (words * 8 > slotCount * 7) slotCount *= 2;
+    if (slotCount > slots.size()) rehash(slotCount);
+}
+
+/**
+ * @brief Looks up the count of a word.
+ * @param word The word to look up.
+ * @return Its occurrences, or 0 if it was never added.
+ */
+std::uint64_t WordTable::count(std::string_view word) const {
+    if (slots.empty()) return 0;
+    const std::uint32_t hash = static_cast<std::uint32_t>(hashWord(word));
+    const std::size_t mask = slots.size() - 1;
+    for (std::size_t index = hash & mask, probe = 0;; index = (index + 1) & mask, ++probe) {
+        const Slot& slot = slots[index];
+        if (!slot.text || distance(slot, index) < probe) return 0;
+        if (slot.hash == hash && slot.length == word.size() && std::memcmp(slot.text, word.data(), word.size()) == 0) {
+            return slot.count;
+        }
+    }
+}
+
+/**
+ * @brief Inserts an entry whose key is not in the table, displacing entries nearer their home.
+ * @param entry The entry to insert; at least one slot must be free.
+ */
+void WordTable::place(Slot entry) {
+    const std::size_t mask = slots.size() - 1;
+    std::size_t index = entry.hash & mask;
+    std::size_t probe = 0;
+    for (;;) {
+        Slot& slot = slots[index];
+        if (!slot.text) {
+            slot = entry;
+            return;
+        }
+        std::size_t existing = distance(slot, index);
+        if (existing < probe) {
+            std::swap(slot, entry);
+            probe = existing;
+        }
+        index = (index + 1) & mask;
+        probe++;
+    }
+}
+
+/**
+ * @brief Moves every word into a new slot array; the interned text does not move.
+ * @param slotCount The new number of slots, a power of two larger than the number of words.
+ */
+void WordTable::rehash(std::size_t slotCount) {
+    std::vector<Slot> old(slotCount, Slot{ nullptr, 0, 0, 0 });
+    old.swap(slots);
+    for (const Slot& slot : old) {
+        if (slot.text) place(slot);
+    }
+}
+
+/**
+ * @brief Collects every word with its count, sorted by word.
+ * @return The entries in the order `std::string` comparison gives, matching AVLTree's in-order walk.
+ */
+std::vector<WordFrequency> WordTable::sorted() const {
+    std::vector<WordFrequency> entries;
+    entries.reserve(used);
+    for (const Slot& slot : slots) {
+        if (slot.text) entries.push_back(WordFrequency{ std::string_view(slot.text, slot.length), slot.count });
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const WordFrequency& a, const WordFrequency& b) { return a.word < b.word; });
+    return entries;
+}
+
+/**
+ * @brief Writes one "word - count" line per word, in word order.
+ * @param out The stream to write to.
+ */
+void WordTable::print(std::ostream& out) const {
+    for (const WordFrequency& entry : sorted()) {
+        out << entry.word << " - " << entry.count << '\n';
+    }
+    out.flush();
+}
+
+/**
+ * @brief Removes every word and releases the slots and the interned text.
+ */
+void WordTable::clear() {
+    std::vector<Slot>().swap(slots);
+    used = 0;
+    arena.clear();
+}
@@ -0,0 +1,114 @@
+//##################################################
+// File: WordTable.h
+// Description: Word counts in a robin-hood hash table whose keys are interned in a bump arena.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef WORDTABLE_H
+#define WORDTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Append-only string storage carved out of large blocks.
+ * @note One allocation serves thousands of short strings, and the strings sit next to each other
+ *       in memory. Views returned by `intern` stay valid until `clear` or destruction.
+ */
+class StringArena {
+public:
+    explicit StringArena(std::size_t blockSize = 1 << 16) : blockSize(blockSize) {}
+
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    std::string_view intern(std::string_view text); ///< Copies `text` into the arena and returns the copy.
+    void clear();                                   ///< Frees every block.
+    std::size_t bytesReserved() const { return reserved; } ///< Bytes held in blocks, used or not.
+
+private:
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char* cursor = nullptr;
+    char* limit = nullptr;
+    std::size_t blockSize;
+    std::size_t reserved = 0;
+};
+
+/**
+ * @brief A word and its number of occurrences.
+ */
+struct WordFrequency {
+    std::string_view word;
+    std::uint64_t count;
+};
+
+/**
+ * @brief Counts occurrences of words with one hash probe per word.
+ * @note Open addressing with robin-hood displacement: an insert takes the slot of any entry that is
+ *       closer to its home slot than the new one, which keeps probe runs short and lets a lookup stop
+ *       as soon as it passes where the key would have been. Slots carry the hash and the length, so
+ *       the key bytes are compared only on a likely match. Words are copied into a StringArena once,
+ *       when first seen; a repeated word costs a hash and a probe and allocates nothing. The table is
+ *       unordered, and `sorted` sorts only when the counts are printed.
+ */
+class WordTable {
+public:
+    WordTable() = default;
+
+    WordTable(const WordTable&) = delete;
+    WordTable& operator=(const WordTable&) = delete;
+
+    void add(std::string_view word, std::uint64_t occurrences = 1); ///< Adds occurrences of `word`.
+    void addHashed(std::string_view word, std::uint64_t hash, std::uint64_t occurrences = 1); ///< `add` with `hash == hashWord(word)` already computed.
+    void merge(const WordTable& other);                            ///< Adds every count of `other`, reusing its stored hashes.
+    void reserve(std::size_t words);                               ///< Sizes the slots for `words` distinct words.
+    std::uint64_t count(std::string_view word) const;              ///< Occurrences of `word` (0 if never added).
+    std::vector<WordFrequency> sorted() const;                     ///< Every word with its count, in word order.
+    void print(std::ostream& out) const;                           ///< Writes "word - count" lines in word order.
+    void clear();                                                  ///< Removes every word.
+
+    std::size_t size() const { return used; }                      ///< Number of distinct words.
+    std::size_t capacity() const { return slots.size(); }          ///< Number of slots.
+
+    static std::uint64_t hashWord(std::string_view word);          ///< The 64-bit hash the table uses; only the low 32 bits are stored.
+
+    /**
+     * @brief Calls `fn(word, hash, count)` for every word in table order; `hash` is the stored low
+     *        32 bits of `hashWord(word)`, which `addHashed` accepts in place of the full hash.
+     */
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const Slot& slot : slots) {
+            if (slot.text) fn(std::string_view(slot.text, slot.length), slot.hash, slot.count);
+        }
+    }
+
+private:
+    /**
+     * @brief One table slot; `text` is null for an empty slot.
+     */
+    struct Slot {
+        const char* text;
+        std::uint32_t length;
+        std::uint32_t hash;    ///< Low bits pick the home slot.
+        std::uint64_t count;
+    };
+
+    std::vector<Slot> slots;   ///< Power-of-two size, at most 7/8 full.
+    std::size_t used = 0;
+    StringArena arena;
+
+    std::size_t distance(const Slot& slot, std::size_t index) const { ///< Probe distance of an occupied slot from its home.
+        return (index - slot.hash) & (slots.size() - 1);
+    }
+    void place(Slot entry);    ///< Robin-hood insertion of a key known to be absent.
+    void rehash(std::size_t slotCount); ///< Moves every word into `slotCount` slots.
+};
+
+#endif // WORDTABLE_H
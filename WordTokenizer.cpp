@@ -0,0 +1,95 @@
+//##################################################
+// File: WordTokenizer.cpp
+// Description: AVX2/SSE2/scalar kernels that classify 64-byte blocks of text into word and uppercase masks.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "WordTokenizer.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define RPN_X86_SIMD 1
+#endif
+
+namespace {
+
+typedef void (*ClassifyKernel)(const char* data, std::size_t blocks, WordBlockMasks* masks);
+
+void classifyScalar(const char* data, std::size_t blocks, WordBlockMasks* masks) {
+    for (std::size_t b = 0; b < blocks; ++b, data += WordBlockSize) {
+        std::uint64_t word = 0, upper = 0;
+        for (unsigned i = 0; i < WordBlockSize; ++i) {
+            unsigned char c = static_cast<unsigned char>(data[i]);
+            word |= static_cast<std::uint64_t>(isWordByte(data[i])) << i;
+            upper |= static_cast<std::uint64_t>(static_cast<unsigned char>(c - 'A') < 26) << i;
+        }
+        masks[b] = WordBlockMasks{ word, upper };
+    }
+}
+
+#ifdef RPN_X86_SIMD
+// Range tests use signed compares: adding 0x80 - low moves [low, low + n) to [-128, -128 + n)
+inline __m128i inRange(__m128i bytes, char low, char n) {
+    __m128i shifted = _mm_add_epi8(bytes, _mm_set1_epi8(static_cast<char>(0x80 - low)));
+    return _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + n)));
+}
+
+void classifySse2(const char* data, std::size_t blocks, WordBlockMasks* masks) {
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    for (std::size_t b = 0; b < blocks; ++b, data += WordBlockSize) {
+        std::uint64_t word = 0, upper = 0;
+        for (unsigned part = 0; part < 4; ++part) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + part * 16));
+            __m128i letter = inRange(_mm_or_si128(bytes, caseBit), 'a', 26);
+            __m128i isWord = _mm_or_si128(letter, inRange(bytes, '0', 10));
+            word |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(isWord))) << (part * 16);
+            upper |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(inRange(bytes, 'A', 26)))) << (part * 16);
+        }
+        masks[b] = WordBlockMasks{ word, upper };
+    }
+}
+
+__attribute__((target("avx2"))) inline __m256i inRangeAvx2(__m256i bytes, char low, char n) {
+    __m256i shifted = _mm256_add_epi8(bytes, _mm256_set1_epi8(static_cast<char>(0x80 - low)));
+    return _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(-128 + n)), shifted);
+}
+
+__attribute__((target("avx2"))) void classifyAvx2(const char* data, std::size_t blocks, WordBlockMasks* masks) {
+    const __m256i caseBit = _mm256_set1_epi8(0x20);
+    for (std::size_t b = 0; b < blocks; ++b, data += WordBlockSize) {
+        std::uint64_t word = 0, upper = 0;
+        for (unsigned part = 0; part < 2; ++part) {
+            __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + part * 32));
+            __m256i letter = inRangeAvx2(_mm256_or_si256(bytes, caseBit), 'a', 26);
+            __m256i isWord = _mm256_or_si256(letter, inRangeAvx2(bytes, '0', 10));
+            word |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(isWord))) << (part * 32);
+            upper |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(inRangeAvx2(bytes, 'A', 26)))) << (part * 32);
+        }
+        masks[b] = WordBlockMasks{ word, upper };
+    }
+}
+#endif
+
+ClassifyKernel kernelFor(SimdLevel level) {
+    if (level == SimdLevel::Auto) level = detectSimdLevel();
+#ifdef RPN_X86_SIMD
+    if (level == SimdLevel::AVX2 && detectSimdLevel() == SimdLevel::AVX2) return classifyAvx2;
+    if (level == SimdLevel::AVX2 || level == SimdLevel::SSE2) return classifySse2;
+#endif
+    return classifyScalar;
+}
+
+} // namespace
+
+/**
+ * @brief Classifies consecutive 64-byte blocks of text.
+ * @param data The text; `blocks * 64` bytes are read.
+ * @param blocks Number of blocks.
+ * @param masks Receives one WordBlockMasks per block.
+ * @param level Kernel set to use; AVX2 falls back to SSE2 on CPUs without it.
+ */
+void classifyWordBlocks(const char* data, std::size_t blocks, WordBlockMasks* masks, SimdLevel level) {
+    kernelFor(level)(data, blocks, masks);
+}
@@ -0,0 +1,124 @@
+//##################################################
+// File: WordTokenizer.h
+// Description: Splits text into lowercase ASCII words 64 bytes at a time using SIMD byte classification.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef WORDTOKENIZER_H
+#define WORDTOKENIZER_H
+
+#include "SimdLevel.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Bit masks for one 64-byte block of text; bit i describes byte i.
+ */
+struct WordBlockMasks {
+    std::uint64_t word;   ///< ASCII letters and digits.
+    std::uint64_t upper;  ///< ASCII uppercase letters.
+};
+
+const std::size_t WordBlockSize = 64; ///< Bytes classified per mask.
+
+/**
+ * @brief Classifies `blocks` consecutive 64-byte blocks of `data`.
+ * @param data The text; `blocks * 64` bytes are read.
+ * @param blocks Number of blocks.
+ * @param masks Receives one WordBlockMasks per block.
+ * @param level Kernel set to use; every level produces identical masks.
+ */
+void classifyWordBlocks(const char* data, std::size_t blocks, WordBlockMasks* masks, SimdLevel level = SimdLevel::Auto);
+
+inline bool isWordByte(char c) { ///< True for ASCII letters and digits, the bytes words are made of.
+    unsigned char u = static_cast<unsigned char>(c);
+    return static_cast<unsigned char>(u - '0') < 10 || static_cast<unsigned char>((u | 0x20) - 'a') < 26;
+}
+
+/**
+ * @brief Calls `onWord` with every maximal run of ASCII letters and digits in `text`, lowercased.
+ * @param text The text; line breaks are ordinary separators.
+ * @param onWord Called with a std::string_view per word, in order.
+ * @param level Kernel set for the classification.
+ * @note Words without uppercase letters are passed as views straight into `text`, so mapped input is
+ *       never copied; only a word containing uppercase letters is lowercased into a scratch buffer,
+ *       valid until `onWord` returns. Letters and digits are exactly the bytes `isalnum` accepts in
+ *       the "C" locale, so the words match the former per-character splitter. The masks are computed
+ *       a few kilobytes ahead and then walked boundary by boundary: a word costs two bit scans, not a
+ *       branch per byte.
+ */
+template <typename Fn>
+void tokenizeWords(std::string_view text, Fn&& onWord, SimdLevel level = SimdLevel::Auto) {
+    const std::size_t MasksPerRun = 64;
+    WordBlockMasks masks[MasksPerRun];
+    const char* data = text.data();
+    const std::size_t size = text.size();
+    std::string lowered;
+
+    std::size_t wordStart = 0;
+    bool inWord = false;
+    bool upperSeen = false; // Uppercase inside the current word, in blocks already passed
+    auto emit = [&](std::size_t end, bool upper) {
+        std::string_view word(data + wordStart, end - wordStart);
+        if (!upper) {
+            onWord(word);
+            return;
+        }
+        lowered.resize(word.size());
+        for (std::size_t i = 0; i < word.size(); ++i) lowered[i] = static_cast<char>(word[i] | 0x20); // Digits already have the bit
+        onWord(std::string_view(lowered));
+    };
+
+    for (std::size_t base = 0; base < size;) {
+        std::size_t whole = (size - base) / WordBlockSize;
+        std::size_t count = whole < MasksPerRun ? whole : MasksPerRun;
+        if (count > 0) {
+            classifyWordBlocks(data + base, count, masks, level);
+        } else {
+            // The last partial block, padded with separators
+            char tail[WordBlockSize] = {};
+            std::memcpy(tail, data + base, size - base);
+            classifyWordBlocks(tail, 1, masks, level);
+            count = 1;
+        }
+        for (std::size_t b = 0; b < count; ++b, base += WordBlockSize) {
+            const std::uint64_t word = masks[b].word;
+            const std::uint64_t upper = masks[b].upper;
+            // Bits where the word mask changes: starts and ends of words, alternating
+            std::uint64_t edges = word ^ ((word << 1) | (inWord ? 1u : 0u));
+            if (inWord) {
+                if (!edges) {
+                    upperSeen = upperSeen || upper != 0;
+                    continue;
+                }
+                unsigned end = static_cast<unsigned>(__builtin_ctzll(edges));
+                edges &= edges - 1;
+                emit(base + end, upperSeen || (upper & ~(~std::uint64_t(0) << end)) != 0);
+                inWord = false;
+            }
+            // Whole words inside the block come in start/end pairs
+            while (edges) {
+                unsigned start = static_cast<unsigned>(__builtin_ctzll(edges));
+                edges &= edges - 1;
+                wordStart = base + start;
+                if (!edges) {
+                    inWord = true;
+                    upperSeen = (upper >> start) != 0;
+                    break;
+                }
+                unsigned end = static_cast<unsigned>(__builtin_ctzll(edges));
+                edges &= edges - 1;
+                emit(base + end, ((upper >> start) & ~(~std::uint64_t(0) << (end - start))) != 0);
+            }
+        }
+    }
+    if (inWord) emit(size, upperSeen);
+}
+
+#endif // WORDTOKENIZER_H
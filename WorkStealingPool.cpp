@@ -0,0 +1,142 @@
+//##################################################
+// File: WorkStealingPool.cpp
+// Description: Worker threads, chunk distribution and stealing for WorkStealingPool.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "WorkStealingPool.h"
+
+/**
+ * @brief Starts the pool.
+ * @param threadCount Number of workers including the thread that calls `parallelFor`; 0 uses one per hardware thread.
+ */
+WorkStealingPool::WorkStealingPool(unsigned threadCount)
+    : workerCount(threadCount), currentTask(nullptr), generation(0), workersFinished(0), stopping(false) {
+    if (workerCount == 0) workerCount = std::thread::hardware_concurrency();
+    if (workerCount == 0) workerCount = 1;
+
+    queues.reset(new WorkerQueue[workerCount]);
+
+    // Worker 0 is whoever calls parallelFor, so only the others need threads
+    for (unsigned worker = 1; worker < workerCount; ++worker) {
+        threads.emplace_back(&WorkStealingPool::workerLoop, this, worker);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        stopping = true;
+    }
+    jobReady.notify_all();
+    for (std::thread& thread : threads) thread.join();
+}
+
+/**
+ * @brief Runs `task` over the indices [0, count) on every worker and waits for completion.
+ * @param count Number of indices.
+ * @param grain Indices per chunk; a chunk is the unit that can be stolen.
+ * @param task Called once per chunk with the worker index and the chunk bounds.
+ * @note Each worker starts with a contiguous share of the chunks. A worker that runs out steals
+ *       from the front of another worker's deque while the owner keeps popping from the back.
+ */
+void WorkStealingPool::parallelFor(std::size_t count, std::size_t grain, const RangeTask& task) {
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+
+    const std::size_t chunkCount = (count + grain - 1) / grain;
+    for (unsigned worker = 0; worker < workerCount; ++worker) {
+        WorkerQueue& queue = queues[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.chunks.clear();
+
+        std::size_t first = chunkCount * worker / workerCount;
+        std::size_t last = chunkCount * (worker + 1) / workerCount;
+        for (std::size_t chunk = first; chunk < last; ++chunk) {
+            std::size_t begin = chunk * grain;
+            std::size_t end = begin + grain < count ? begin + grain : count;
+            queue.chunks.push_back(Range{begin, end});
+        }
+        queue.head = 0;
+        queue.tail = queue.chunks.size();
+    }
+
+    if (workerCount > 1) {
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            currentTask = &task;
+            workersFinished = 0;
+            generation++;
+        }
+        jobReady.notify_all();
+    }
+
+    drain(0, task);
+
+    if (workerCount > 1) {
+        std::unique_lock<std::mutex> lock(jobMutex);
+        jobDone.wait(lock, [this] { return workersFinished == workerCount - 1; });
+        currentTask = nullptr;
+    }
+}
+
+/**
+ * @brief Helper thread body: waits for a job, drains it, reports completion.
+ * @param worker This thread's worker index.
+ */
+void WorkStealingPool::workerLoop(unsigned worker) {
+    std::size_t seenGeneration = 0;
+    while (true) {
+        const RangeTask* task = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobReady.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+            task = currentTask;
+        }
+
+        drain(worker, *task);
+
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            workersFinished++;
+        }
+        jobDone.notify_one();
+    }
+}
+
+/**
+ * @brief Processes chunks until no worker has any left.
+ * @param worker The worker doing the processing.
+ * @param task The loop body.
+ * @note Chunks are only ever removed once a job starts, so an unsuccessful steal sweep means the job is fully claimed.
+ */
+void WorkStealingPool::drain(unsigned worker, const RangeTask& task) {
+    Range range;
+    while (popLocal(worker, range) || steal(worker, range)) {
+        task(worker, range.begin, range.end);
+    }
+}
+
+bool WorkStealingPool::popLocal(unsigned worker, Range& range) {
+    WorkerQueue& queue = queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.head == queue.tail) return false;
+    range = queue.chunks[--queue.tail];
+    return true;
+}
+
+bool WorkStealingPool::steal(unsigned thief, Range& range) {
+    for (unsigned offset = 1; offset < workerCount; ++offset) {
+        WorkerQueue& victim = queues[(thief + offset) % workerCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.head < victim.tail) {
+            range = victim.chunks[victim.head++];
+            return true;
+        }
+    }
+    return false;
+}
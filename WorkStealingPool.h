@@ -0,0 +1,71 @@
+//##################################################
+// File: WorkStealingPool.h
+// Description: A fixed-size thread pool that splits index ranges into chunks and balances them by work stealing.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool {
+public:
+    /**
+     * @brief Body of a parallel loop: processes indices [begin, end) on worker `worker`.
+     */
+    typedef std::function<void(unsigned worker, std::size_t begin, std::size_t end)> RangeTask;
+
+    explicit WorkStealingPool(unsigned threadCount = 0); ///< Starts the workers (0 = one per hardware thread).
+    ~WorkStealingPool();                                 ///< Stops and joins the workers.
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned size() const { return workerCount; } ///< Number of workers, including the calling thread.
+
+    void parallelFor(std::size_t count, std::size_t grain, const RangeTask& task); ///< Runs `task` over [0, count) and waits.
+
+private:
+    struct Range {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    /**
+     * @brief A worker's chunk deque: the owner pops from the back, thieves take from the front.
+     */
+    struct alignas(64) WorkerQueue {
+        std::mutex mutex;
+        std::vector<Range> chunks;
+        std::size_t head = 0;
+        std::size_t tail = 0;
+    };
+
+    unsigned workerCount;
+    std::vector<std::thread> threads;
+    std::unique_ptr<WorkerQueue[]> queues;
+
+    std::mutex jobMutex;
+    std::condition_variable jobReady;
+    std::condition_variable jobDone;
+    const RangeTask* currentTask;
+    std::size_t generation;     ///< Incremented for every parallelFor call.
+    unsigned workersFinished;   ///< Helper threads that have drained the current job.
+    bool stopping;
+
+    void workerLoop(unsigned worker);
+    void drain(unsigned worker, const RangeTask& task);
+    bool popLocal(unsigned worker, Range& range);
+    bool steal(unsigned thief, Range& range);
+};
+
+#endif // WORKSTEALINGPOOL_H
@@ -0,0 +1,176 @@
+//##################################################
+// File: Benchmark.cpp
+// Description: Allocation counting, peak RSS and JSON baselines for the benchmark harness.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <sstream>
+
+#include <sys/resource.h>
+
+namespace {
+
+std::atomic<std::uint64_t> allocations{ 0 };
+
+void* countedAllocate(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void* memory = std::malloc(size ? size : 1);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+void* countedAllocateAligned(std::size_t size, std::align_val_t alignment) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    std::size_t rounded = (size + align - 1) / align * align;
+    void* memory = std::aligned_alloc(align, rounded ? rounded : align);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+/**
+ * @brief Finds `"key":` inside one JSON object and parses the number after it.
+ */
+double numberAfter(const std::string& object, const char* key) {
+    std::size_t pos = object.find(key);
+    if (pos == std::string::npos) return 0.0;
+    pos = object.find(':', pos);
+    return pos == std::string::npos ? 0.0 : std::strtod(object.c_str() + pos + 1, nullptr);
+}
+
+} // namespace
+
+// Every benchmark program links this file, so all of their allocations are counted
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return countedAllocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return countedAllocateAligned(size, alignment); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+
+namespace bench {
+
+/**
+ * @brief Returns how many times operator new has been called so far, from every thread.
+ */
+std::uint64_t allocationCount() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns the peak resident set size of the process in KiB.
+ */
+long peakRssKb() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/**
+ * @brief Writes results as a JSON baseline that `readJson` and `compareResults` understand.
+ * @param path The file to create or replace.
+ * @param results The results to store.
+ * @return False if the file cannot be written.
+ */
+bool writeJson(const char* path, const std::vector<Result>& results) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "{\n  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        char line[512];
+        std::snprintf(line, sizeof(line),
+                      "    { \"name\": \"%s\", \"ops\": %zu, \"ns_per_op\": %.4f, \"allocs_per_op\": %.4f, \"peak_rss_kb\": %ld }%s\n",
+                      r.name.c_str(), r.ops, r.nsPerOp, r.allocsPerOp, r.peakRssKb, i + 1 < results.size() ? "," : "");
+        out << line;
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+/**
+ * @brief Reads a baseline written by `writeJson`.
+ * @param path The baseline file.
+ * @param results Receives one Result per stored benchmark.
+ * @return False if the file cannot be read or holds no benchmarks.
+ * @note Only the flat layout `writeJson` produces is understood; this is not a general JSON parser.
+ */
+bool readJson(const char* path, std::vector<Result>& results) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string text = buffer.str();
+
+    results.clear();
+    std::size_t pos = 0;
+    while ((pos = text.find('{', pos + 1)) != std::string::npos) {
+        std::size_t end = text.find('}', pos);
+        if (end == std::string::npos) break;
+        std::string object = text.substr(pos, end - pos);
+        std::size_t nameKey = object.find("\"name\"");
+        if (nameKey != std::string::npos) {
+            std::size_t open = object.find('"', object.find(':', nameKey));
+            std::size_t close = object.find('"', open + 1);
+            if (open != std::string::npos && close != std::string::npos) {
+                Result r;
+                r.name = object.substr(open + 1, close - open - 1);
+                r.ops = static_cast<std::size_t>(numberAfter(object, "\"ops\""));
+                r.nsPerOp = numberAfter(object, "\"ns_per_op\"");
+                r.allocsPerOp = numberAfter(object, "\"allocs_per_op\"");
+                r.peakRssKb = static_cast<long>(numberAfter(object, "\"peak_rss_kb\""));
+                results.push_back(r);
+            }
+        }
+        pos = end;
+    }
+    return !results.empty();
+}
+
+/**
+ * @brief Prints each benchmark next to its baseline and counts regressions.
+ * @param current The results just measured.
+ * @param baseline The stored results.
+ * @param thresholdPercent Allowed slowdown (and allocation growth) before a benchmark counts as regressed.
+ * @return Number of benchmarks slower, or allocating more, than the threshold allows.
+ * @note Benchmarks missing from the baseline are reported but never fail the comparison.
+ */
+int compareResults(const std::vector<Result>& current, const std::vector<Result>& baseline, double thresholdPercent) {
+    const double limit = 1.0 + thresholdPercent / 100.0;
+    int regressions = 0;
+    std::printf("%-32s %12s %12s %9s %14s\n", "benchmark", "base ns/op", "ns/op", "change", "allocs/op");
+    for (const Result& r : current) {
+        const Result* base = nullptr;
+        for (const Result& candidate : baseline) {
+            if (candidate.name == r.name) base = &candidate;
+        }
+        if (!base) {
+            std::printf("%-32s %12s %12.2f %9s %14.3f  new\n", r.name.c_str(), "-", r.nsPerOp, "-", r.allocsPerOp);
+            continue;
+        }
+        double change = base->nsPerOp > 0 ? (r.nsPerOp / base->nsPerOp - 1.0) * 100.0 : 0.0;
+        bool slower = r.nsPerOp > base->nsPerOp * limit;
+        bool allocatesMore = r.allocsPerOp > base->allocsPerOp * limit + 0.0005;
+        if (slower || allocatesMore) regressions++;
+        std::printf("%-32s %12.2f %12.2f %+8.1f%% %6.3f->%-6.3f %s\n", r.name.c_str(), base->nsPerOp, r.nsPerOp, change,
+                    base->allocsPerOp, r.allocsPerOp, slower ? "REGRESSION (time)" : allocatesMore ? "REGRESSION (allocations)" : "ok");
+    }
+    return regressions;
+}
+
+} // namespace bench
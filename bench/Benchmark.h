@@ -0,0 +1,106 @@
+//##################################################
+// File: Benchmark.h
+// Description: Timing, allocation and memory measurement shared by the benchmark programs.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/**
+ * @brief Keeps the compiler from discarding a computed value.
+ * @param value The value that must be treated as used.
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Runs `fn` once and returns the elapsed wall time in nanoseconds.
+ * @param fn The workload to time.
+ */
+template <typename Fn>
+double timeNs(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+/**
+ * @brief Prints one result line: total time, cost per operation and throughput.
+ * @param name The benchmark name.
+ * @param totalNs Elapsed time for all operations.
+ * @param ops Number of operations performed.
+ */
+inline void report(const char* name, double totalNs, std::size_t ops) {
+    double nsPerOp = ops ? totalNs / static_cast<double>(ops) : 0.0;
+    double opsPerSec = totalNs > 0 ? static_cast<double>(ops) * 1e9 / totalNs : 0.0;
+    std::printf("%-48s %12.2f ms %10.2f ns/op %14.0f ops/s\n",
+                name, totalNs / 1e6, nsPerOp, opsPerSec);
+}
+
+std::uint64_t allocationCount(); ///< Calls to operator new so far, from every thread.
+long peakRssKb();                ///< Peak resident set size of the process in KiB.
+
+/**
+ * @brief One measured benchmark, as printed and as stored in a JSON baseline.
+ */
+struct Result {
+    std::string name;
+    std::size_t ops = 0;        ///< Operations per run.
+    double nsPerOp = 0.0;       ///< Fastest run divided by `ops`.
+    double allocsPerOp = 0.0;   ///< Allocations in the fastest run divided by `ops`.
+    long peakRssKb = 0;         ///< Process peak RSS after the benchmark (a high-water mark).
+};
+
+/**
+ * @brief Runs `fn` `repeats` times and keeps the fastest run, which is the least disturbed by noise.
+ * @param name The benchmark name.
+ * @param ops Number of operations one call of `fn` performs.
+ * @param repeats Number of timed runs.
+ * @param fn The workload.
+ * @return Time and allocations per operation of the fastest run.
+ */
+template <typename Fn>
+Result measure(const char* name, std::size_t ops, int repeats, Fn&& fn) {
+    Result result;
+    result.name = name;
+    result.ops = ops;
+    double bestNs = 0.0;
+    std::uint64_t bestAllocations = 0;
+    for (int r = 0; r < std::max(repeats, 1); ++r) {
+        std::uint64_t allocationsBefore = allocationCount();
+        double ns = timeNs(fn);
+        std::uint64_t allocations = allocationCount() - allocationsBefore;
+        if (r == 0 || ns < bestNs) {
+            bestNs = ns;
+            bestAllocations = allocations;
+        }
+    }
+    result.nsPerOp = ops ? bestNs / static_cast<double>(ops) : 0.0;
+    result.allocsPerOp = ops ? static_cast<double>(bestAllocations) / static_cast<double>(ops) : 0.0;
+    result.peakRssKb = peakRssKb();
+    return result;
+}
+
+bool writeJson(const char* path, const std::vector<Result>& results); ///< Stores results as a JSON baseline.
+bool readJson(const char* path, std::vector<Result>& results);        ///< Loads a baseline written by `writeJson`.
+int compareResults(const std::vector<Result>& current, const std::vector<Result>& baseline, double thresholdPercent); ///< Prints the comparison and returns the number of regressions.
+
+} // namespace bench
+
+#endif // BENCHMARK_H
@@ -0,0 +1,204 @@
+//##################################################
+// File: CacheBenchmark.cpp
+// Description: Measures ExpressionCache on skewed traffic: throughput, hit latency percentiles and agreement with uncached evaluation.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "../ExpressionCache.h"
+#include "../InfixCalculator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void randomInfix(std::mt19937_64& rng, std::string& out, int depth) {
+    std::uniform_int_distribution<int> pick(0, 9);
+    if (depth <= 0 || pick(rng) < 3) {
+        out += std::to_string(1 + pick(rng) * 37 + pick(rng));
+        return;
+    }
+    const char operators[] = { '+', '-', '*', '/' };
+    bool paren = pick(rng) < 4;
+    if (paren) out += '(';
+    randomInfix(rng, out, depth - 1);
+    out += ' ';
+    out += operators[pick(rng) % 4];
+    out += ' ';
+    randomInfix(rng, out, depth - 1);
+    if (paren) out += ')';
+}
+
+bool sameOutcome(double a, int errorA, double b, int errorB) {
+    return errorA == errorB && (a == b || (a != a && b != b));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t calls = argc > 1 ? static_cast<std::size_t>(std::atol(argv[1])) : 1000000;
+
+    // 100,000 distinct expressions; 5% of them receive 90% of the calls
+    std::mt19937_64 rng(5);
+    std::vector<std::string> distinct;
+    while (distinct.size() < 100000) {
+        std::string formula;
+        randomInfix(rng, formula, 5);
+        if (formula.size() >= 20 && formula.size() <= 200) distinct.push_back(formula);
+    }
+    const std::size_t hotCount = distinct.size() / 20;
+    std::uniform_int_distribution<std::size_t> hot(0, hotCount - 1);
+    std::uniform_int_distribution<std::size_t> cold(hotCount, distinct.size() - 1);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::vector<const char*> traffic(calls);
+    for (const char*& expression : traffic) {
+        expression = distinct[percent(rng) < 90 ? hot(rng) : cold(rng)].c_str();
+    }
+
+    InfixCalculator plain;
+    InfixCalculator cached;
+    ExpressionCache cache(16 << 20);
+    cached.setCache(&cache);
+
+    int mismatches = 0;
+    double checksum = 0.0;
+    double ns = bench::timeNs([&] {
+        for (const char* expression : traffic) {
+            int errorCode = 0;
+            checksum += plain.evaluateInfix(expression, errorCode);
+        }
+    });
+    bench::report("evaluateInfix (no cache)", ns, calls);
+
+    ns = bench::timeNs([&] {
+        for (const char* expression : traffic) {
+            int errorCode = 0;
+            checksum += cached.evaluateInfix(expression, errorCode);
+        }
+    });
+    bench::report("evaluateInfix (16 MiB cache)", ns, calls);
+
+    ExpressionCacheStats stats = cache.stats();
+    std::printf("hits %llu  misses %llu  evictions %llu  entries %zu  bytes %zu\n",
+                static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.misses),
+                static_cast<unsigned long long>(stats.evictions), stats.entries, stats.bytes);
+
+    // Cached outcomes must match uncached evaluation, and differently spaced text must share an entry
+    for (std::size_t i = 0; i < distinct.size(); i += 7) {
+        int expectedError = 0, error = 0;
+        double expected = plain.evaluateInfix(distinct[i].c_str(), expectedError);
+        std::string spaced = "  " + distinct[i] + "   ";
+        double value = cached.evaluateInfix(spaced.c_str(), error);
+        if (!sameOutcome(value, error, expected, expectedError)) {
+            std::printf("MISMATCH \"%s\"\n", distinct[i].c_str());
+            mismatches++;
+        }
+    }
+    const char* edgeCases[] = { "1 / (2 - 2)", "x + 1", "3 4", "2 ^ 10", "x / 0", "(1 - 1) / 0 + y", "1 / (1 - 1) +",
+                                "x / (1 - 1)", "1 +", "(2", "2 $ 3", "sqrt(x) / 0", "" };
+    for (const char* edge : edgeCases) {
+        for (int pass = 0; pass < 2; ++pass) {
+            int expectedError = 0, error = 0;
+            double expected = plain.evaluateInfix(edge, expectedError);
+            double value = cached.evaluateInfix(edge, error);
+            if (!sameOutcome(value, error, expected, expectedError)) {
+                std::printf("MISMATCH \"%s\" (pass %d)\n", edge, pass);
+                mismatches++;
+            }
+        }
+    }
+    // The RPN path too: malformed text and variables must fail the same way with and without the cache
+    const char* rpnEdgeCases[] = { "3 4 ++", "3 4 +x", "1 2 x", "x 0 /", "1 2 3 ++", "1 1 1 - / +", "x 1 1 - /",
+                                   "1 1 1 - /", "1 0 /", "5 -0 /", "+", "", "2 sqrt", "x sqrt", "x$ 1 +", "1 x 0 / +",
+                                   "x 1 1 - / y", "2 0 max /", "3 4 +" };
+    for (const char* edge : rpnEdgeCases) {
+        for (int pass = 0; pass < 2; ++pass) {
+            int expectedError = 0, error = 0;
+            double expected = plain.evaluate(edge, expectedError);
+            double value = cached.evaluate(edge, error);
+            if (!sameOutcome(value, error, expected, expectedError)) {
+                std::printf("MISMATCH RPN \"%s\" (pass %d): error %d, uncached %d\n", edge, pass, error, expectedError);
+                mismatches++;
+            }
+        }
+    }
+    // A cache far smaller than the working set keeps evicting; outcomes must stay correct
+    ExpressionCache small(256 << 10, 4);
+    InfixCalculator evicting;
+    evicting.setCache(&small);
+    for (std::size_t i = 0; i < traffic.size(); i += 3) {
+        int expectedError = 0, error = 0;
+        double expected = plain.evaluateInfix(traffic[i], expectedError);
+        double value = evicting.evaluateInfix(traffic[i], error);
+        if (!sameOutcome(value, error, expected, expectedError)) mismatches++;
+    }
+    ExpressionCacheStats smallStats = small.stats();
+    std::printf("256 KiB cache: hits %llu  misses %llu  evictions %llu  bytes %zu\n",
+                static_cast<unsigned long long>(smallStats.hits), static_cast<unsigned long long>(smallStats.misses),
+                static_cast<unsigned long long>(smallStats.evictions), smallStats.bytes);
+    if (smallStats.bytes > (256 << 10)) {
+        std::printf("MISMATCH small cache exceeds its capacity\n");
+        mismatches++;
+    }
+
+    if (cache.findProgram("x + 1", Notation::Infix) == nullptr) {
+        std::printf("MISMATCH expression with variables has no cached Program\n");
+        mismatches++;
+    }
+
+    // Hit latency: time batches of expressions already in the cache, over several passes. The 1,000
+    // hottest fit in L2 together with their entries; all 5,000 hot ones spill into L3 on small-L2 machines.
+    auto hitLatency = [&](std::size_t count) {
+        const std::size_t batch = 32;
+        std::vector<double> perCall;
+        for (int pass = 0; pass < 10; ++pass) {
+            for (std::size_t start = 0; start + batch <= count; start += batch) {
+                auto begin = std::chrono::steady_clock::now();
+                for (std::size_t i = start; i < start + batch; ++i) {
+                    int errorCode = 0;
+                    checksum += cached.evaluateInfix(distinct[i].c_str(), errorCode);
+                }
+                auto end = std::chrono::steady_clock::now();
+                perCall.push_back(std::chrono::duration<double, std::nano>(end - begin).count() / batch);
+            }
+        }
+        std::sort(perCall.begin(), perCall.end());
+        std::printf("hit latency over %5zu keys: p50 %.1f ns  p99 %.1f ns\n",
+                    count, perCall[perCall.size() / 2], perCall[perCall.size() * 99 / 100]);
+    };
+    hitLatency(1000);
+    hitLatency(hotCount);
+
+    // Concurrent callers share the cache; every thread must see the same outcomes
+    const unsigned threadCount = 4;
+    std::vector<int> threadMismatches(threadCount, 0);
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t] {
+            InfixCalculator local;
+            InfixCalculator reference;
+            local.setCache(&cache);
+            for (std::size_t i = t; i < traffic.size(); i += 97) {
+                int expectedError = 0, error = 0;
+                double expected = reference.evaluateInfix(traffic[i], expectedError);
+                double value = local.evaluateInfix(traffic[i], error);
+                if (!sameOutcome(value, error, expected, expectedError)) threadMismatches[t]++;
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    for (int count : threadMismatches) mismatches += count;
+
+    bench::doNotOptimize(checksum);
+    if (mismatches != 0) std::printf("%d mismatches\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
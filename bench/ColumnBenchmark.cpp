@@ -0,0 +1,103 @@
+//##################################################
+// File: ColumnBenchmark.cpp
+// Description: Measures per-row evaluation against block-vectorized evaluateColumns and checks the kernels agree.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "../ColumnEvaluator.h"
+#include "../RPNCalculator.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+const char* levelName(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Scalar: return "scalar";
+    case SimdLevel::SSE2: return "sse2";
+    case SimdLevel::AVX2: return "avx2";
+    default: return "auto";
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> dist(-100.0, 100.0);
+    std::vector<double> x(rows), y(rows), z(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        x[i] = dist(rng);
+        y[i] = (i % 97 == 0) ? 0.0 : dist(rng); // Some rows divide by zero
+        z[i] = dist(rng);
+    }
+
+    const char* formulas[] = { "x y * z +", "x y / z - x *", "x 2.5 * y z * + 3 / x -", "x abs sqrt y 2 ^ + z max" };
+    RPNCalculator calculator;
+    std::vector<double> expected(rows), results(rows);
+    std::vector<unsigned char> expectedErrors(rows), errors(rows);
+    int failures = 0;
+
+    for (const char* formula : formulas) {
+        Program program = RPNCalculator::compile(formula);
+        const double* columns[3];
+        for (std::size_t v = 0; v < program.variables.size(); ++v) {
+            const std::string& name = program.variables[v];
+            columns[v] = name == "x" ? x.data() : name == "y" ? y.data() : z.data();
+        }
+        std::printf("%s (%zu rows)\n", formula, rows);
+
+        // Baseline: rebuild the expression text for every row (first formula only)
+        double checksum = 0.0;
+        if (formula == formulas[0]) {
+            std::size_t textRows = rows / 10;
+            char text[256];
+            double ns = bench::timeNs([&] {
+                for (std::size_t i = 0; i < textRows; ++i) {
+                    std::snprintf(text, sizeof(text), "%.17g %.17g * %.17g +", x[i], y[i], z[i]);
+                    int errorCode = 0;
+                    checksum += calculator.evaluate(text, errorCode);
+                }
+            });
+            bench::report("  evaluate(text) per row", ns, textRows);
+        }
+
+        double ns = bench::timeNs([&] {
+            double vars[3];
+            for (std::size_t i = 0; i < rows; ++i) {
+                for (std::size_t v = 0; v < program.variables.size(); ++v) vars[v] = columns[v][i];
+                int errorCode = 0;
+                expected[i] = calculator.run(program, vars, errorCode);
+                expectedErrors[i] = static_cast<unsigned char>(errorCode);
+            }
+        });
+        bench::report("  run(program) per row", ns, rows);
+
+        const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2 };
+        for (SimdLevel level : levels) {
+            ns = bench::timeNs([&] {
+                evaluateColumns(program, columns, rows, results.data(), errors.data(), level);
+            });
+            char name[64];
+            std::snprintf(name, sizeof(name), "  evaluateColumns %s", levelName(level));
+            bench::report(name, ns, rows);
+
+            if (std::memcmp(results.data(), expected.data(), rows * sizeof(double)) != 0 ||
+                std::memcmp(errors.data(), expectedErrors.data(), rows) != 0) {
+                std::printf("  MISMATCH: %s results differ from run()\n", levelName(level));
+                failures++;
+            }
+        }
+        bench::doNotOptimize(checksum);
+    }
+    return failures == 0 ? 0 : 1;
+}
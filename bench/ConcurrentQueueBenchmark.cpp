@@ -0,0 +1,199 @@
+//##################################################
+// File: ConcurrentQueueBenchmark.cpp
+// Description: Measures SPSC and MPMC queue throughput at 1..N producers and consumers and stress-checks delivery.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "../ConcurrentQueue.h"
+#include "../Queue.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief A bounded Queue behind a mutex and two condition variables, the baseline for the lock-free queues.
+ */
+template <typename T>
+class LockedQueue {
+public:
+    explicit LockedQueue(std::size_t capacity) : limit(capacity) {}
+
+    bool enqueue(const T& data) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return closed || items.size() < limit; });
+        if (closed) return false;
+        items.enqueue(data);
+        notEmpty.notify_one();
+        return true;
+    }
+    bool dequeue(T& out) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this] { return closed || !items.isEmpty(); });
+        if (!items.dequeue(out)) return false;
+        notFull.notify_one();
+        return true;
+    }
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    Queue<T> items;
+    std::size_t limit;
+    bool closed = false;
+};
+
+/**
+ * @brief Values carry their producer in the top bits and a per-producer sequence number below.
+ */
+const int ProducerShift = 40;
+
+struct Delivery {
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;
+    bool ordered = true;   ///< Every producer's values arrived at this consumer in increasing order.
+};
+
+/**
+ * @brief Runs `producers` threads enqueueing `items` values in total and `consumers` threads
+ *        draining them until the queue is closed; checks that every value arrived exactly once.
+ * @return False (after printing MISMATCH) if values were lost, duplicated or reordered.
+ */
+template <typename QueueType>
+bool runPipeline(const char* name, QueueType& queue, unsigned producers, unsigned consumers, std::size_t items, std::size_t batch) {
+    std::vector<Delivery> deliveries(consumers);
+    std::uint64_t expectedSum = 0;
+    for (unsigned p = 0; p < producers; ++p) {
+        std::size_t share = items * (p + 1) / producers - items * p / producers;
+        for (std::size_t i = 0; i < share; ++i) expectedSum += (static_cast<std::uint64_t>(p) << ProducerShift) + i;
+    }
+
+    double ns = bench::timeNs([&] {
+        std::vector<std::thread> threads;
+        for (unsigned c = 0; c < consumers; ++c) {
+            threads.emplace_back([&, c] {
+                Delivery& delivery = deliveries[c];
+                std::vector<std::uint64_t> last(producers, 0);
+                std::vector<std::uint64_t> buffer(batch);
+                auto accept = [&](std::uint64_t value) {
+                    unsigned producer = static_cast<unsigned>(value >> ProducerShift);
+                    std::uint64_t sequence = value & ((std::uint64_t(1) << ProducerShift) - 1);
+                    if (producer >= producers || sequence + 1 <= last[producer]) delivery.ordered = false;
+                    else last[producer] = sequence + 1;
+                    delivery.count++;
+                    delivery.sum += value;
+                };
+                if constexpr (requires { queue.dequeueBatch(buffer.data(), batch); }) {
+                    if (batch > 1) {
+                        std::size_t taken;
+                        while ((taken = queue.dequeueBatch(buffer.data(), batch)) > 0) {
+                            for (std::size_t i = 0; i < taken; ++i) accept(buffer[i]);
+                        }
+                        return;
+                    }
+                }
+                std::uint64_t value;
+                while (queue.dequeue(value)) accept(value);
+            });
+        }
+        std::vector<std::thread> producerThreads;
+        for (unsigned p = 0; p < producers; ++p) {
+            producerThreads.emplace_back([&, p] {
+                std::size_t share = items * (p + 1) / producers - items * p / producers;
+                std::uint64_t base = static_cast<std::uint64_t>(p) << ProducerShift;
+                if constexpr (requires { queue.tryEnqueueBatch(static_cast<std::uint64_t*>(nullptr), batch); }) {
+                    if (batch > 1) {
+                        std::vector<std::uint64_t> values(batch);
+                        for (std::size_t i = 0; i < share;) {
+                            std::size_t span = share - i < batch ? share - i : batch;
+                            for (std::size_t k = 0; k < span; ++k) values[k] = base + i + k;
+                            std::size_t sent = 0;
+                            while (sent < span) {
+                                std::size_t added = queue.tryEnqueueBatch(values.data() + sent, span - sent);
+                                if (added == 0) queue.enqueue(values[sent++]); // Full: sleep until one fits
+                                sent += added;
+                            }
+                            i += span;
+                        }
+                        return;
+                    }
+                }
+                for (std::size_t i = 0; i < share; ++i) queue.enqueue(base + i);
+            });
+        }
+        for (std::thread& thread : producerThreads) thread.join();
+        queue.close();
+        for (std::thread& thread : threads) thread.join();
+    });
+
+    Delivery total;
+    for (const Delivery& delivery : deliveries) {
+        total.count += delivery.count;
+        total.sum += delivery.sum;
+        total.ordered = total.ordered && delivery.ordered;
+    }
+    char label[128];
+    std::snprintf(label, sizeof(label), "%s %up/%uc", name, producers, consumers);
+    bench::report(label, ns, items);
+    if (total.count != items || total.sum != expectedSum || !total.ordered) {
+        std::printf("MISMATCH %s: %llu of %zu values delivered%s\n", label,
+                    static_cast<unsigned long long>(total.count), items, total.ordered ? "" : ", out of order");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t items = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    unsigned maxThreads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 4;
+    if (maxThreads == 0) maxThreads = 1;
+    const std::size_t capacity = 1024;
+    int mismatches = 0;
+
+    std::printf("%zu values, capacity %zu, %u hardware threads\n", items, capacity, std::thread::hardware_concurrency());
+    {
+        SpscQueue<std::uint64_t> queue(capacity);
+        mismatches += !runPipeline("SpscQueue", queue, 1, 1, items, 1);
+    }
+    {
+        SpscQueue<std::uint64_t> queue(capacity);
+        mismatches += !runPipeline("SpscQueue, batches of 64,", queue, 1, 1, items, 64);
+    }
+    for (unsigned producers = 1; producers <= maxThreads; producers *= 2) {
+        for (unsigned consumers = 1; consumers <= maxThreads; consumers *= 2) {
+            MpmcQueue<std::uint64_t> queue(capacity);
+            mismatches += !runPipeline("MpmcQueue", queue, producers, consumers, items, 1);
+            LockedQueue<std::uint64_t> locked(capacity);
+            mismatches += !runPipeline("mutex + Queue", locked, producers, consumers, items, 1);
+        }
+    }
+
+    // Stress: tiny queues keep every thread bouncing between full, empty and asleep
+    std::printf("stress, capacity 2\n");
+    for (int round = 0; round < 20; ++round) {
+        SpscQueue<std::uint64_t> spsc(2);
+        mismatches += !runPipeline("  SpscQueue", spsc, 1, 1, items / 50, round % 2 ? 3 : 1);
+        MpmcQueue<std::uint64_t> mpmc(2);
+        unsigned threads = 1 + static_cast<unsigned>(round) % maxThreads;
+        mismatches += !runPipeline("  MpmcQueue", mpmc, threads, maxThreads + 1 - threads, items / 50, round % 3 ? 1 : 5);
+    }
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+//##################################################
+// File: ConstexprBenchmark.cpp
+// Description: Compares compile-time expressions with hand-written arithmetic and the runtime calculators.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "../ConstexprCalculator.h"
+#include "../InfixCalculator.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Values fold during compilation and agree with the runtime parsers
+static_assert(rpnValue<"3 2 5 * +"> == 13.0);
+static_assert(rpnValue<"  7   2 -  "> == 5.0);
+static_assert(rpnValue<"1 -4 /"> == -0.25);
+static_assert(infixValue<"3 + 2 * 5"> == 13.0);
+static_assert(infixValue<"(3 + 2) * 5"> == 25.0);
+static_assert(infixValue<"2 ^ 3 ^ 2"> == 512.0);
+static_assert(infixValue<"-2 ^ 2"> == -4.0);
+static_assert(infixValue<"2 ^ -2"> == 0.25);
+static_assert(infixValue<"0.1 + 0.2"> == 0.1 + 0.2);
+static_assert(infixValue<"1.5e3 / 4"> == 375.0);
+static_assert(rpnExpression<"x y * x +">.variableCount == 2);
+static_assert(infixExpression<"a * b + a">(3, 4) == 15.0);
+static_assert(infixExpression<"(x - y) / 2">(5, 1) == 2.0);
+// Malformed input does not compile, e.g. rpnValue<"1 +">, infixValue<"(1 + 2">, infixValue<"1 / 0">,
+// infixValue<"x + 1"> (has a variable) and infixValue<"1.1 ^ 3"> (inexact power).
+
+namespace {
+
+bool sameResult(double a, double b) {
+    if (std::isnan(a) && std::isnan(b)) return true;
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 200;
+
+    std::mt19937_64 rng(10);
+    std::uniform_real_distribution<double> dist(-100.0, 100.0);
+    std::vector<double> xs(4096), ys(4096), zs(4096);
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = dist(rng);
+        ys[i] = dist(rng);
+        zs[i] = dist(rng);
+    }
+    xs[0] = 0.0;
+    ys[0] = 0.0;
+    zs[1] = 0.0;
+
+    constexpr auto formula = infixExpression<"(x + 2.5) * y - x / 4 + z * z * 0.5 - -y">;
+    constexpr auto formulaRpn = rpnExpression<"x 2.5 + y * x 4 / - z z * 0.5 * + y -1 * -">;
+    auto handWritten = [](double x, double y, double z) { return (x + 2.5) * y - x / 4 + z * z * 0.5 - -y; };
+
+    InfixCalculator infix;
+    RPNCalculator calculator;
+    Program program = infix.compileInfix("(x + 2.5) * y - x / 4 + z * z * 0.5 - -y");
+    Program divide = infix.compileInfix("x / (y - z)");
+    constexpr auto divideStatic = infixExpression<"x / (y - z)">;
+
+    // Every form must give the same bits (and error code) as the runtime calculator
+    int mismatches = 0;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        const double variables[] = { xs[i], ys[i], zs[i] };
+        int expectedError = 0, error = 0;
+        double expected = calculator.run(program, variables, expectedError);
+        double fromRpn = formulaRpn.run(error, xs[i], ys[i], zs[i]);
+        if (!sameResult(formula(xs[i], ys[i], zs[i]), expected) || !sameResult(handWritten(xs[i], ys[i], zs[i]), expected)
+            || !sameResult(fromRpn, expected) || error != expectedError) {
+            if (mismatches++ < 10) std::printf("MISMATCH formula at x=%g y=%g z=%g\n", xs[i], ys[i], zs[i]);
+        }
+
+        const double divideVariables[] = { xs[i], ys[i], ys[i] };
+        expected = calculator.run(divide, divideVariables, expectedError);
+        double value = divideStatic.run(error, xs[i], ys[i], ys[i]);
+        if (!sameResult(value, expected) || error != expectedError) {
+            if (mismatches++ < 10) std::printf("MISMATCH division at x=%g: %g (error %d), expected %g (error %d)\n",
+                                               xs[i], value, error, expected, expectedError);
+        }
+    }
+
+    double checksum = 0.0;
+    std::size_t ops = xs.size() * static_cast<std::size_t>(rounds);
+
+    double ns = bench::timeNs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (std::size_t i = 0; i < xs.size(); ++i) checksum += handWritten(xs[i], ys[i], zs[i]);
+            bench::doNotOptimize(checksum);
+        }
+    });
+    bench::report("hand-written arithmetic", ns, ops);
+
+    ns = bench::timeNs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (std::size_t i = 0; i < xs.size(); ++i) checksum += formula(xs[i], ys[i], zs[i]);
+            bench::doNotOptimize(checksum);
+        }
+    });
+    bench::report("infixExpression<...>", ns, ops);
+
+    ns = bench::timeNs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (std::size_t i = 0; i < xs.size(); ++i) checksum += formulaRpn(xs[i], ys[i], zs[i]);
+            bench::doNotOptimize(checksum);
+        }
+    });
+    bench::report("rpnExpression<...>", ns, ops);
+
+    ns = bench::timeNs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (std::size_t i = 0; i < xs.size(); ++i) {
+                int errorCode = 0;
+                checksum += formulaRpn.run(errorCode, xs[i], ys[i], zs[i]);
+            }
+            bench::doNotOptimize(checksum);
+        }
+    });
+    bench::report("rpnExpression<...>.run (checked)", ns, ops);
+
+    ns = bench::timeNs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (std::size_t i = 0; i < xs.size(); ++i) {
+                const double variables[] = { xs[i], ys[i], zs[i] };
+                int errorCode = 0;
+                checksum += calculator.run(program, variables, errorCode);
+            }
+            bench::doNotOptimize(checksum);
+        }
+    });
+    bench::report("RPNCalculator::run (compiled Program)", ns, ops);
+
+    bench::doNotOptimize(checksum);
+    return mismatches == 0 ? 0 : 1;
+}
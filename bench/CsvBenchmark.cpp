@@ -0,0 +1,274 @@
+//##################################################
+// File: CsvBenchmark.cpp
+// Description: Measures CSV computed-column throughput and memory, and checks rows split across blocks.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "../BufferedWriter.h"
+#include "../CsvEvaluator.h"
+#include "../InfixCalculator.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Runs `evaluateCsv` over a string and returns what it wrote.
+ */
+std::string evaluateText(const std::string& text, const CsvOptions& options) {
+    std::FILE* in = std::tmpfile();
+    std::FILE* out = std::tmpfile();
+    std::fwrite(text.data(), 1, text.size(), in);
+    std::rewind(in);
+    evaluateCsv(in, out, options);
+    std::rewind(out);
+    std::string written;
+    char buffer[4096];
+    std::size_t got;
+    while ((got = std::fread(buffer, 1, sizeof(buffer), out)) > 0) written.append(buffer, got);
+    std::fclose(in);
+    std::fclose(out);
+    return written;
+}
+
+/**
+ * @brief Appends one generated row: an id, a price with cents, a quantity and a discount rate.
+ */
+void appendRow(std::mt19937_64& rng, std::size_t id, std::string& out) {
+    std::uniform_int_distribution<int> cents(1, 99999);
+    std::uniform_int_distribution<int> quantity(1, 99);
+    std::uniform_int_distribution<int> percent(0, 30);
+    int price = cents(rng);
+    out += std::to_string(id);
+    out += ',';
+    out += std::to_string(price / 100);
+    out += '.';
+    out += static_cast<char>('0' + price / 10 % 10);
+    out += static_cast<char>('0' + price % 10);
+    out += ',';
+    out += std::to_string(quantity(rng));
+    out += ",0.";
+    int rate = percent(rng);
+    out += static_cast<char>('0' + rate / 10);
+    out += static_cast<char>('0' + rate % 10);
+    out += '\n';
+}
+
+CsvOptions billingOptions() {
+    CsvOptions options;
+    options.formulas.push_back(CsvFormula{ "total", "price * qty * (1 - discount)" });
+    options.formulas.push_back(CsvFormula{ "unit", "price / qty" });
+    return options;
+}
+
+/**
+ * @brief Compares a generated file's output with per-row InfixCalculator runs.
+ */
+int checkAgainstCalculator(std::size_t rows) {
+    std::mt19937_64 rng(24);
+    std::string text = "id,price,qty,discount\n";
+    for (std::size_t i = 0; i < rows; ++i) appendRow(rng, i, text);
+    const CsvOptions options = billingOptions();
+    std::string written = evaluateText(text, options);
+
+    InfixCalculator calculator;
+    std::vector<Program> programs(options.formulas.size());
+    for (std::size_t f = 0; f < programs.size(); ++f) calculator.compileInfix(std::string_view(options.formulas[f].expression), programs[f]);
+
+    std::string expected;
+    std::size_t start = 0;
+    while (start < text.size()) {
+        std::size_t end = text.find('\n', start);
+        std::string line = text.substr(start, end - start);
+        start = end + 1;
+        expected += line;
+        if (expected.size() == line.size()) {
+            expected += ",total,unit\n";
+            continue;
+        }
+        // Fields in header order: id, price, qty, discount
+        double fields[4];
+        std::size_t at = 0;
+        for (int i = 0; i < 4; ++i) {
+            std::size_t comma = line.find(',', at);
+            fields[i] = std::strtod(line.substr(at, comma - at).c_str(), nullptr);
+            at = comma + 1;
+        }
+        for (const Program& program : programs) {
+            double variables[4];
+            for (std::size_t v = 0; v < program.variables.size(); ++v) {
+                const std::string& name = program.variables[v];
+                variables[v] = fields[name == "price" ? 1 : name == "qty" ? 2 : 3];
+            }
+            int errorCode = 0;
+            double value = calculator.run(program, variables, errorCode);
+            char number[32];
+            expected += ',';
+            expected.append(number, std::to_chars(number, number + sizeof(number), value).ptr);
+        }
+        expected += '\n';
+    }
+    if (written != expected) {
+        std::printf("MISMATCH generated rows against InfixCalculator\n");
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Quotes, CRLF endings, missing and non-numeric fields, blank lines and unknown names, read
+ *        in blocks small enough to split rows and quoted fields.
+ */
+int checkEdgeCases() {
+    const std::string text =
+        "name,\"a\",b\r\n"
+        "\"x, \"\"quoted\"\"\",1,2\r\n"
+        "\"multi\nline\", 3 ,\"4\"\r\n"
+        "\n"
+        "short,5\r\n"
+        "bad,six,7\r\n"
+        "last,8,9";
+    const std::string expected =
+        "name,\"a\",b,sum,ratio,\"odd,name\"\r\n"
+        "\"x, \"\"quoted\"\"\",1,2,3,0.5,error 1\r\n"
+        "\"multi\nline\", 3 ,\"4\",7,0.75,error 1\r\n"
+        "short,5,error 1,error 1,error 1\r\n"
+        "bad,six,7,error 1,error 1,error 1\r\n"
+        "last,8,9,17,0.8888888888888888,error 1\n";
+    CsvOptions options;
+    options.notation = Notation::RPN;
+    options.formulas.push_back(CsvFormula{ "sum", "a b +" });
+    options.formulas.push_back(CsvFormula{ "ratio", "a b /" });
+    options.formulas.push_back(CsvFormula{ "odd,name", "missing 1 +" });
+
+    int mismatches = 0;
+    for (std::size_t block : { std::size_t(64), std::size_t(1) << 20 }) {
+        for (std::size_t batch : { std::size_t(1), std::size_t(2), std::size_t(1024) }) {
+            options.blockBytes = block;
+            options.batchRows = batch;
+            std::string written = evaluateText(text, options);
+            if (written != expected) {
+                std::printf("MISMATCH edge cases with %zu-byte blocks, %zu-row batches:\n%s", block, batch, written.c_str());
+                mismatches++;
+            }
+        }
+    }
+
+    // A row longer than the block grows the buffer instead of failing
+    std::string wide = "a,b\n" + std::string(200, '1') + ",2\n";
+    options.blockBytes = 64;
+    options.formulas.resize(1);
+    if (evaluateText(wide, options).find("\n" + std::string(200, '1') + ",2,") == std::string::npos) {
+        std::printf("MISMATCH row longer than the block\n");
+        mismatches++;
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Compares `BufferedWriter::writeFixed` with printf's "%.*f" for random magnitudes, ties
+ *        and values past the fast path's range.
+ */
+int checkFixed(std::size_t count) {
+    std::mt19937_64 rng(26);
+    std::uniform_real_distribution<double> exponent(-12.0, 20.0);
+    std::vector<double> values = { 0.0, -0.0, 0.5, 1.5, 2.5, -0.125, 0.005, 1e17, 9.999999999e17, 1e300, -1e-300, 5e-324 };
+    for (std::size_t i = 0; i < count; ++i) {
+        double value = std::pow(10.0, exponent(rng)) * (rng() & 1 ? 1 : -1);
+        values.push_back(rng() % 4 == 0 ? std::round(value * 1000.0) / 1000.0 : value);
+    }
+
+    std::FILE* out = std::tmpfile();
+    std::string expected;
+    {
+        BufferedWriter writer(out);
+        char text[352];
+        for (double value : values) {
+            for (int decimals = 0; decimals <= 10; ++decimals) {
+                writer.writeFixed(value, decimals);
+                writer.put('\n');
+                expected.append(text, static_cast<std::size_t>(std::snprintf(text, sizeof(text), "%.*f", decimals, value)));
+                expected += '\n';
+            }
+        }
+        writer.flush();
+    }
+    std::rewind(out);
+    std::string written(expected.size() + 1, '\0');
+    written.resize(std::fread(written.data(), 1, written.size(), out));
+    std::fclose(out);
+    if (written != expected) {
+        std::size_t at = 0;
+        while (at < written.size() && at < expected.size() && written[at] == expected[at]) at++;
+        std::size_t line = expected.rfind('\n', at) + 1;
+        std::printf("MISMATCH writeFixed: expected %s", expected.substr(line, expected.find('\n', line) - line + 1).c_str());
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200;
+    const char* path = "/tmp/rpn_csv_benchmark.csv";
+    int mismatches = checkEdgeCases() + checkAgainstCalculator(20000) + checkFixed(200000);
+
+    // Written in pieces so that the generator itself does not raise the peak RSS
+    std::FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        std::perror(path);
+        return 1;
+    }
+    std::mt19937_64 rng(25);
+    std::string chunk = "id,price,qty,discount\n";
+    std::size_t bytes = 0;
+    for (std::size_t id = 0; bytes < megabytes << 20; ++id) {
+        appendRow(rng, id, chunk);
+        if (chunk.size() >= 1 << 20) {
+            std::fwrite(chunk.data(), 1, chunk.size(), file);
+            bytes += chunk.size();
+            chunk.clear();
+        }
+    }
+    std::fwrite(chunk.data(), 1, chunk.size(), file);
+    std::fclose(file);
+
+    CsvOptions options = billingOptions();
+    long rssBefore = bench::peakRssKb();
+    for (int precision : { -1, 2 }) {
+        options.precision = precision;
+        std::FILE* in = std::fopen(path, "rb");
+        std::FILE* out = std::fopen("/dev/null", "wb");
+        CsvStats stats;
+        bool ok = evaluateCsv(in, out, options, &stats);
+        std::fclose(in);
+        std::fclose(out);
+        if (!ok) {
+            std::printf("MISMATCH evaluateCsv failed\n");
+            mismatches++;
+        }
+
+        const char* format = precision < 0 ? "shortest" : "2 decimals";
+        std::printf("%.1f MB narrow numeric CSV, 2 computed columns, %s\n", stats.inputBytes / 1e6, format);
+        bench::report("evaluateCsv (rows)", static_cast<double>(stats.elapsedNs), stats.rows);
+        std::printf("%-48s %12.1f MB/s\n", "throughput", stats.inputBytes / (stats.elapsedNs / 1e9) / 1e6);
+        std::printf("%-48s %12ld KiB (input buffer %zu KiB)\n", "peak RSS growth", bench::peakRssKb() - rssBefore, stats.bufferBytes >> 10);
+        if (stats.bufferBytes != options.blockBytes) {
+            std::printf("MISMATCH input buffer grew to %zu bytes\n", stats.bufferBytes);
+            mismatches++;
+        }
+    }
+
+    std::remove(path);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+//##################################################
+// File: FileBenchmark.cpp
+// Description: Measures evaluateFile throughput and peak RSS on a generated expression file.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "../FileEvaluator.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <sys/resource.h>
+
+int main(int argc, char* argv[]) {
+    std::size_t lines = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+    const char* path = argc > 2 ? argv[2] : "/tmp/rpn_file_benchmark.txt";
+
+    std::FILE* file = std::fopen(path, "w");
+    if (!file) {
+        std::perror(path);
+        return 1;
+    }
+    std::mt19937_64 rng(3);
+    std::uniform_int_distribution<int> number(1, 9999);
+    std::size_t bytes = 0;
+    for (std::size_t i = 0; i < lines; ++i) {
+        std::string line = std::to_string(number(rng)) + " " + std::to_string(number(rng)) + " * " +
+                           std::to_string(number(rng)) + " +\n";
+        bytes += std::fwrite(line.data(), 1, line.size(), file);
+    }
+    std::fclose(file);
+
+    std::FILE* sink = std::fopen("/dev/null", "w");
+    FileEvaluationStats stats = { 0, 0 };
+    double ns = bench::timeNs([&] { evaluateFile(path, Notation::RPN, sink, &stats); });
+    std::fclose(sink);
+
+    bench::report("evaluateFile (lines)", ns, stats.lines);
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    std::printf("%.1f MB/s over %.1f MB, peak RSS %ld KB\n",
+                bytes / (ns / 1e9) / 1e6, bytes / 1e6, usage.ru_maxrss);
+
+    std::remove(path);
+    return 0;
+}
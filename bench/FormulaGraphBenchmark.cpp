@@ -0,0 +1,327 @@
+//##################################################
+// File: FormulaGraphBenchmark.cpp
+// Description: Measures single-input changes in a 100k-cell formula graph against full re-evaluation.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "../FormulaGraph.h"
+#include "../RPNCalculator.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief One cell of the generated sheet, in definition order (every formula reads earlier cells).
+ */
+struct SheetCell {
+    std::string name;
+    std::string expression;  ///< RPN formula, empty for an input.
+    double input = 0.0;
+};
+
+/**
+ * @brief Builds `sheets` sheets of `cellsPerSheet` cells plus a running grand total over the sheets.
+ * @note The first 20 cells of a sheet are inputs. Every other cell reads two random cells among the
+ *       32 before it in the same sheet, so a change reaches part of its sheet and then the totals.
+ */
+std::vector<SheetCell> makeSheets(std::size_t sheets, std::size_t cellsPerSheet) {
+    const char* operations[] = { "+ 2 /", "max", "min", "- 0.5 *", "+ 0.25 *" };
+    std::mt19937_64 rng(24);
+    std::uniform_real_distribution<double> values(-1000.0, 1000.0);
+    std::vector<SheetCell> cells;
+    for (std::size_t s = 0; s < sheets; ++s) {
+        const std::size_t first = cells.size();
+        for (std::size_t i = 0; i < cellsPerSheet; ++i) {
+            SheetCell cell;
+            cell.name = "s" + std::to_string(s) + "_" + std::to_string(i);
+            if (i < 20) {
+                cell.input = values(rng);
+            } else {
+                std::size_t window = i < 32 ? i : 32;
+                const SheetCell& a = cells[first + i - 1 - rng() % window];
+                const SheetCell& b = cells[first + i - 1 - rng() % window];
+                cell.expression = a.name + " " + b.name + " " + operations[rng() % 5];
+            }
+            cells.push_back(std::move(cell));
+        }
+        SheetCell total;
+        total.name = "total" + std::to_string(s);
+        total.expression = s == 0 ? cells.back().name + " 1 *"
+                                  : "total" + std::to_string(s - 1) + " " + cells.back().name + " +";
+        cells.push_back(std::move(total));
+    }
+    return cells;
+}
+
+/**
+ * @brief Evaluates every cell from scratch in definition order with compiled Programs.
+ */
+class FullEvaluation {
+public:
+    explicit FullEvaluation(const std::vector<SheetCell>& cells) : programs(cells.size()), slots(cells.size()), tokens(cells.size()), values(cells.size()) {
+        std::unordered_map<std::string, std::size_t> index;
+        for (std::size_t i = 0; i < cells.size(); ++i) {
+            index[cells[i].name] = i;
+            if (cells[i].expression.empty()) continue;
+            RPNCalculator::compile(std::string_view(cells[i].expression), programs[i]);
+            for (const std::string& variable : programs[i].variables) slots[i].push_back(index[variable]);
+            std::size_t start = 0;
+            while (start < cells[i].expression.size()) {
+                std::size_t space = cells[i].expression.find(' ', start);
+                if (space == std::string::npos) space = cells[i].expression.size();
+                std::string token = cells[i].expression.substr(start, space - start);
+                std::ptrdiff_t source = isIdentifierStart(token[0]) ? static_cast<std::ptrdiff_t>(index[token]) : -1;
+                tokens[i].emplace_back(std::move(token), source);
+                start = space + 1;
+            }
+        }
+    }
+
+    void run(const std::vector<SheetCell>& cells) {
+        RPNCalculator calculator;
+        double arguments[2];
+        for (std::size_t i = 0; i < cells.size(); ++i) {
+            if (cells[i].expression.empty()) {
+                values[i] = cells[i].input;
+                continue;
+            }
+            for (std::size_t v = 0; v < slots[i].size(); ++v) arguments[v] = values[slots[i][v]];
+            int errorCode = 0;
+            values[i] = calculator.run(programs[i], arguments, errorCode);
+        }
+    }
+
+    /**
+     * @brief The way a sheet without a graph does it: every formula's text with the current values
+     *        written in place of its names, then parsed and evaluated again.
+     */
+    void runText(const std::vector<SheetCell>& cells) {
+        RPNCalculator calculator;
+        std::string text;
+        for (std::size_t i = 0; i < cells.size(); ++i) {
+            if (cells[i].expression.empty()) {
+                values[i] = cells[i].input;
+                continue;
+            }
+            text.clear();
+            for (const auto& [token, source] : tokens[i]) {
+                if (source >= 0) {
+                    char number[32];
+                    text.append(number, std::to_chars(number, number + sizeof(number), values[source]).ptr);
+                } else {
+                    text += token;
+                }
+                text += ' ';
+            }
+            int errorCode = 0;
+            values[i] = calculator.evaluate(std::string_view(text), errorCode);
+        }
+    }
+
+    std::vector<Program> programs;
+    std::vector<std::vector<std::size_t>> slots;       ///< Cell read by each variable, in slot order.
+    std::vector<std::vector<std::pair<std::string, std::ptrdiff_t>>> tokens; ///< Formula text split at spaces, with the cell each name reads (-1 for other tokens).
+    std::vector<double> values;
+};
+
+/**
+ * @brief Counts the formulas downstream of an input with a plain breadth-first walk.
+ */
+std::size_t downstreamCount(const FormulaGraph& graph, FormulaGraph::CellId input) {
+    std::vector<bool> seen(graph.size());
+    std::vector<FormulaGraph::CellId> queue(graph.dependents(input));
+    std::size_t count = 0;
+    for (std::size_t at = 0; at < queue.size(); ++at) {
+        if (seen[queue[at]]) continue;
+        seen[queue[at]] = true;
+        count++;
+        for (FormulaGraph::CellId next : graph.dependents(queue[at])) queue.push_back(next);
+    }
+    return count;
+}
+
+/**
+ * @brief Cycles, redefinition, errors flowing downstream, formulas turned into inputs and a deep chain.
+ */
+int checkSemantics() {
+    int mismatches = 0;
+    auto expect = [&](FormulaGraph& graph, const char* name, double expected, int expectedError) {
+        int errorCode = 0;
+        double value = graph.value(std::string_view(name), errorCode);
+        if (errorCode != expectedError || (errorCode == 0 && value != expected)) {
+            std::printf("MISMATCH %s = %g (error %d), expected %g (error %d)\n", name, value, errorCode, expected, expectedError);
+            mismatches++;
+        }
+    };
+
+    FormulaGraph graph;
+    graph.set("revenue", 120.0);
+    graph.set("cost", 45.0);
+    graph.define("margin", "revenue cost -");
+    graph.define("ratio", "margin / revenue", Notation::Infix);
+    graph.define("report", "ratio 100 *");
+    expect(graph, "margin", 75.0, 0);
+    expect(graph, "report", 62.5, 0);
+
+    if (graph.define("revenue", "report 1 +") != FormulaGraph::CycleError ||
+        graph.define("cost", "cost 1 +") != FormulaGraph::CycleError) {
+        std::printf("MISMATCH cycle not rejected\n");
+        mismatches++;
+    }
+    expect(graph, "report", 62.5, 0);  // The rejected definitions changed nothing
+
+    graph.set("cost", 120.0);
+    expect(graph, "report", 0.0, 0);
+    graph.define("ratio", "revenue margin /");  // Now reads the inputs differently
+    expect(graph, "ratio", 0.0, 3);
+    expect(graph, "report", 0.0, 3);  // Errors flow downstream
+    graph.define("margin", "revenue 2 /");
+    expect(graph, "report", 200.0, 0);
+    graph.define("revenue", "price units *");  // An input becomes a formula over new, empty cells
+    expect(graph, "report", 0.0, 1);
+    graph.set("price", 2.0);
+    graph.set("units", 50.0);
+    expect(graph, "report", 200.0, 0);
+    graph.set("margin", 25.0);  // A formula becomes an input
+    expect(graph, "report", 400.0, 0);
+    if (graph.define("units", "margin 2 *") != 0) {  // No longer a cycle: margin does not read revenue now
+        std::printf("MISMATCH valid definition rejected\n");
+        mismatches++;
+    }
+    expect(graph, "report", 400.0, 0);
+    expect(graph, "missing", 0.0, 1);
+    if (graph.define("broken", "1 +") != 1) {
+        std::printf("MISMATCH compile error not reported\n");
+        mismatches++;
+    }
+    expect(graph, "broken", 0.0, 1);
+
+    // A chain deeper than any call stack would allow
+    FormulaGraph chain;
+    const int length = 200000;
+    chain.set("c0", 0.5);
+    for (int i = 1; i <= length; ++i) chain.define("c" + std::to_string(i), "c" + std::to_string(i - 1) + " 1 +");
+    expect(chain, ("c" + std::to_string(length)).c_str(), length + 0.5, 0);
+    chain.set("c0", 1.5);
+    expect(chain, ("c" + std::to_string(length)).c_str(), length + 1.5, 0);
+    if (chain.define("c0", "c" + std::to_string(length) + " 1 +") != FormulaGraph::CycleError) {
+        std::printf("MISMATCH long cycle not rejected\n");
+        mismatches++;
+    }
+    return mismatches;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t sheets = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100;
+    std::size_t changes = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000;
+    int mismatches = checkSemantics();
+
+    const std::vector<SheetCell> cells = makeSheets(sheets, 1000);
+    std::vector<SheetCell> current = cells;
+    FormulaGraph graph;
+    std::vector<FormulaGraph::CellId> inputs;
+    double ns = bench::timeNs([&] {
+        for (const SheetCell& cell : cells) {
+            if (cell.expression.empty()) {
+                graph.set(cell.name, cell.input);
+                inputs.push_back(graph.cell(cell.name));
+            } else {
+                graph.define(cell.name, cell.expression);
+            }
+        }
+        graph.recompute();
+    });
+    std::printf("%zu cells, %zu inputs, %zu changes\n", graph.size(), inputs.size(), changes);
+    bench::report("define and compute every cell", ns, graph.size());
+
+    // Baselines: every cell again, compiled and from text
+    FullEvaluation full(cells);
+    ns = bench::timeNs([&] { full.run(current); });
+    bench::report("full re-evaluation, compiled (cells)", ns, cells.size());
+    ns = bench::timeNs([&] { full.runText(current); });
+    bench::report("full re-evaluation, parsing text (cells)", ns, cells.size());
+    double checksum = 0.0;
+
+    // One input changes, then everything is brought up to date
+    std::mt19937_64 rng(25);
+    std::uniform_real_distribution<double> values(-1000.0, 1000.0);
+    std::vector<std::size_t> inputIndex;
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        if (cells[i].expression.empty()) inputIndex.push_back(i);
+    }
+    std::size_t recomputed = 0;
+    std::size_t expected = 0;
+    std::vector<std::pair<std::size_t, double>> plan(changes);
+    for (auto& change : plan) change = { rng() % inputIndex.size(), values(rng) };
+    for (const auto& change : plan) expected += downstreamCount(graph, inputs[change.first]);
+    ns = bench::timeNs([&] {
+        for (const auto& change : plan) {
+            graph.set(inputs[change.first], change.second);
+            recomputed += graph.recompute();
+        }
+    });
+    bench::report("set one input + recompute", ns, changes);
+    std::printf("    %.1f formulas recomputed per change (of %zu)\n", static_cast<double>(recomputed) / changes, graph.size() - inputs.size());
+    if (recomputed != expected) {
+        std::printf("MISMATCH recomputed %zu formulas, %zu are downstream of the changes\n", recomputed, expected);
+        mismatches++;
+    }
+
+    // Lazy: only what the grand total needs
+    const std::string grand = "total" + std::to_string(sheets - 1);
+    FormulaGraph::CellId grandId = graph.cell(grand);
+    ns = bench::timeNs([&] {
+        for (const auto& change : plan) {
+            graph.set(inputs[change.first], -change.second);
+            int errorCode = 0;
+            checksum += graph.value(grandId, errorCode);
+        }
+    });
+    bench::report("set one input + read the grand total", ns, changes);
+    graph.recompute();
+
+    // A batch of changes within one sheet: shared downstream cells run once
+    std::vector<std::pair<FormulaGraph::CellId, double>> batch;
+    for (std::size_t i = 0; i < 20; ++i) batch.emplace_back(inputs[i], values(rng));
+    std::uint64_t before = graph.evaluations();
+    ns = bench::timeNs([&] {
+        graph.set(batch);
+        graph.recompute();
+    });
+    std::size_t separately = 0;
+    for (const auto& change : batch) separately += downstreamCount(graph, change.first);
+    bench::report("set 20 inputs as a batch + recompute", ns, 1);
+    std::printf("    %llu formulas recomputed (%zu if recomputed after each)\n", static_cast<unsigned long long>(graph.evaluations() - before), separately);
+
+    // The graph agrees with a full evaluation of the final inputs
+    for (const auto& change : plan) current[inputIndex[change.first]].input = -change.second;
+    for (std::size_t i = 0; i < batch.size(); ++i) current[inputIndex[i]].input = batch[i].second;
+    full.run(current);
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        int errorCode = 0;
+        double value = graph.value(std::string_view(cells[i].name), errorCode);
+        if (value != full.values[i] && !(std::isnan(value) && std::isnan(full.values[i]))) {
+            std::printf("MISMATCH %s = %.17g, full evaluation %.17g\n", cells[i].name.c_str(), value, full.values[i]);
+            mismatches++;
+            break;
+        }
+    }
+
+    bench::doNotOptimize(checksum);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+//##################################################
+// File: FrozenIndexBenchmark.cpp
+// Description: Compares lookup latency of the frozen Eytzinger word index with the AVL tree, the hash table and binary search.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "Workload.h"
+#include "../FrozenWordIndex.h"
+#include "../WordCount.h"
+#include "../WordTokenizer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Checks prefix ranges and top-K against brute force over the sorted list.
+ */
+int checkQueries(const FrozenWordIndex& index, const std::vector<WordFrequency>& sorted) {
+    std::mt19937_64 rng(20);
+    std::uniform_int_distribution<int> letter(0, 25);
+    std::uniform_int_distribution<int> length(0, 3);
+    for (int q = 0; q < 2000; ++q) {
+        std::string prefix;
+        int letters = length(rng);
+        for (int i = 0; i < letters; ++i) prefix += static_cast<char>('a' + letter(rng));
+        if (q % 10 == 0) prefix += '{'; // Past 'z': matches nothing
+        std::vector<WordFrequency> expected;
+        for (const WordFrequency& entry : sorted) {
+            if (entry.word.substr(0, prefix.size()) == prefix) expected.push_back(entry);
+        }
+        std::vector<WordFrequency> found = index.withPrefix(prefix);
+        bool same = found.size() == expected.size();
+        for (std::size_t i = 0; same && i < found.size(); ++i) {
+            same = found[i].word == expected[i].word && found[i].count == expected[i].count;
+        }
+        if (!same) {
+            std::printf("MISMATCH prefix \"%s\": %zu words, expected %zu\n", prefix.c_str(), found.size(), expected.size());
+            return 1;
+        }
+    }
+
+    std::vector<WordFrequency> byCount(sorted);
+    std::stable_sort(byCount.begin(), byCount.end(),
+                     [](const WordFrequency& a, const WordFrequency& b) { return a.count > b.count; });
+    std::vector<WordFrequency> top = index.topK(100);
+    for (std::size_t i = 0; i < top.size(); ++i) {
+        if (top[i].word != byCount[i].word || top[i].count != byCount[i].count) {
+            std::printf("MISMATCH top-K at %zu\n", i);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t words = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+    std::size_t lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000000;
+    int mismatches = 0;
+
+    // Count the same corpus into the tree and the table
+    const std::string corpus = bench::makeCorpus(20, words, words / 10);
+    AVLTree tree;
+    WordTable table;
+    std::string key;
+    tokenizeWords(corpus, [&](std::string_view word) {
+        key.assign(word);
+        tree.insert(key);
+        table.add(word);
+    });
+    std::vector<WordFrequency> sorted = table.sorted();
+    FrozenWordIndex index;
+    double freezeNs = bench::timeNs([&] { index = FrozenWordIndex(sorted); });
+    std::printf("%zu distinct words, frozen in %.2f ms, %.1f MB index\n", index.size(), freezeNs / 1e6, index.memoryBytes() / 1e6);
+
+    // Mostly hits drawn uniformly from the vocabulary, one in eight a miss
+    std::mt19937_64 rng(21);
+    std::uniform_int_distribution<std::size_t> pick(0, sorted.size() - 1);
+    std::vector<std::string> queries(lookups);
+    for (std::size_t i = 0; i < lookups; ++i) {
+        queries[i] = std::string(sorted[pick(rng)].word);
+        if (i % 8 == 0) queries[i] += "zq";
+    }
+
+    std::uint64_t expected = 0;
+    auto run = [&](const char* name, auto&& find) {
+        std::uint64_t total = 0;
+        double ns = bench::timeNs([&] {
+            for (const std::string& query : queries) total += find(query);
+        });
+        bench::report(name, ns, lookups);
+        if (expected == 0) expected = total;
+        else if (total != expected) {
+            std::printf("MISMATCH %s: total %llu\n", name, static_cast<unsigned long long>(total));
+            mismatches++;
+        }
+    };
+    run("AVLTree::find", [&](const std::string& query) { return static_cast<std::uint64_t>(tree.find(query)); });
+    run("std::lower_bound over sorted entries", [&](const std::string& query) -> std::uint64_t {
+        auto it = std::lower_bound(sorted.begin(), sorted.end(), query,
+                                   [](const WordFrequency& entry, const std::string& word) { return entry.word < word; });
+        return it != sorted.end() && it->word == query ? it->count : 0;
+    });
+    run("FrozenWordIndex::count (Eytzinger)", [&](const std::string& query) { return index.count(query); });
+    run("WordTable::count (hash)", [&](const std::string& query) { return table.count(query); });
+
+    mismatches += checkQueries(index, sorted);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+//##################################################
+// File: InfixBenchmark.cpp
+// Description: Compares the one-pass infix parser with the former infix-to-postfix-text round trip.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "../InfixCalculator.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool legacyIsOperator(char c) {
+    return c == '+' || c == '-' || c == '*' || c == '/' || c == '^';
+}
+
+int legacyPrecedence(char op) {
+    if (op == '^') return 3;
+    if (op == '*' || op == '/') return 2;
+    if (op == '+' || op == '-') return 1;
+    return 0;
+}
+
+/**
+ * @brief The former infixToPostfix conversion (with a larger buffer), kept as the latency baseline.
+ */
+void legacyInfixToPostfix(const char* infix, char* postfix, int& errorCode) {
+    Stack<char, 64> opStack;
+    int postfixIndex = 0;
+    errorCode = 0;
+    for (const char* ptr = infix; *ptr != '\0'; ptr++) {
+        if (*ptr == ' ') continue;
+        if ((*ptr >= '0' && *ptr <= '9') || *ptr == '.') {
+            postfix[postfixIndex++] = *ptr;
+        } else if (*ptr == '(') {
+            opStack.push(*ptr);
+        } else if (*ptr == ')') {
+            while (!opStack.isEmpty() && opStack.top() != '(') {
+                postfix[postfixIndex++] = ' ';
+                postfix[postfixIndex++] = opStack.top();
+                opStack.pop_back();
+            }
+            if (opStack.isEmpty()) {
+                errorCode = 1;
+                return;
+            }
+            opStack.pop_back();
+        } else if (legacyIsOperator(*ptr)) {
+            postfix[postfixIndex++] = ' ';
+            while (!opStack.isEmpty() && legacyIsOperator(opStack.top()) &&
+                   legacyPrecedence(*ptr) <= legacyPrecedence(opStack.top())) {
+                postfix[postfixIndex++] = opStack.top();
+                opStack.pop_back();
+                postfix[postfixIndex++] = ' ';
+            }
+            opStack.push(*ptr);
+        } else {
+            errorCode = 1;
+            return;
+        }
+    }
+    while (!opStack.isEmpty()) {
+        postfix[postfixIndex++] = ' ';
+        postfix[postfixIndex++] = opStack.top();
+        opStack.pop_back();
+    }
+    postfix[postfixIndex] = '\0';
+}
+
+/**
+ * @brief Appends a random expression over + - * / and parentheses to `out`.
+ */
+void randomInfix(std::mt19937_64& rng, std::string& out, int depth) {
+    std::uniform_int_distribution<int> pick(0, 9);
+    if (depth <= 0 || pick(rng) < 3) {
+        out += std::to_string(1 + pick(rng) * 37);
+        if (pick(rng) < 3) out += ".5";
+        return;
+    }
+    const char operators[] = { '+', '-', '*', '/' };
+    bool paren = pick(rng) < 4;
+    if (paren) out += '(';
+    randomInfix(rng, out, depth - 1);
+    out += ' ';
+    out += operators[pick(rng) % 4];
+    out += ' ';
+    randomInfix(rng, out, depth - 1);
+    if (paren) out += ')';
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 20;
+
+    std::mt19937_64 rng(11);
+    std::vector<std::string> formulas;
+    while (formulas.size() < 20000) {
+        std::string formula;
+        randomInfix(rng, formula, 6);
+        if (formula.size() >= 20 && formula.size() <= 200) formulas.push_back(formula);
+    }
+
+    InfixCalculator calculator;
+    RPNCalculator rpn;
+
+    // Evaluating while parsing must agree with compileInfix + run, including which error wins
+    const char* edgeCases[] = {
+        "-2^2", "2^3^2", "max(2, 3) + sqrt(16)", "3 4", "1/-0", "1/(2-2)", "1/(2-2) +", "x + 1",
+        "1/(1-1) + x", "1/0 + x", "(1 + 2", "pow(2)", "abs(-3) * -(4)", "", "2 $ 3",
+    };
+    Program program;
+    int mismatches = 0;
+    for (const char* edge : edgeCases) {
+        int expectedError = 0, error = 0;
+        calculator.compileInfix(edge, program);
+        double expected = rpn.run(program, expectedError);
+        double value = calculator.evaluateInfix(edge, error);
+        if (error != expectedError || (error == 0 && value != expected)) {
+            std::printf("MISMATCH \"%s\": %g (error %d), expected %g (error %d)\n", edge, value, error, expected, expectedError);
+            mismatches++;
+        }
+    }
+    for (const std::string& formula : formulas) {
+        int expectedError = 0, error = 0;
+        calculator.compileInfix(formula.c_str(), program);
+        double expected = rpn.run(program, expectedError);
+        double value = calculator.evaluateInfix(formula.c_str(), error);
+        if (error != expectedError || (error == 0 && value != expected && !(value != value && expected != expected))) {
+            std::printf("MISMATCH \"%s\"\n", formula.c_str());
+            mismatches++;
+        }
+    }
+
+    char postfix[1024];
+    double checksum = 0.0;
+    std::size_t ops = formulas.size() * static_cast<std::size_t>(rounds);
+
+    double ns = bench::timeNs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const std::string& formula : formulas) {
+                int errorCode = 0;
+                legacyInfixToPostfix(formula.c_str(), postfix, errorCode);
+                if (errorCode == 0) checksum += rpn.evaluate(postfix, errorCode);
+            }
+        }
+    });
+    bench::report("legacy infixToPostfix + evaluate", ns, ops);
+
+    ns = bench::timeNs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const std::string& formula : formulas) {
+                int errorCode = 0;
+                checksum += calculator.evaluateInfix(formula.c_str(), errorCode);
+            }
+        }
+    });
+    bench::report("evaluateInfix (one-pass Pratt parser)", ns, ops);
+
+    bench::doNotOptimize(checksum);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+//##################################################
+// File: InstrumentationBenchmark.cpp
+// Description: Measures evaluation with the instrumentation hooks and checks the collected counters.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "Workload.h"
+#include "../InfixCalculator.h"
+#include "../Instrumentation.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 20;
+
+    bench::ExpressionShape shape;
+    const std::vector<std::string> rpn = bench::makeExpressions(7, 2000, shape, Notation::RPN);
+    const std::vector<std::string> infix = bench::makeExpressions(7, 2000, shape, Notation::Infix);
+    const std::size_t ops = rpn.size() * static_cast<std::size_t>(rounds);
+
+    RPNCalculator calculator;
+    InfixCalculator infixCalculator;
+    double checksum = 0.0;
+    std::uint64_t expectedErrors[InstrumentedErrorCodes] = {};
+
+    double ns = bench::timeNs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const std::string& expression : rpn) {
+                int errorCode = 0;
+                checksum += calculator.evaluate(expression.c_str(), errorCode);
+                expectedErrors[errorCode]++;
+            }
+        }
+    });
+    bench::report("RPNCalculator::evaluate", ns, ops);
+
+    ns = bench::timeNs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const std::string& expression : infix) {
+                int errorCode = 0;
+                checksum += infixCalculator.evaluateInfix(expression.c_str(), errorCode);
+                expectedErrors[errorCode]++;
+            }
+        }
+    });
+    bench::report("InfixCalculator::evaluateInfix", ns, ops);
+
+    // A second thread, including errors, so the aggregation covers finished threads and error tallies
+    const char* invalid[] = { "1 +", "1 2", "4 0 /", "x 1 +" };
+    std::thread worker([&] {
+        RPNCalculator local;
+        for (const char* expression : invalid) {
+            int errorCode = 0;
+            local.evaluate(expression, errorCode);
+        }
+    });
+    worker.join();
+    const int invalidErrors[] = { 1, 2, 3, 1 };
+    for (int code : invalidErrors) expectedErrors[code]++;
+
+    EvaluationStats stats = collectEvaluationStats();
+    std::printf("%s\n\n%s", evaluationStatsJson(stats).c_str(), evaluationStatsPrometheus(stats).c_str());
+
+    int mismatches = 0;
+    if (stats.enabled) {
+        std::uint64_t expectedEvaluations = 2 * ops + 4;
+        if (stats.counters[static_cast<int>(Counter::Evaluations)] != expectedEvaluations) {
+            std::printf("MISMATCH evaluations %llu, expected %llu\n",
+                        static_cast<unsigned long long>(stats.counters[static_cast<int>(Counter::Evaluations)]),
+                        static_cast<unsigned long long>(expectedEvaluations));
+            mismatches++;
+        }
+        for (int code = 0; code < InstrumentedErrorCodes; ++code) {
+            if (stats.errors[code] != expectedErrors[code]) {
+                std::printf("MISMATCH error %d tallied %llu times, expected %llu\n", code,
+                            static_cast<unsigned long long>(stats.errors[code]), static_cast<unsigned long long>(expectedErrors[code]));
+                mismatches++;
+            }
+        }
+        if (stats.counters[static_cast<int>(Counter::Tokens)] == 0 || stats.maxStackDepth == 0 || stats.sampledCalls == 0
+            || stats.phaseNs[static_cast<int>(Phase::Execute)] == 0 || stats.phaseNs[static_cast<int>(Phase::Tokenize)] == 0) {
+            std::printf("MISMATCH tokens, stack depth or phase times were not recorded\n");
+            mismatches++;
+        }
+
+        resetEvaluationStats();
+        EvaluationStats cleared = collectEvaluationStats();
+        if (cleared.counters[static_cast<int>(Counter::Evaluations)] != 0 || cleared.errors[0] != 0) {
+            std::printf("MISMATCH counters not cleared by resetEvaluationStats\n");
+            mismatches++;
+        }
+
+        // The cost of timing every call rather than a sample
+        setInstrumentationSampleInterval(1);
+        ns = bench::timeNs([&] {
+            for (int r = 0; r < rounds; ++r) {
+                for (const std::string& expression : rpn) {
+                    int errorCode = 0;
+                    checksum += calculator.evaluate(expression.c_str(), errorCode);
+                }
+            }
+        });
+        bench::report("RPNCalculator::evaluate, every call timed", ns, ops);
+        EvaluationStats everyCall = collectEvaluationStats();
+        if (everyCall.sampledCalls != everyCall.calls) {
+            std::printf("MISMATCH %llu of %llu calls sampled with an interval of 1\n",
+                        static_cast<unsigned long long>(everyCall.sampledCalls), static_cast<unsigned long long>(everyCall.calls));
+            mismatches++;
+        }
+        setInstrumentationSampleInterval(64);
+
+        std::printf("\nhardware counters: %s\n", enableHardwareCounters(true) ? "available" : "unavailable here");
+        int errorCode = 0;
+        calculator.evaluate("3 4 + 2 *", errorCode);
+        enableHardwareCounters(false);
+    } else {
+        std::printf("\ninstrumentation compiled out (configure with -DRPN_INSTRUMENTATION=ON)\n");
+    }
+
+    bench::doNotOptimize(checksum);
+    return mismatches == 0 ? 0 : 1;
+}
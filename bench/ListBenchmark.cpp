@@ -0,0 +1,257 @@
+//##################################################
+// File: ListBenchmark.cpp
+// Description: Compares insert, traverse and erase on the heap-allocated, pooled and index-linked lists.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "../ArenaList.h"
+#include "../DoublyLinkedList.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief The previous list, one `new` per node, kept here only as the comparison baseline.
+ * @note Given an O(1) `erase` so the comparison measures node storage rather than value search.
+ */
+template <typename T>
+class HeapList {
+public:
+    using Handle = Node<T>*;
+
+    ~HeapList() {
+        while (head) popFront();
+    }
+
+    Handle pushBack(const T& data) {
+        Node<T>* node = new Node<T>(data);
+        node->prev = tail;
+        if (tail) tail->next = node;
+        else head = node;
+        tail = node;
+        return node;
+    }
+    void erase(Handle node) {
+        if (node->prev) node->prev->next = node->next;
+        else head = node->next;
+        if (node->next) node->next->prev = node->prev;
+        else tail = node->prev;
+        delete node;
+    }
+    bool popFront() {
+        if (!head) return false;
+        erase(head);
+        return true;
+    }
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (Node<T>* node = head; node; node = node->next) fn(node->data);
+    }
+
+private:
+    Node<T>* head = nullptr;
+    Node<T>* tail = nullptr;
+};
+
+/**
+ * @brief The pooled DoublyLinkedList behind the same interface as the other two.
+ */
+template <typename T>
+class PooledList {
+public:
+    using Handle = Node<T>*;
+
+    Handle pushBack(const T& data) {
+        list.addToEnd(data);
+        return list.getTail();
+    }
+    void erase(Handle node) { list.erase(node); }
+    bool popFront() { return list.popFront(); }
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (Node<T>* node = list.getHead(); node; node = node->next) fn(node->data);
+    }
+
+private:
+    DoublyLinkedList<T> list;
+};
+
+/**
+ * @brief The index-linked ArenaList behind the same interface as the other two.
+ */
+template <typename T>
+class IndexedList {
+public:
+    using Handle = typename ArenaList<T>::Handle;
+
+    Handle pushBack(const T& data) { return list.pushBack(data); }
+    void erase(Handle node) { list.erase(node); }
+    bool popFront() { return list.popFront(); }
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (Handle node = list.front(); node != ArenaList<T>::None; node = list.next(node)) fn(list.value(node));
+    }
+
+private:
+    ArenaList<T> list;
+};
+
+struct Timings {
+    double insertNs = 0.0;
+    double traverseNs = 0.0;
+    double eraseNs = 0.0;
+    double churnNs = 0.0;
+    std::uint64_t allocations = 0;
+    std::uint64_t checksum = 0;
+};
+
+/**
+ * @brief Appends `count` values, sums them `passes` times, erases every other node by handle, then
+ *        drains the rest from the front; finally runs a queue-like push/pop churn.
+ */
+template <typename List, typename T>
+Timings runCase(std::size_t count, int passes) {
+    Timings timings;
+    std::uint64_t allocationsBefore = bench::allocationCount();
+    {
+        List list;
+        std::vector<typename List::Handle> handles(count);
+        timings.insertNs = bench::timeNs([&] {
+            for (std::size_t i = 0; i < count; ++i) handles[i] = list.pushBack(static_cast<T>(i));
+        });
+        timings.traverseNs = bench::timeNs([&] {
+            for (int p = 0; p < passes; ++p) {
+                list.forEach([&](const T& value) { timings.checksum += static_cast<std::uint64_t>(value); });
+            }
+        });
+        timings.eraseNs = bench::timeNs([&] {
+            for (std::size_t i = 0; i < count; i += 2) list.erase(handles[i]);
+            list.forEach([&](const T& value) { timings.checksum += static_cast<std::uint64_t>(value); });
+            while (list.popFront()) {}
+        });
+        timings.churnNs = bench::timeNs([&] {
+            const std::size_t window = 64;
+            for (std::size_t i = 0; i < window; ++i) list.pushBack(static_cast<T>(i));
+            for (std::size_t i = 0; i < count; ++i) {
+                list.pushBack(static_cast<T>(i));
+                list.popFront();
+            }
+            list.forEach([&](const T& value) { timings.checksum += static_cast<std::uint64_t>(value); });
+        });
+    }
+    timings.allocations = bench::allocationCount() - allocationsBefore;
+    return timings;
+}
+
+template <typename T>
+int compare(const char* type, std::size_t count, int passes) {
+    const std::size_t arenaAlignment = alignof(T) > 4 ? alignof(T) : 4;
+    const std::size_t arenaBytes = (sizeof(T) + 2 * sizeof(std::uint32_t) + arenaAlignment - 1) / arenaAlignment * arenaAlignment;
+    std::printf("%s, %zu nodes (bytes per node: heap %zu plus the malloc header, pooled %zu, arena %zu)\n",
+                type, count, sizeof(Node<T>), sizeof(Node<T>), arenaBytes);
+    Timings heap = runCase<HeapList<T>, T>(count, passes);
+    Timings pooled = runCase<PooledList<T>, T>(count, passes);
+    Timings indexed = runCase<IndexedList<T>, T>(count, passes);
+
+    const char* names[] = { "heap", "pooled", "arena" };
+    const Timings* all[] = { &heap, &pooled, &indexed };
+    int mismatches = 0;
+    for (int i = 0; i < 3; ++i) {
+        char name[96];
+        std::snprintf(name, sizeof(name), "  %s insert", names[i]);
+        bench::report(name, all[i]->insertNs, count);
+        std::snprintf(name, sizeof(name), "  %s traverse", names[i]);
+        bench::report(name, all[i]->traverseNs, count * static_cast<std::size_t>(passes));
+        std::snprintf(name, sizeof(name), "  %s erase by handle + popFront", names[i]);
+        bench::report(name, all[i]->eraseNs, count);
+        std::snprintf(name, sizeof(name), "  %s push/pop churn", names[i]);
+        bench::report(name, all[i]->churnNs, 2 * count);
+        std::printf("  %-46s %12llu\n", (std::string(names[i]) + " allocations").c_str(),
+                    static_cast<unsigned long long>(all[i]->allocations));
+        if (all[i]->checksum != heap.checksum) {
+            std::printf("MISMATCH %s checksum %llu, expected %llu\n", names[i],
+                        static_cast<unsigned long long>(all[i]->checksum), static_cast<unsigned long long>(heap.checksum));
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Exercises the edge cases of both lists against a simple reference sequence.
+ */
+int checkOperations() {
+    DoublyLinkedList<int> list;
+    ArenaList<int> arena;
+    int mismatches = 0;
+    auto expect = [&](const char* what, std::vector<int> expected) {
+        std::vector<int> fromList, fromArena;
+        for (Node<int>* node = list.getHead(); node; node = node->next) fromList.push_back(node->data);
+        for (auto node = arena.front(); node != ArenaList<int>::None; node = arena.next(node)) fromArena.push_back(arena.value(node));
+        std::vector<int> backward;
+        for (Node<int>* node = list.getTail(); node; node = node->prev) backward.insert(backward.begin(), node->data);
+        if (fromList != expected || fromArena != expected || backward != expected
+            || list.size() != expected.size() || arena.size() != expected.size()) {
+            std::printf("MISMATCH after %s\n", what);
+            mismatches++;
+        }
+    };
+
+    list.addToEnd(2);
+    list.addToFront(1);
+    list.addToEnd(4);
+    list.insert(2, 3);
+    arena.pushBack(2);
+    arena.pushFront(1);
+    auto four = arena.pushBack(4);
+    arena.insertAfter(arena.next(arena.front()), 3);
+    expect("inserts", { 1, 2, 3, 4 });
+
+    list.erase(list.getTail());
+    arena.erase(four);
+    list.deleteNode(2);
+    arena.erase(arena.next(arena.front()));
+    expect("erase", { 1, 3 });
+
+    list.popBack();
+    arena.popBack();
+    list.popFront();
+    arena.popFront();
+    expect("pops", {});
+    if (list.popFront() || list.popBack() || arena.popFront() || arena.popBack()) {
+        std::printf("MISMATCH pop on an empty list reported success\n");
+        mismatches++;
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        list.addToEnd(i);
+        arena.pushBack(i);
+    }
+    for (int i = 0; i < 98; ++i) {
+        list.popFront();
+        arena.popFront();
+    }
+    expect("reuse of freed slots", { 98, 99 });
+    return mismatches;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const int passes = 10;
+
+    int mismatches = checkOperations();
+    mismatches += compare<char>("char", count, passes);
+    mismatches += compare<int>("int", count, passes);
+    mismatches += compare<double>("double", count, passes);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+//##################################################
+// File: NumberParserBenchmark.cpp
+// Description: Checks parseDouble against strtod on random and adversarial inputs, then compares throughput.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "../NumberParser.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief The original stringToDouble loop, kept here only as the throughput baseline.
+ * @note Not inlined: the original lived in RPNCalculator.cpp and was called like `parseDouble` is.
+ */
+__attribute__((noinline)) double legacyStringToDouble(const char* str, bool& success) {
+    double result = 0.0;
+    bool isNegative = false;
+    success = true;
+    int i = 0;
+    double decimalPlace = 0.1;
+    if (str[i] == '-') {
+        isNegative = true;
+        i++;
+    }
+    while (str[i] != '\0' && str[i] != '.') {
+        if (str[i] < '0' || str[i] > '9') {
+            success = false;
+            return 0.0;
+        }
+        result = result * 10 + (str[i] - '0');
+        i++;
+    }
+    if (str[i] == '.') {
+        i++;
+        while (str[i] != '\0') {
+            if (str[i] < '0' || str[i] > '9') {
+                success = false;
+                return 0.0;
+            }
+            result += (str[i] - '0') * decimalPlace;
+            decimalPlace *= 0.1;
+            i++;
+        }
+    }
+    return isNegative ? -result : result;
+}
+
+std::uint64_t bitsOf(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/**
+ * @brief Adds inputs that sit on or next to rounding boundaries, subnormals and overflow limits.
+ */
+void addAdversarialInputs(std::vector<std::string>& inputs, std::mt19937_64& rng) {
+    const char* fixed[] = {
+        "0", "-0", "+0", "0.0", "0e0", "1", "-1", "+1.5", ".5", "5.", "0.1", "0.2", "0.3",
+        "9007199254740992", "9007199254740993", "9007199254740995", "18014398509481985",
+        "1e23", "8.98846567431158e307", "1.7976931348623157e308", "1.7976931348623158e308",
+        "1.7976931348623159e308", "1e309", "2.2250738585072011e-308", "2.2250738585072012e-308",
+        "2.2250738585072014e-308", "4.9406564584124654e-324", "2.4703282292062327e-324",
+        "2.4703282292062328e-324", "1e-324", "1e-400", "7.038531e-26", "3.4028235677973366e38",
+        "123456789012345678901234567890", "0.000000000000000000000000000001234567890123456789",
+        "1.00000000000000011102230246251565404236316680908203125",
+        "1.00000000000000011102230246251565404236316680908203124",
+        "1.00000000000000011102230246251565404236316680908203126",
+        "0x1p-1074", "0x1.fffffffffffffp1023", "-0x1.8p1", "1e0000000000000000000001",
+    };
+    for (const char* text : fixed) inputs.push_back(text);
+
+    // Midpoints between neighbouring doubles, printed with 17 to 40 significant digits
+    std::uniform_int_distribution<std::uint64_t> bitsDist(1, 0x7FEFFFFFFFFFFFFFULL);
+    char text[96];
+    for (int i = 0; i < 200000; ++i) {
+        std::uint64_t bits = bitsDist(rng);
+        double low;
+        std::memcpy(&low, &bits, sizeof(low));
+        long double mid = (static_cast<long double>(low) + static_cast<long double>(std::nextafter(low, INFINITY))) / 2;
+        int digits = 16 + i % 24;
+        std::snprintf(text, sizeof(text), "%.*Le", digits, mid);
+        inputs.push_back(text);
+    }
+}
+
+/**
+ * @brief Adds random doubles printed at several precisions plus random digit strings with random exponents.
+ */
+void addRandomInputs(std::vector<std::string>& inputs, std::mt19937_64& rng, std::size_t count) {
+    std::uniform_int_distribution<std::uint64_t> bitsDist(0, 0x7FEFFFFFFFFFFFFFULL);
+    std::uniform_int_distribution<int> digitDist(0, 9);
+    std::uniform_int_distribution<int> lengthDist(1, 24);
+    std::uniform_int_distribution<int> exponentDist(-360, 330);
+    char text[96];
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i % 2 == 0) {
+            std::uint64_t bits = bitsDist(rng);
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            std::snprintf(text, sizeof(text), "%.*g", 1 + static_cast<int>(i % 19), value);
+            inputs.push_back(text);
+        } else {
+            std::string digits;
+            int length = lengthDist(rng);
+            for (int d = 0; d < length; ++d) digits += static_cast<char>('0' + digitDist(rng));
+            if (i % 3 == 0) digits.insert(digits.size() / 2, ".");
+            if (i % 5 != 0) digits += "e" + std::to_string(exponentDist(rng));
+            inputs.push_back(digits);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t randomCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+
+    std::mt19937_64 rng(2024);
+    std::vector<std::string> inputs;
+    addAdversarialInputs(inputs, rng);
+    addRandomInputs(inputs, rng, randomCount);
+
+    std::size_t mismatches = 0;
+    for (const std::string& input : inputs) {
+        char* end = nullptr;
+        double expected = std::strtod(input.c_str(), &end);
+        double actual = 0.0;
+        bool parsed = parseDouble(input, actual);
+        if (!parsed || end != input.c_str() + input.size() || bitsOf(actual) != bitsOf(expected)) {
+            if (mismatches < 20) std::printf("MISMATCH %s: parseDouble %.17g strtod %.17g\n", input.c_str(), actual, expected);
+            mismatches++;
+        }
+    }
+    std::printf("correctness: %zu inputs, %zu mismatches against strtod\n", inputs.size(), mismatches);
+
+    // Throughput on typical calculator tokens
+    std::vector<std::string> tokens;
+    std::uniform_int_distribution<int> intDist(0, 999999);
+    for (int i = 0; i < 1000000; ++i) {
+        std::string token = std::to_string(intDist(rng));
+        if (i % 2) token += "." + std::to_string(intDist(rng));
+        tokens.push_back(token);
+    }
+    double sum = 0.0;
+    double ns = bench::timeNs([&] {
+        for (const std::string& token : tokens) {
+            double value = 0.0;
+            parseDouble(token, value);
+            sum += value;
+        }
+    });
+    bench::report("parseDouble", ns, tokens.size());
+
+    ns = bench::timeNs([&] {
+        for (const std::string& token : tokens) {
+            bool success = false;
+            sum += legacyStringToDouble(token.c_str(), success);
+        }
+    });
+    bench::report("legacy stringToDouble", ns, tokens.size());
+
+    ns = bench::timeNs([&] {
+        for (const std::string& token : tokens) sum += std::strtod(token.c_str(), nullptr);
+    });
+    bench::report("strtod", ns, tokens.size());
+
+    bench::doNotOptimize(sum);
+    return mismatches == 0 ? 0 : 1;
+}
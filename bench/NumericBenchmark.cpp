@@ -0,0 +1,294 @@
+//##################################################
+// File: NumericBenchmark.cpp
+// Description: Compares evaluation throughput per numeric type and checks the int64 path stays exact.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "Workload.h"
+#include "../NumericCalculator.h"
+#include "../RPNCalculator.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Times compiled runs and re-parsing evaluation of every expression in `T`.
+ * @return The integer results' checksum of the compiled runs, so that the work is kept.
+ */
+template <typename T>
+double benchType(const char* runName, const char* evaluateName, const std::vector<std::string>& expressions, int rounds) {
+    std::vector<NumericProgram<T>> programs(expressions.size());
+    for (std::size_t i = 0; i < expressions.size(); ++i) BasicRPNCalculator<T>::compile(expressions[i], programs[i]);
+
+    BasicRPNCalculator<T> calculator;
+    int errorCode = 0;
+    T checksum = 0;
+    double ns = bench::timeNs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const NumericProgram<T>& program : programs) checksum += calculator.run(program, errorCode);
+        }
+    });
+    bench::report(runName, ns, rounds * programs.size());
+    ns = bench::timeNs([&] {
+        for (const std::string& expression : expressions) checksum += calculator.evaluate(expression, errorCode);
+    });
+    bench::report(evaluateName, ns, expressions.size());
+    bench::doNotOptimize(checksum);
+    return static_cast<double>(checksum);
+}
+
+/**
+ * @brief Checks int64 results against long double, which holds every int64 intermediate exactly,
+ *        and the adaptive results against the int64 and double calculators.
+ */
+int checkResults(const std::vector<std::string>& expressions) {
+    BasicRPNCalculator<std::int64_t> integers;
+    BasicRPNCalculator<long double> wide;
+    RPNCalculator reals;
+    AdaptiveCalculator adaptive;
+    NumericProgram<std::int64_t> program;
+    for (const std::string& expression : expressions) {
+        int integerError = 0, wideError = 0, realError = 0, adaptiveError = 0, runError = 0;
+        std::int64_t integer = integers.evaluate(expression, integerError);
+        long double exact = wide.evaluate(expression, wideError);
+        double real = reals.evaluate(std::string_view(expression), realError);
+        AdaptiveResult result = adaptive.evaluate(expression, adaptiveError);
+        AdaptiveCalculator::compile(expression, program);
+        AdaptiveResult compiled = adaptive.run(program, runError);
+
+        bool same = true;
+        if (integerError == 0) {
+            same = static_cast<long double>(integer) == exact && result.isInteger && result.integer == integer;
+        } else if (integerError == 4) {
+            same = !result.isInteger && adaptiveError == realError &&
+                   (result.real == real || (std::isnan(result.real) && std::isnan(real)));
+        } else {
+            same = adaptiveError == integerError;
+        }
+        same = same && runError == adaptiveError && compiled.isInteger == result.isInteger &&
+               (compiled.isInteger ? compiled.integer == result.integer
+                                   : compiled.real == result.real || (std::isnan(compiled.real) && std::isnan(result.real)));
+        if (!same) {
+            std::printf("MISMATCH %s: int64 %lld (error %d), adaptive %g (error %d)\n", expression.c_str(),
+                        static_cast<long long>(integer), integerError, result.value(), adaptiveError);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Malformed and variable-bearing text, where evaluating token by token could stop at a different error
+const char* const IrregularInputs[] = {
+    "1 2 x", "x 0 /", "1 1 1 - / +", "1 0 0 + / +", "1 0 /", "x 1 1 - /", "x 1 1 - / y", "1 x 0 / +",
+    "3 4 ++", "3 4 +x", "1 2 3 ++", "x$ 1 +", "2 0 max /", "x sqrt", "+", "", "0.5 0 /", "1 0.5 /",
+    "0.5 x +", "9223372036854775807 1 + 1 0 / +", "9223372036854775807 1 + x +", "2 sqrt 1 1 - /",
+};
+
+/**
+ * @brief `evaluate(s)` must report exactly what `run(compile(s))` does.
+ */
+template <typename T>
+int checkEvaluateMatchesRun(const char* typeName) {
+    int mismatches = 0;
+    BasicRPNCalculator<T> calculator;
+    NumericProgram<T> program;
+    for (const char* input : IrregularInputs) {
+        int evaluateError = 0, runError = 0;
+        T evaluated = calculator.evaluate(input, evaluateError);
+        BasicRPNCalculator<T>::compile(input, program);
+        T ran = calculator.run(program, runError);
+        if (evaluateError != runError || !(evaluated == ran || (evaluated != evaluated && ran != ran))) {
+            std::printf("MISMATCH %s \"%s\": evaluate error %d, run error %d\n", typeName, input, evaluateError, runError);
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief The same for AdaptiveCalculator, and for double against RPNCalculator.
+ */
+int checkIrregularInputs() {
+    int mismatches = checkEvaluateMatchesRun<std::int64_t>("int64_t") + checkEvaluateMatchesRun<float>("float") +
+                     checkEvaluateMatchesRun<double>("double") + checkEvaluateMatchesRun<long double>("long double");
+    AdaptiveCalculator adaptive;
+    BasicRPNCalculator<double> doubles;
+    RPNCalculator reals;
+    NumericProgram<std::int64_t> program;
+    for (const char* input : IrregularInputs) {
+        int evaluateError = 0, runError = 0, doubleError = 0, realError = 0;
+        AdaptiveResult evaluated = adaptive.evaluate(input, evaluateError);
+        AdaptiveCalculator::compile(input, program);
+        AdaptiveResult ran = adaptive.run(program, runError);
+        if (evaluateError != runError || evaluated.isInteger != ran.isInteger || evaluated.value() != ran.value()) {
+            std::printf("MISMATCH adaptive \"%s\": evaluate error %d, run error %d\n", input, evaluateError, runError);
+            mismatches++;
+        }
+        doubles.evaluate(input, doubleError);
+        reals.evaluate(std::string_view(input), realError);
+        if (doubleError != realError) {
+            std::printf("MISMATCH double \"%s\": BasicRPNCalculator error %d, RPNCalculator error %d\n", input, doubleError, realError);
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Edge cases: exactness past 2^53, overflow, inexact division and the INT64_MIN corners.
+ */
+int checkEdges() {
+    struct Case {
+        const char* expression;
+        int integerError;
+        std::int64_t integer;      ///< Expected int64 result when there is no error.
+        bool promoted;             ///< Whether the adaptive calculator falls back to double.
+        double real;               ///< Expected adaptive value.
+    };
+    const Case cases[] = {
+        { "9007199254740993 1 +", 0, 9007199254740994LL, false, 9007199254740994.0 },
+        { "9223372036854775807 1 +", 4, 0, true, 9223372036854775808.0 },
+        { "-9223372036854775808 1 -", 4, 0, true, -9223372036854775808.0 },
+        { "-9223372036854775808 -1 /", 4, 0, true, 9223372036854775808.0 },
+        { "-9223372036854775808 abs", 4, 0, true, 9223372036854775808.0 },
+        { "-9223372036854775807 1 - 1 -", 4, 0, true, -9223372036854775808.0 },
+        { "4294967296 4294967296 *", 4, 0, true, 18446744073709551616.0 },
+        { "2 62 ^ 2 *", 4, 0, true, 9223372036854775808.0 },
+        { "2 62 ^", 0, 4611686018427387904LL, false, 4611686018427387904.0 },
+        { "7 2 /", 4, 0, true, 3.5 },
+        { "-12 4 /", 0, -3, false, -3.0 },
+        { "1.5 2 *", 4, 0, true, 3.0 },
+        { "1e3 7 +", 0, 1007, false, 1007.0 },
+        { "99999999999999999999 1 -", 4, 0, true, 1e20 },
+        { "2 0.5 ^", 4, 0, true, std::sqrt(2.0) },
+        { "3037000499 3037000499 * sqrt", 0, 3037000499LL, false, 3037000499.0 },
+        { "8 sqrt", 4, 0, true, std::sqrt(8.0) },
+        { "3 0 /", 3, 0, false, 0.0 },
+        { "3 +", 1, 0, false, 0.0 },
+    };
+
+    int mismatches = 0;
+    BasicRPNCalculator<std::int64_t> integers;
+    AdaptiveCalculator adaptive;
+    for (const Case& c : cases) {
+        int integerError = 0, adaptiveError = 0;
+        std::int64_t integer = integers.evaluate(c.expression, integerError);
+        AdaptiveResult result = adaptive.evaluate(c.expression, adaptiveError);
+        bool same = integerError == c.integerError && (integerError != 0 || integer == c.integer) &&
+                    result.isInteger == !c.promoted &&
+                    (adaptiveError != 0 || (c.promoted ? result.real == c.real : result.integer == c.integer));
+        if (!same) {
+            std::printf("MISMATCH %s: int64 %lld (error %d), adaptive %.17g (error %d)\n", c.expression,
+                        static_cast<long long>(integer), integerError, result.value(), adaptiveError);
+            mismatches++;
+        }
+    }
+
+    // Malformed text fails the same way with or without a literal that forces the double pass
+    const char* malformed[][2] = {
+        { "2 1 ++", "2.5 1 ++" },           { "2 1 +x", "2.5 1 +x" },       { "2 1 2", "2.5 1 2" },
+        { "2 x +", "2.5 x +" },             { "2 0 /", "2.5 0 /" },         { "2 1 1 - / +", "2.5 1 1 - / +" },
+        { "4 sqrt +", "2.5 sqrt +" },       { "+ 2", "+ 2.5" },             { "2 1 $", "2.5 1 $" },
+    };
+    for (const auto& pair : malformed) {
+        int integerError = 0, adaptiveError = 0;
+        integers.evaluate(pair[0], integerError);
+        AdaptiveResult result = adaptive.evaluate(pair[1], adaptiveError);
+        if (integerError == 0 || adaptiveError != integerError) {
+            std::printf("MISMATCH %s: adaptive %.17g (error %d), \"%s\" in int64 gives error %d\n", pair[1],
+                        result.value(), adaptiveError, pair[0], integerError);
+            mismatches++;
+        }
+    }
+
+    // Literals are rounded once, straight to the calculator's type
+    int literalError = 0;
+    BasicRPNCalculator<float> floats;
+    float justAboveOne = floats.evaluate("1.00000005960464477539062500001", literalError);
+    if (literalError != 0 || justAboveOne != std::nextafter(1.0f, 2.0f)) {
+        std::printf("MISMATCH float literal 1.00000005960464477539062500001 gave %.9g (error %d)\n", justAboveOne, literalError);
+        mismatches++;
+    }
+    BasicRPNCalculator<long double> wide;
+    long double tenth = wide.evaluate("0.1", literalError);
+    if (literalError != 0 || tenth != 0.1L) {
+        std::printf("MISMATCH long double literal 0.1 gave %.21Lg (error %d)\n", tenth, literalError);
+        mismatches++;
+    }
+
+    // The exact sum a double calculator gets wrong
+    int errorCode = 0;
+    RPNCalculator reals;
+    if (reals.evaluate(std::string_view("9007199254740993 1 +"), errorCode) == 9007199254740994.0) {
+        std::printf("note: double unexpectedly exact past 2^53\n");
+    }
+    return mismatches;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 50;
+    int mismatches = checkEdges() + checkIrregularInputs();
+
+    // Billing-style formulas: whole numbers with sums, differences and products
+    bench::ExpressionShape integerShape;
+    integerShape.depth = 3;
+    integerShape.operators = "++-*";
+    integerShape.wholeNumbers = true;
+    const std::vector<std::string> integerFormulas = bench::makeExpressions(22, count, integerShape, Notation::RPN);
+
+    // General formulas: decimals and divisions, which the adaptive calculator mostly promotes
+    bench::ExpressionShape mixedShape;
+    mixedShape.depth = 3;
+    const std::vector<std::string> mixedFormulas = bench::makeExpressions(23, count, mixedShape, Notation::RPN);
+
+    mismatches += checkResults(integerFormulas);
+    mismatches += checkResults(mixedFormulas);
+
+    std::printf("%zu whole-number formulas, %d rounds of compiled runs\n", count, rounds);
+    benchType<std::int64_t>("int64_t run (checked)", "int64_t evaluate", integerFormulas, rounds);
+    benchType<float>("float run", "float evaluate", integerFormulas, rounds);
+    benchType<double>("double run", "double evaluate", integerFormulas, rounds);
+    benchType<long double>("long double run", "long double evaluate", integerFormulas, rounds);
+
+    RPNCalculator reals;
+    std::vector<Program> programs(count);
+    for (std::size_t i = 0; i < count; ++i) RPNCalculator::compile(integerFormulas[i], programs[i]);
+    int errorCode = 0;
+    double checksum = 0.0;
+    double ns = bench::timeNs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const Program& program : programs) checksum += reals.run(program, errorCode);
+        }
+    });
+    bench::report("RPNCalculator::run (double)", ns, rounds * count);
+
+    auto benchAdaptive = [&](const char* name, const std::vector<std::string>& formulas) {
+        std::vector<NumericProgram<std::int64_t>> compiled(formulas.size());
+        for (std::size_t i = 0; i < formulas.size(); ++i) AdaptiveCalculator::compile(formulas[i], compiled[i]);
+        AdaptiveCalculator adaptive;
+        double ns = bench::timeNs([&] {
+            for (int r = 0; r < rounds; ++r) {
+                for (const NumericProgram<std::int64_t>& program : compiled) checksum += adaptive.run(program, errorCode).value();
+            }
+        });
+        bench::report(name, ns, rounds * formulas.size());
+        std::printf("    %.1f%% promoted to double\n", 100.0 * adaptive.promotions() / (static_cast<double>(rounds) * formulas.size()));
+    };
+    benchAdaptive("AdaptiveCalculator::run (whole numbers)", integerFormulas);
+    benchAdaptive("AdaptiveCalculator::run (decimals, division)", mixedFormulas);
+
+    bench::doNotOptimize(checksum);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+//##################################################
+// File: OptimizerBenchmark.cpp
+// Description: Measures run() on generated formulas before and after optimizeProgram and checks they agree.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "../InfixCalculator.h"
+#include "../ProgramOptimizer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Appends a random RPN formula over x, y, z in the shape of generated input: constant
+ *        subtrees, multiplications by one, additions of zero and divisions by small constants.
+ */
+void randomFormula(std::mt19937_64& rng, std::string& out, int depth) {
+    std::uniform_int_distribution<int> pick(0, 9);
+    if (depth <= 0) {
+        const char* leaves[] = { "x", "y", "z", "1", "2", "0", "0.5", "3", "4", "10" };
+        out += leaves[pick(rng)];
+        out += ' ';
+        return;
+    }
+    switch (pick(rng)) {
+    case 0:
+        out += "2 3 * ";
+        randomFormula(rng, out, depth - 1);
+        out += "* ";
+        return;
+    case 1:
+        randomFormula(rng, out, depth - 1);
+        out += "1 * ";
+        return;
+    case 2:
+        randomFormula(rng, out, depth - 1);
+        out += pick(rng) < 5 ? "2 / " : "10 / ";
+        return;
+    case 3:
+        randomFormula(rng, out, depth - 1);
+        out += "0 - ";
+        return;
+    case 4:
+        out += "16 sqrt ";
+        randomFormula(rng, out, depth - 1);
+        out += "+ ";
+        return;
+    default: {
+        const char* operators[] = { "+ ", "- ", "* ", "/ " };
+        randomFormula(rng, out, depth - 1);
+        randomFormula(rng, out, depth - 1);
+        out += operators[pick(rng) % 4];
+        return;
+    }
+    }
+}
+
+bool sameResult(double a, double b) {
+    if (std::isnan(a) && std::isnan(b)) return true;
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 200;
+
+    std::mt19937_64 rng(23);
+    std::vector<Program> original;
+    while (original.size() < 5000) {
+        std::string formula;
+        randomFormula(rng, formula, 5);
+        Program program = RPNCalculator::compile(formula.c_str());
+        if (program.errorCode == 0) original.push_back(program);
+    }
+
+    std::vector<Program> optimized = original;
+    std::size_t instructionsBefore = 0;
+    std::size_t removed = 0;
+    for (Program& program : optimized) {
+        instructionsBefore += program.code.size();
+        removed += static_cast<std::size_t>(optimizeProgram(program));
+    }
+    std::printf("%zu programs, %zu instructions, %zu removed (%.1f%%)\n", optimized.size(), instructionsBefore,
+                removed, 100.0 * static_cast<double>(removed) / static_cast<double>(instructionsBefore));
+
+    // The optimized programs must agree bit for bit, including edge values and error codes
+    const double inf = std::numeric_limits<double>::infinity();
+    const double bindings[][3] = {
+        { 1.5, -2.0, 7.0 }, { 0.0, -0.0, 1.0 }, { -0.0, 0.0, -0.0 }, { inf, -inf, 2.0 },
+        { std::nan(""), 1.0, 3.0 }, { 1e308, 1e-308, 4.9e-324 }, { -3.0, 0.25, 1e-320 },
+    };
+    RPNCalculator calculator;
+    int mismatches = 0;
+    for (std::size_t i = 0; i < original.size(); ++i) {
+        for (const double* variables : bindings) {
+            int expectedError = 0, error = 0;
+            double expected = calculator.run(original[i], variables, expectedError);
+            double value = calculator.run(optimized[i], variables, error);
+            if (error != expectedError || !sameResult(value, expected)) {
+                if (mismatches++ < 10) std::printf("MISMATCH program %zu: %g (error %d), expected %g (error %d)\n",
+                                                   i, value, error, expected, expectedError);
+            }
+        }
+    }
+
+    InfixCalculator infix;
+    const char* edgeCases[] = { "x / (2 - 2)", "x + 0", "x + -0", "-(-x)", "1 * x", "x / 0.25", "x / 3", "x ^ 1" };
+    for (const char* edge : edgeCases) {
+        Program before = infix.compileInfix(edge);
+        Program after = before;
+        optimizeProgram(after);
+        for (const double* variables : bindings) {
+            int expectedError = 0, error = 0;
+            double expected = calculator.run(before, variables, expectedError);
+            double value = calculator.run(after, variables, error);
+            if (error != expectedError || !sameResult(value, expected)) {
+                std::printf("MISMATCH \"%s\": %g (error %d), expected %g (error %d)\n", edge, value, error, expected, expectedError);
+                mismatches++;
+            }
+        }
+    }
+
+    double checksum = 0.0;
+    const double variables[] = { 1.5, -2.0, 7.0 };
+    std::size_t ops = original.size() * static_cast<std::size_t>(rounds);
+
+    double ns = bench::timeNs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const Program& program : original) {
+                int errorCode = 0;
+                checksum += calculator.run(program, variables, errorCode);
+            }
+        }
+    });
+    bench::report("run (as compiled)", ns, ops);
+
+    ns = bench::timeNs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const Program& program : optimized) {
+                int errorCode = 0;
+                checksum += calculator.run(program, variables, errorCode);
+            }
+        }
+    });
+    bench::report("run (optimized)", ns, ops);
+
+    bench::doNotOptimize(checksum);
+    return mismatches == 0 ? 0 : 1;
+}
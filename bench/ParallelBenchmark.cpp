@@ -0,0 +1,84 @@
+//##################################################
+// File: ParallelBenchmark.cpp
+// Description: Reports evaluateBatch throughput (expressions/sec) at 1..N threads.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "../ParallelEvaluator.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Builds a random valid RPN expression with `operands` numbers.
+ */
+std::string randomRpn(std::mt19937_64& rng, int operands) {
+    const char operators[] = { '+', '-', '*', '/' };
+    std::uniform_int_distribution<int> number(1, 999);
+    std::uniform_int_distribution<int> op(0, 3);
+
+    std::string text = std::to_string(number(rng));
+    for (int i = 1; i < operands; ++i) {
+        text += ' ';
+        text += std::to_string(number(rng));
+        text += ' ';
+        text += operators[op(rng)];
+    }
+    return text;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    unsigned maxThreads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : std::thread::hardware_concurrency();
+    if (maxThreads == 0) maxThreads = 1;
+
+    std::mt19937_64 rng(7);
+    std::vector<std::string> storage(count);
+    std::vector<const char*> expressions(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        storage[i] = randomRpn(rng, 2 + static_cast<int>(i % 8));
+        expressions[i] = storage[i].c_str();
+    }
+
+    std::vector<double> results(count);
+    std::vector<int> errorCodes(count);
+    std::vector<double> reference(count);
+
+    // Powers of two, always ending on maxThreads
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    int mismatches = 0;
+    std::printf("%zu RPN expressions\n", count);
+    for (unsigned threads : threadCounts) {
+        WorkStealingPool pool(threads);
+        evaluateBatch(pool, expressions, Notation::RPN, results, errorCodes); // Warm up
+
+        double ns = bench::timeNs([&] {
+            evaluateBatch(pool, expressions, Notation::RPN, results, errorCodes);
+        });
+        char name[64];
+        std::snprintf(name, sizeof(name), "evaluateBatch %u thread(s)", threads);
+        bench::report(name, ns, count);
+
+        if (threads == 1) {
+            reference = results;
+        } else if (results != reference) {
+            std::printf("  MISMATCH against the single-threaded run\n");
+            mismatches++;
+        }
+    }
+    return mismatches ? 1 : 0;
+}
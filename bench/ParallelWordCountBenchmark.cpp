@@ -0,0 +1,71 @@
+//##################################################
+// File: ParallelWordCountBenchmark.cpp
+// Description: Measures parallel word counting at 1..N threads and checks its output against the AVL tree's.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "Workload.h"
+#include "../ParallelWordCount.h"
+#include "../WordCount.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+
+int main(int argc, char* argv[]) {
+    std::size_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 128;
+    unsigned maxThreads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 2 * std::thread::hardware_concurrency();
+    if (maxThreads < 8) maxThreads = 8;
+    int mismatches = 0;
+
+    // Distinct blocks so the vocabulary grows with the corpus, as it does in real text
+    std::string corpus;
+    corpus.reserve(megabytes * 1000000 + (16u << 20));
+    for (std::uint64_t seed = 19; corpus.size() < megabytes * 1000000; ++seed) {
+        corpus += bench::makeCorpus(seed, 1000000, 50000);
+    }
+    std::printf("%.1f MB corpus, %u hardware threads\n", corpus.size() / 1e6, std::thread::hardware_concurrency());
+
+    std::string expected;
+    {
+        WordCount reference(WordCountBackend::AVLTree);
+        double ns = bench::timeNs([&] { reference.processText(corpus); });
+        std::ostringstream printed;
+        reference.printWordCounts(printed);
+        expected = printed.str();
+        std::printf("%-28s %10.2f ms %10.1f MB/s\n", "AVLTree, 1 thread", ns / 1e6, corpus.size() / (ns / 1e9) / 1e6);
+    }
+
+    double single = 0.0;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        ParallelWordCount counts(threads);
+        double ns = bench::timeNs([&] { counts.processText(corpus); });
+        if (threads == 1) single = ns;
+        const ParallelWordCountStats& stats = counts.stats();
+        std::printf("%2u threads, %3u partitions   %10.2f ms %10.1f MB/s  x%5.2f  (count %.1f ms, merge+sort %.1f ms, %zu chunks)\n",
+                    threads, stats.partitions, ns / 1e6, corpus.size() / (ns / 1e9) / 1e6, single / ns,
+                    stats.countNs / 1e6, stats.mergeNs / 1e6, stats.chunks);
+        std::ostringstream printed;
+        counts.print(printed);
+        if (printed.str() != expected) {
+            std::printf("MISMATCH %u threads\n", threads);
+            mismatches++;
+        }
+    }
+
+    // Empty input, one word, and counts that accumulate over two calls
+    ParallelWordCount small(3);
+    small.processText("");
+    small.processText("Alpha");
+    small.processText("alpha, BETA alpha");
+    if (small.size() != 2 || small.count("alpha") != 3 || small.count("beta") != 1 || small.count("gamma") != 0) {
+        std::printf("MISMATCH small inputs\n");
+        mismatches++;
+    }
+    return mismatches == 0 ? 0 : 1;
+}
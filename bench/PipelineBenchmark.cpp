@@ -0,0 +1,132 @@
+//##################################################
+// File: PipelineBenchmark.cpp
+// Description: Measures the threaded expression pipeline against evaluateFile and checks its output byte for byte.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "../ExpressionPipeline.h"
+#include "../FileEvaluator.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace {
+
+/**
+ * @brief Reads a whole file into a string.
+ */
+std::string slurp(const char* path) {
+    std::string text;
+    std::FILE* file = std::fopen(path, "rb");
+    if (!file) return text;
+    char buffer[65536];
+    std::size_t got;
+    while ((got = std::fread(buffer, 1, sizeof(buffer), file)) > 0) text.append(buffer, got);
+    std::fclose(file);
+    return text;
+}
+
+/**
+ * @brief Runs the pipeline from `inputPath` into `outputPath`.
+ */
+bool runPipeline(const char* inputPath, const char* outputPath, const PipelineOptions& options, PipelineStats& stats) {
+    std::FILE* in = std::fopen(inputPath, "rb");
+    std::FILE* out = std::fopen(outputPath, "wb");
+    bool ok = in && out && evaluateStream(in, out, options, &stats);
+    if (in) std::fclose(in);
+    if (out) std::fclose(out);
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t lines = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    const char* inputPath = "/tmp/rpn_pipeline_input.txt";
+    const char* expectedPath = "/tmp/rpn_pipeline_expected.txt";
+    const char* outputPath = "/tmp/rpn_pipeline_output.txt";
+    int mismatches = 0;
+
+    // Mostly valid infix, with errors, blank lines and CRLF endings mixed in; no final newline, so a
+    // blank last line is not an expression
+    std::FILE* file = std::fopen(inputPath, "wb");
+    if (!file) {
+        std::perror(inputPath);
+        return 1;
+    }
+    std::mt19937_64 rng(16);
+    std::uniform_int_distribution<int> number(0, 999);
+    std::uniform_int_distribution<int> kind(0, 19);
+    for (std::size_t i = 0; i < lines; ++i) {
+        std::string line;
+        switch (kind(rng)) {
+        case 0: line = std::to_string(number(rng)) + " / 0"; break;
+        case 1: line = "(" + std::to_string(number(rng)) + " +"; break;
+        case 2: break;
+        default:
+            line = "(" + std::to_string(number(rng)) + " + " + std::to_string(number(rng)) + ") * " +
+                   std::to_string(number(rng)) + " - " + std::to_string(number(rng)) + " / 7";
+        }
+        if (i % 97 == 0) line += '\r';
+        if (i + 1 < lines) line += '\n';
+        std::fwrite(line.data(), 1, line.size(), file);
+    }
+    std::fclose(file);
+
+    std::FILE* expectedFile = std::fopen(expectedPath, "wb");
+    double fileNs = bench::timeNs([&] { evaluateFile(inputPath, Notation::Infix, expectedFile); });
+    std::fclose(expectedFile);
+    std::string expected = slurp(expectedPath);
+    std::size_t expectedLines = 0;
+    for (char c : expected) expectedLines += c == '\n';
+    std::printf("%zu infix lines, %u hardware threads\n", lines, std::thread::hardware_concurrency());
+    bench::report("evaluateFile (single thread)", fileNs, lines);
+
+    unsigned hardware = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+    const unsigned threadCounts[] = { 1, 2, 4, hardware };
+    const std::size_t batchSizes[] = { 256, 4096 };
+    for (unsigned threads : threadCounts) {
+        for (std::size_t batchSize : batchSizes) {
+            PipelineOptions options;
+            options.notation = Notation::Infix;
+            options.threads = threads;
+            options.batchSize = batchSize;
+            PipelineStats stats;
+            bool ok = runPipeline(inputPath, outputPath, options, stats);
+            char label[96];
+            std::snprintf(label, sizeof(label), "evaluateStream %u threads, batches of %zu", threads, batchSize);
+            bench::report(label, static_cast<double>(stats.elapsedNs), lines);
+            std::printf("  reader stalled %.1f ms, writer waited %.1f ms, max reorder %zu\n",
+                        stats.readerStallNs / 1e6, stats.writerWaitNs / 1e6, stats.maxReorder);
+            if (!ok || stats.lines != expectedLines || slurp(outputPath) != expected) {
+                std::printf("MISMATCH %s\n", label);
+                mismatches++;
+            }
+        }
+    }
+
+    // Tiny batches and the smallest window: every stage keeps blocking on the next
+    for (unsigned threads = 1; threads <= 4; ++threads) {
+        PipelineOptions options;
+        options.notation = Notation::Infix;
+        options.threads = threads;
+        options.batchSize = 3;
+        options.window = 2;
+        PipelineStats stats;
+        if (!runPipeline(inputPath, outputPath, options, stats) || slurp(outputPath) != expected) {
+            std::printf("MISMATCH %u threads, batches of 3, window 2\n", threads);
+            mismatches++;
+        }
+    }
+
+    std::remove(inputPath);
+    std::remove(expectedPath);
+    std::remove(outputPath);
+    return mismatches == 0 ? 0 : 1;
+}
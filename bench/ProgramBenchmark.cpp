@@ -0,0 +1,51 @@
+//##################################################
+// File: ProgramBenchmark.cpp
+// Description: Compares re-parsing with RPNCalculator::evaluate against compile-once RPNCalculator::run.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "../RPNCalculator.h"
+
+#include <cstdlib>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 200000;
+
+    const char* formulas[] = {
+        "3 2 5 * +",
+        "1.25 4 * 2.5 / 7 - 3 +",
+        "12 3 4 + * 6 2 / - 0.5 *",
+        "100 7 / 3 * 2 - 8 4 / 2 * +",
+    };
+    const std::size_t formulaCount = sizeof(formulas) / sizeof(formulas[0]);
+
+    std::vector<Program> programs;
+    for (const char* formula : formulas) {
+        programs.push_back(RPNCalculator::compile(formula));
+    }
+
+    RPNCalculator calculator;
+    int errorCode = 0;
+    double checksum = 0.0;
+
+    double ns = bench::timeNs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const char* formula : formulas) checksum += calculator.evaluate(formula, errorCode);
+        }
+    });
+    bench::report("RPNCalculator::evaluate (parse every call)", ns, rounds * formulaCount);
+
+    ns = bench::timeNs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const Program& program : programs) checksum += calculator.run(program, errorCode);
+        }
+    });
+    bench::report("RPNCalculator::run (compiled once)", ns, rounds * formulaCount);
+
+    bench::doNotOptimize(checksum);
+    return 0;
+}
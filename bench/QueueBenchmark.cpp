@@ -0,0 +1,199 @@
+//##################################################
+// File: QueueBenchmark.cpp
+// Description: Compares the ring-buffer Queue against the former list-backed queue and std::deque, single and batched.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "../DoublyLinkedList.h"
+#include "../Queue.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief The previous list-backed queue, kept here only as the comparison baseline.
+ */
+template <typename T>
+class ListQueue {
+public:
+    void enqueue(const T& data) { list.addToEnd(data); }
+    bool dequeue(T& out) {
+        if (list.isEmpty()) return false;
+        out = list.getHead()->data;
+        return list.popFront();
+    }
+
+private:
+    DoublyLinkedList<T> list;
+};
+
+template <typename T>
+class DequeQueue {
+public:
+    void enqueue(const T& data) { items.push_back(data); }
+    bool dequeue(T& out) {
+        if (items.empty()) return false;
+        out = items.front();
+        items.pop_front();
+        return true;
+    }
+
+private:
+    std::deque<T> items;
+};
+
+/**
+ * @brief Keeps `depth` elements queued while streaming `total` elements through, one at a time.
+ */
+template <typename QueueType>
+std::uint64_t stream(std::size_t total, std::size_t depth) {
+    QueueType queue;
+    std::uint64_t checksum = 0;
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < depth; ++i) queue.enqueue(value++);
+    for (std::size_t i = 0; i < total; ++i) {
+        std::uint64_t out = 0;
+        queue.enqueue(value++);
+        queue.dequeue(out);
+        checksum += out;
+    }
+    std::uint64_t out = 0;
+    while (queue.dequeue(out)) checksum += out;
+    return checksum;
+}
+
+/**
+ * @brief Streams `total` elements through a Queue in spans of `batch`, as a staging buffer would.
+ */
+std::uint64_t streamBatched(std::size_t total, std::size_t depth, std::size_t batch) {
+    Queue<std::uint64_t> queue;
+    std::vector<std::uint64_t> in(batch), out(batch);
+    std::uint64_t checksum = 0;
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < depth; ++i) queue.enqueue(value++);
+    for (std::size_t done = 0; done < total; done += batch) {
+        std::size_t span = total - done < batch ? total - done : batch;
+        for (std::size_t i = 0; i < span; ++i) in[i] = value++;
+        queue.enqueueBatch(in.data(), span);
+        std::size_t taken = queue.dequeueBatch(out.data(), span);
+        for (std::size_t i = 0; i < taken; ++i) checksum += out[i];
+    }
+    std::size_t taken;
+    while ((taken = queue.dequeueBatch(out.data(), batch)) > 0) {
+        for (std::size_t i = 0; i < taken; ++i) checksum += out[i];
+    }
+    return checksum;
+}
+
+/**
+ * @brief Random single and batched operations on strings and move-only values, checked against std::deque.
+ */
+int checkAgainstDeque() {
+    std::mt19937_64 rng(11);
+    std::uniform_int_distribution<int> action(0, 9);
+    std::uniform_int_distribution<std::size_t> span(0, 40);
+    Queue<std::string> queue;
+    std::deque<std::string> reference;
+    int next = 0;
+    for (int step = 0; step < 200000; ++step) {
+        int a = action(rng);
+        if (a < 4) {
+            std::string value = std::to_string(next++);
+            queue.enqueue(value);
+            reference.push_back(value);
+        } else if (a < 7) {
+            std::string out;
+            bool got = queue.dequeue(out);
+            if (got != !reference.empty() || (got && out != reference.front())) {
+                std::printf("MISMATCH dequeue at step %d\n", step);
+                return 1;
+            }
+            if (got) reference.pop_front();
+        } else if (a < 8) {
+            std::vector<std::string> values(span(rng));
+            for (std::string& value : values) value = std::to_string(next++);
+            reference.insert(reference.end(), values.begin(), values.end());
+            queue.enqueueBatch(std::make_move_iterator(values.begin()), values.size());
+        } else {
+            std::vector<std::string> out(span(rng));
+            std::size_t taken = queue.dequeueBatch(out.data(), out.size());
+            for (std::size_t i = 0; i < taken; ++i) {
+                if (out[i] != reference.front()) {
+                    std::printf("MISMATCH dequeueBatch at step %d\n", step);
+                    return 1;
+                }
+                reference.pop_front();
+            }
+        }
+        if (queue.size() != reference.size() || (!reference.empty() && queue.peek() != reference.front())) {
+            std::printf("MISMATCH size or front at step %d\n", step);
+            return 1;
+        }
+    }
+
+    Queue<std::string> copy(queue);
+    Queue<std::string> moved(std::move(copy));
+    for (const std::string& expected : reference) {
+        std::string out;
+        if (!moved.dequeue(out) || out != expected) {
+            std::printf("MISMATCH copied queue\n");
+            return 1;
+        }
+    }
+
+    // Move-only elements, through a wrap-around and a growth
+    Queue<std::unique_ptr<int>> owners;
+    for (int i = 0; i < 10; ++i) owners.enqueue(std::make_unique<int>(i));
+    for (int i = 0; i < 8; ++i) owners.dequeue();
+    for (int i = 10; i < 40; ++i) owners.enqueue(std::make_unique<int>(i));
+    std::unique_ptr<int> front;
+    std::unique_ptr<int> rest[64];
+    if (!owners.dequeue(front) || *front != 8 || owners.dequeueBatch(rest, 64) != 31 || *rest[30] != 39) {
+        std::printf("MISMATCH move-only elements\n");
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t total = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    int mismatches = checkAgainstDeque();
+
+    const std::size_t depths[] = { 16, 1000, 100000 };
+    for (std::size_t depth : depths) {
+        std::printf("streaming %zu elements with %zu queued\n", total, depth);
+        std::uint64_t expected = 0;
+        auto run = [&](const char* name, auto&& fn) {
+            std::uint64_t checksum = 0;
+            std::uint64_t allocationsBefore = bench::allocationCount();
+            double ns = bench::timeNs([&] { checksum = fn(); });
+            bench::report(name, ns, total);
+            std::printf("  %-46s %12llu\n", "allocations",
+                        static_cast<unsigned long long>(bench::allocationCount() - allocationsBefore));
+            if (expected == 0) expected = checksum;
+            else if (checksum != expected) {
+                std::printf("MISMATCH %s checksum\n", name);
+                mismatches++;
+            }
+        };
+        run("ListQueue (pooled linked list)", [&] { return stream<ListQueue<std::uint64_t>>(total, depth); });
+        run("std::deque", [&] { return stream<DequeQueue<std::uint64_t>>(total, depth); });
+        run("Queue ring buffer", [&] { return stream<Queue<std::uint64_t>>(total, depth); });
+        run("Queue ring buffer, batches of 256", [&] { return streamBatched(total, depth, 256); });
+    }
+    return mismatches == 0 ? 0 : 1;
+}
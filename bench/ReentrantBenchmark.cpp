@@ -0,0 +1,233 @@
+//##################################################
+// File: ReentrantBenchmark.cpp
+// Description: Checks that the scratch-based evaluation calls never allocate, agree with the member-stack calls and are safe to share across threads.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "Workload.h"
+#include "../InfixCalculator.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+bool same(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+/**
+ * @brief A reused calculator must not see operands left over by a call that failed.
+ */
+int checkStaleStack() {
+    struct Case {
+        const char* failing;
+        int failingError;
+    };
+    const Case cases[] = { { "5 1 0 /", 3 }, { "1 2 3 +", 2 }, { "7 8 ?", 1 }, { "4 sqrt 9 +  +", 1 } };
+
+    int mismatches = 0;
+    RPNCalculator calculator;
+    for (const Case& c : cases) {
+        int errorCode = 0;
+        calculator.evaluate(c.failing, errorCode);
+        double value = calculator.evaluate("3", errorCode);
+        if (errorCode != 0 || value != 3.0) {
+            std::printf("MISMATCH \"3\" after \"%s\" gave %g (error %d)\n", c.failing, value, errorCode);
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Expressions deeper than the scratch fail with error 6 instead of writing past it.
+ */
+int checkExhaustion() {
+    int mismatches = 0;
+    RPNCalculator rpn;
+    InfixCalculator infix;
+    FixedEvaluationScratch<4> scratch;
+    Program program;
+    RPNCalculator::compile("1 2 3 4 5 + + + +", program);
+    const EvaluationResult results[] = {
+        rpn.evaluate(std::string_view("1 2 3 4 5 + + + +"), scratch),
+        infix.evaluateInfix(std::string_view("1 + (2 * (3 - (4 / (5 + 6))))"), scratch),
+        rpn.run(program, nullptr, scratch),
+    };
+    for (const EvaluationResult& result : results) {
+        if (result.errorCode != EvaluationScratch::StackExhausted) {
+            std::printf("MISMATCH deep expression in a 4-value scratch gave error %d\n", result.errorCode);
+            mismatches++;
+        }
+    }
+    EvaluationResult fits = rpn.evaluate(std::string_view("1 2 3 4 + + +"), scratch);
+    if (!fits.ok() || fits.value != 10.0) {
+        std::printf("MISMATCH 4-deep expression in a 4-value scratch gave %g (error %d)\n", fits.value, fits.errorCode);
+        mismatches++;
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Literals too long for the fast paths still convert without allocating.
+ */
+int checkLongLiterals() {
+    const std::string digits(100, '7');
+    const std::string rpn = "0." + digits + " 1" + digits + "e-90 +";
+    const std::string infix = "0." + digits + " + 1" + digits + "e-90";
+    InfixCalculator calculator;
+    FixedEvaluationScratch<8> scratch;
+    std::uint64_t allocationsBefore = bench::allocationCount();
+    EvaluationResult rpnResult = calculator.evaluate(std::string_view(rpn), scratch);
+    EvaluationResult infixResult = calculator.evaluateInfix(std::string_view(infix), scratch);
+    std::uint64_t allocations = bench::allocationCount() - allocationsBefore;
+    if (allocations != 0 || !rpnResult.ok() || !infixResult.ok() || !same(rpnResult.value, infixResult.value)) {
+        std::printf("MISMATCH 100-digit literals: %llu allocations, errors %d/%d\n",
+                    static_cast<unsigned long long>(allocations), rpnResult.errorCode, infixResult.errorCode);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Compares every scratch-based result with the member-stack call, bit for bit.
+ */
+int checkAgreement(const std::vector<std::string>& rpnExpressions, const std::vector<std::string>& infixExpressions,
+                   const std::vector<Program>& programs, const double* variables) {
+    InfixCalculator calculator;
+    FixedEvaluationScratch<64> scratch;
+    for (std::size_t i = 0; i < rpnExpressions.size(); ++i) {
+        int rpnError = 0, infixError = 0, runError = 0;
+        double rpnValue = calculator.evaluate(std::string_view(rpnExpressions[i]), rpnError);
+        double infixValue = calculator.evaluateInfix(infixExpressions[i].c_str(), infixError);
+        double runValue = calculator.run(programs[i], variables, runError);
+        EvaluationResult rpn = calculator.evaluate(std::string_view(rpnExpressions[i]), scratch);
+        EvaluationResult infix = calculator.evaluateInfix(std::string_view(infixExpressions[i]), scratch);
+        EvaluationResult run = calculator.run(programs[i], variables, scratch);
+        if (rpn.errorCode != rpnError || !same(rpn.value, rpnValue) || infix.errorCode != infixError ||
+            !same(infix.value, infixValue) || run.errorCode != runError || !same(run.value, runValue)) {
+            std::printf("MISMATCH %s: scratch %g/%g/%g, member stack %g/%g/%g\n", rpnExpressions[i].c_str(),
+                        rpn.value, infix.value, run.value, rpnValue, infixValue, runValue);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 20;
+    int mismatches = checkStaleStack() + checkExhaustion() + checkLongLiterals();
+
+    bench::ExpressionShape shape;
+    const std::vector<std::string> rpnExpressions = bench::makeExpressions(25, count, shape, Notation::RPN);
+    const std::vector<std::string> infixExpressions = bench::makeExpressions(25, count, shape, Notation::Infix);
+    bench::ExpressionShape variableShape;
+    variableShape.variables = 4;
+    const std::vector<std::string> variableExpressions = bench::makeExpressions(26, count, variableShape, Notation::RPN);
+    std::vector<Program> programs(count);
+    for (std::size_t i = 0; i < count; ++i) RPNCalculator::compile(std::string_view(variableExpressions[i]), programs[i]);
+    const double variables[] = { 1.5, -2.0, 0.25, 8.0 };
+    mismatches += checkAgreement(rpnExpressions, infixExpressions, programs, variables);
+
+    // Steady state: the calls themselves, on one calculator, with the scratch on the caller's stack
+    const InfixCalculator calculator;
+    FixedEvaluationScratch<64> scratch;
+    double checksum = 0.0;
+    auto timed = [&](const char* name, auto&& body) {
+        std::uint64_t allocationsBefore = bench::allocationCount();
+        double ns = bench::timeNs([&] {
+            for (int r = 0; r < rounds; ++r) body();
+        });
+        std::uint64_t allocations = bench::allocationCount() - allocationsBefore;
+        bench::report(name, ns, rounds * count);
+        if (allocations != 0) {
+            std::printf("MISMATCH %s allocated %llu times\n", name, static_cast<unsigned long long>(allocations));
+            mismatches++;
+        }
+    };
+    timed("evaluate (RPN, scratch)", [&] {
+        for (const std::string& expression : rpnExpressions) checksum += calculator.evaluate(std::string_view(expression), scratch).value;
+    });
+    timed("evaluateInfix (scratch)", [&] {
+        for (const std::string& expression : infixExpressions) checksum += calculator.evaluateInfix(std::string_view(expression), scratch).value;
+    });
+    timed("run with variables (scratch)", [&] {
+        for (const Program& program : programs) checksum += calculator.run(program, variables, scratch).value;
+    });
+
+    InfixCalculator member;
+    int errorCode = 0;
+    double ns = bench::timeNs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const std::string& expression : rpnExpressions) checksum += member.evaluate(std::string_view(expression), errorCode);
+        }
+    });
+    bench::report("evaluate (RPN, member stack)", ns, rounds * count);
+    ns = bench::timeNs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const std::string& expression : infixExpressions) checksum += member.evaluateInfix(expression.c_str(), errorCode);
+        }
+    });
+    bench::report("evaluateInfix (member stack)", ns, rounds * count);
+
+    // One shared const calculator, one scratch per thread; allocations are counted only while all run
+    const unsigned threads = 4;
+    std::vector<double> sums(threads, 0.0);
+    std::atomic<unsigned> ready{ 0 };
+    std::atomic<bool> go{ false };
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            FixedEvaluationScratch<64> own;
+            ready.fetch_add(1);
+            while (!go.load()) std::this_thread::yield();
+            double sum = 0.0;
+            for (std::size_t i = t; i < count; i += threads) {
+                sum += calculator.evaluate(std::string_view(rpnExpressions[i]), own).value;
+                sum += calculator.evaluateInfix(std::string_view(infixExpressions[i]), own).value;
+                sum += calculator.run(programs[i], variables, own).value;
+            }
+            sums[t] = sum;
+        });
+    }
+    while (ready.load() != threads) std::this_thread::yield();
+    std::uint64_t allocationsBefore = bench::allocationCount();
+    go.store(true);
+    for (std::thread& worker : workers) worker.join();
+    std::uint64_t threadAllocations = bench::allocationCount() - allocationsBefore;
+    if (threadAllocations != 0) {
+        std::printf("MISMATCH %u threads allocated %llu times\n", threads, static_cast<unsigned long long>(threadAllocations));
+        mismatches++;
+    }
+
+    // Each thread's share, evaluated again on this thread, must give the same sum
+    for (unsigned t = 0; t < threads; ++t) {
+        double sum = 0.0;
+        for (std::size_t i = t; i < count; i += threads) {
+            sum += calculator.evaluate(std::string_view(rpnExpressions[i]), scratch).value;
+            sum += calculator.evaluateInfix(std::string_view(infixExpressions[i]), scratch).value;
+            sum += calculator.run(programs[i], variables, scratch).value;
+        }
+        if (!same(sum, sums[t])) {
+            std::printf("MISMATCH thread %u sum %.17g, expected %.17g\n", t, sums[t], sum);
+            mismatches++;
+        }
+    }
+    std::printf("%u threads sharing one calculator: %llu allocations\n", threads, static_cast<unsigned long long>(threadAllocations));
+
+    bench::doNotOptimize(checksum);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,136 @@
+//##################################################
+// File: SnapshotBenchmark.cpp
+// Description: Measures snapshot load and incremental updates against a full recount and checks the counts agree.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "Workload.h"
+#include "../IncrementalWordCount.h"
+#include "../WordCount.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+bool writeFile(const char* path, const std::string& text, const char* mode) {
+    std::FILE* file = std::fopen(path, mode);
+    if (!file) return false;
+    bool ok = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+std::string fullCount(const char* path) {
+    WordCount counter;
+    counter.readFile(path);
+    std::ostringstream printed;
+    counter.printWordCounts(printed);
+    return printed.str();
+}
+
+std::string printedCounts(const IncrementalWordCount& counts) {
+    std::ostringstream printed;
+    counts.print(printed);
+    return printed.str();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t words = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    const char* path = "/tmp/rpn_snapshot_log.txt";
+    const char* snapshotPath = "/tmp/rpn_snapshot.bin";
+    int mismatches = 0;
+
+    // The log so far ends in the middle of a word; the append completes it
+    const std::string corpus = bench::makeCorpus(21, words, words / 20);
+    std::size_t cut = corpus.size() - corpus.size() / 100;
+    while (cut > 0 && !(corpus[cut - 1] >= 'a' && corpus[cut - 1] <= 'z')) cut--;
+    if (!writeFile(path, corpus.substr(0, cut), "wb")) {
+        std::perror(path);
+        return 1;
+    }
+
+    IncrementalWordCount first;
+    double countNs = bench::timeNs([&] { first.update(path); });
+    double saveNs = bench::timeNs([&] { first.saveSnapshot(snapshotPath); });
+    std::printf("%zu words, %zu distinct, %.1f MB log\n", words, first.distinctWords(), cut / 1e6);
+    std::printf("%-36s %10.2f ms\n", "first run: count 99%", countNs / 1e6);
+    std::printf("%-36s %10.2f ms\n", "save snapshot", saveNs / 1e6);
+
+    writeFile(path, corpus.substr(cut), "ab");
+    IncrementalWordCount second;
+    bool loaded = false;
+    double loadNs = bench::timeNs([&] { loaded = second.loadSnapshot(snapshotPath); });
+    double updateNs = bench::timeNs([&] { second.update(path); });
+    std::string expected;
+    double fullNs = bench::timeNs([&] { expected = fullCount(path); });
+    std::printf("%-36s %10.2f ms\n", "second run: load snapshot", loadNs / 1e6);
+    std::printf("%-36s %10.2f ms\n", "second run: count appended 1%", updateNs / 1e6);
+    std::printf("%-36s %10.2f ms  (load is %.1f%% of it)\n", "full recount with WordCount", fullNs / 1e6, 100.0 * loadNs / fullNs);
+    if (!loaded || second.restarted() || printedCounts(second) != expected) {
+        std::printf("MISMATCH resumed counts\n");
+        mismatches++;
+    }
+
+    // A replaced file is counted from the start
+    writeFile(path, "Rotated log\nrotated again\n", "wb");
+    second.update(path);
+    if (!second.restarted() || printedCounts(second) != fullCount(path)) {
+        std::printf("MISMATCH after rotation\n");
+        mismatches++;
+    }
+
+    // A damaged snapshot is refused
+    std::string damaged;
+    {
+        std::FILE* file = std::fopen(snapshotPath, "rb");
+        char buffer[65536];
+        std::size_t got;
+        while (file && (got = std::fread(buffer, 1, sizeof(buffer), file)) > 0) damaged.append(buffer, got);
+        if (file) std::fclose(file);
+    }
+    damaged[damaged.size() / 2] ^= 1;
+    writeFile(snapshotPath, damaged, "wb");
+    IncrementalWordCount third;
+    bool accepted = third.loadSnapshot(snapshotPath);
+    writeFile(snapshotPath, damaged.substr(0, 50), "wb");
+    accepted = accepted || third.loadSnapshot(snapshotPath);
+    if (accepted) {
+        std::printf("MISMATCH damaged snapshot accepted\n");
+        mismatches++;
+    }
+
+    // Follow a file while another thread appends to it, sometimes mid-word
+    writeFile(path, "", "wb");
+    std::atomic<bool> stop(false);
+    IncrementalWordCount followed;
+    std::thread appender([&] {
+        const char* pieces[] = { "alpha be", "ta\ngamma ", "Alpha", " delta\n", "beta" };
+        for (const char* piece : pieces) {
+            writeFile(path, piece, "ab");
+            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        stop.store(true);
+    });
+    int growths = 0;
+    followed.follow(path, std::chrono::milliseconds(10), stop, [&] { growths++; });
+    appender.join();
+    if (growths == 0 || printedCounts(followed) != fullCount(path)) {
+        std::printf("MISMATCH follow mode\n");
+        mismatches++;
+    }
+
+    std::remove(path);
+    std::remove(snapshotPath);
+    return mismatches == 0 ? 0 : 1;
+}
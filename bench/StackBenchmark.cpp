@@ -0,0 +1,87 @@
+//##################################################
+// File: StackBenchmark.cpp
+// Description: Compares push/pop throughput of the contiguous Stack against the former linked-list stack.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "../DoublyLinkedList.h"
+#include "../Stack.h"
+
+#include <cstdlib>
+
+namespace {
+
+/**
+ * @brief The previous list-backed stack, kept here only as the comparison baseline.
+ * @note `pop` deletes by value, so it scans from the head and removes the first match.
+ */
+template <typename T>
+class ListStack {
+public:
+    void push(const T& data) { list.addToEnd(data); }
+    bool pop() {
+        if (list.getHead() == nullptr) return false;
+        T topData = list.getTail()->data;
+        list.deleteNode(topData);
+        return true;
+    }
+    T peek() const { return list.getTail() ? list.getTail()->data : T(); }
+    bool isEmpty() const { return list.getHead() == nullptr; }
+
+private:
+    DoublyLinkedList<T> list;
+};
+
+/**
+ * @brief Pushes `depth` values then pops them all, returning a checksum of the popped values.
+ * @param distinct When false every value is identical, which is the best case for `ListStack::pop`.
+ */
+template <typename StackType>
+double pushPopCycle(StackType& stack, std::size_t depth, bool distinct) {
+    for (std::size_t i = 0; i < depth; ++i) {
+        stack.push(distinct ? static_cast<double>(i) : 1.0);
+    }
+    double sum = 0.0;
+    while (!stack.isEmpty()) {
+        sum += stack.peek();
+        stack.pop();
+    }
+    return sum;
+}
+
+template <typename StackType>
+void runCase(const char* name, std::size_t depth, int rounds, bool distinct) {
+    double checksum = 0.0;
+    double ns = bench::timeNs([&] {
+        for (int r = 0; r < rounds; ++r) {
+            StackType stack;
+            checksum += pushPopCycle(stack, depth, distinct);
+        }
+    });
+    bench::doNotOptimize(checksum);
+    bench::report(name, ns, 2 * depth * static_cast<std::size_t>(rounds));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t depth = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::size_t scanDepth = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000;
+
+    std::printf("push/pop of %zu elements (identical values)\n", depth);
+    runCase<Stack<double>>("Stack<double> contiguous", depth, 5, false);
+    runCase<ListStack<double>>("ListStack<double> linked list", depth, 5, false);
+
+    // With distinct values every list pop has to walk the whole list to find the tail value,
+    // so this case is run at a smaller depth to keep the baseline from taking hours.
+    std::printf("push/pop of %zu elements (distinct values)\n", scanDepth);
+    runCase<Stack<double>>("Stack<double> contiguous", scanDepth, 5, true);
+    runCase<ListStack<double>>("ListStack<double> linked list", scanDepth, 5, true);
+
+    std::printf("push/pop of %zu elements (distinct values, contiguous only)\n", depth);
+    runCase<Stack<double>>("Stack<double> contiguous", depth, 5, true);
+    return 0;
+}
@@ -0,0 +1,238 @@
+//##################################################
+// File: Suite.cpp
+// Description: Runs every hot-path benchmark on generated workloads and gates on a stored JSON baseline.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "Workload.h"
+#include "../DoublyLinkedList.h"
+#include "../ExpressionCache.h"
+#include "../InfixCalculator.h"
+#include "../NumberParser.h"
+#include "../Queue.h"
+#include "../Stack.h"
+#include "../WordCount.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    const char* filter = nullptr;
+    const char* jsonPath = nullptr;
+    const char* baselinePath = nullptr;
+    double thresholdPercent = 20.0;
+    double scale = 1.0;
+    int repeats = 7;
+    std::uint64_t seed = 1;
+    bench::ExpressionShape shape;
+};
+
+void usage() {
+    std::printf("usage: rpn-bench [--filter TEXT] [--repeat N] [--scale F] [--seed N]\n"
+                "                 [--depth N] [--operators CHARS] [--json FILE]\n"
+                "                 [--compare BASELINE.json] [--threshold PERCENT]\n");
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (std::strcmp(arg, "--help") == 0) return false;
+        if (!value) {
+            std::fprintf(stderr, "missing value for %s\n", arg);
+            return false;
+        }
+        if (std::strcmp(arg, "--filter") == 0) options.filter = value;
+        else if (std::strcmp(arg, "--json") == 0) options.jsonPath = value;
+        else if (std::strcmp(arg, "--compare") == 0) options.baselinePath = value;
+        else if (std::strcmp(arg, "--threshold") == 0) options.thresholdPercent = std::atof(value);
+        else if (std::strcmp(arg, "--scale") == 0) options.scale = std::atof(value);
+        else if (std::strcmp(arg, "--repeat") == 0) options.repeats = std::atoi(value);
+        else if (std::strcmp(arg, "--seed") == 0) options.seed = std::strtoull(value, nullptr, 10);
+        else if (std::strcmp(arg, "--depth") == 0) options.shape.depth = std::atoi(value);
+        else if (std::strcmp(arg, "--operators") == 0) options.shape.operators = value;
+        else {
+            std::fprintf(stderr, "unknown option %s\n", arg);
+            return false;
+        }
+        i++;
+    }
+    return options.scale > 0 && options.repeats > 0;
+}
+
+std::size_t scaled(const Options& options, std::size_t count) {
+    std::size_t n = static_cast<std::size_t>(static_cast<double>(count) * options.scale);
+    return n ? n : 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        usage();
+        return 2;
+    }
+
+    std::vector<bench::Result> results;
+    double checksum = 0.0;
+    auto run = [&](const char* name, std::size_t ops, auto&& fn) {
+        if (options.filter && !std::strstr(name, options.filter)) return;
+        bench::Result result = bench::measure(name, ops, options.repeats, fn);
+        std::printf("%-32s %10.2f ns/op %10.3f allocs/op %8.1f MiB peak RSS\n",
+                    name, result.nsPerOp, result.allocsPerOp, static_cast<double>(result.peakRssKb) / 1024.0);
+        results.push_back(result);
+    };
+
+    // Containers: fill to a fixed depth then drain, the pattern the calculators use
+    const std::size_t depth = 1000;
+    const std::size_t containerRounds = scaled(options, 500);
+    run("stack.push_pop", 2 * depth * containerRounds, [&] {
+        Stack<double> stack;
+        for (std::size_t r = 0; r < containerRounds; ++r) {
+            for (std::size_t i = 0; i < depth; ++i) stack.push(static_cast<double>(i));
+            while (stack.pop()) {}
+        }
+        checksum += static_cast<double>(stack.size());
+    });
+    run("list.add_delete_front", 2 * depth * containerRounds, [&] {
+        DoublyLinkedList<int> list;
+        for (std::size_t r = 0; r < containerRounds; ++r) {
+            for (std::size_t i = 0; i < depth; ++i) list.addToEnd(static_cast<int>(i));
+            while (list.getHead()) list.deleteNode(list.getHead()->data);
+        }
+    });
+    run("queue.enqueue_dequeue", 2 * depth * containerRounds, [&] {
+        Queue<int> queue;
+        for (std::size_t r = 0; r < containerRounds; ++r) {
+            for (std::size_t i = 0; i < depth; ++i) queue.enqueue(static_cast<int>(i));
+            while (queue.dequeue()) {}
+        }
+    });
+
+    // Calculators over generated expressions
+    const std::size_t expressionCount = scaled(options, 2000);
+    const std::vector<std::string> rpn = bench::makeExpressions(options.seed, expressionCount, options.shape, Notation::RPN);
+    const std::vector<std::string> infix = bench::makeExpressions(options.seed, expressionCount, options.shape, Notation::Infix);
+    const int evaluationRounds = 25;
+    const std::size_t evaluations = expressionCount * evaluationRounds;
+
+    RPNCalculator calculator;
+    InfixCalculator infixCalculator;
+    std::vector<Program> programs(expressionCount);
+
+    run("rpn.evaluate", evaluations, [&] {
+        for (int r = 0; r < evaluationRounds; ++r) {
+            for (const std::string& expression : rpn) {
+                int errorCode = 0;
+                checksum += calculator.evaluate(expression.c_str(), errorCode);
+            }
+        }
+    });
+    run("rpn.compile", evaluations, [&] {
+        for (int r = 0; r < evaluationRounds; ++r) {
+            for (std::size_t i = 0; i < expressionCount; ++i) RPNCalculator::compile(rpn[i].c_str(), programs[i]);
+        }
+    });
+    for (std::size_t i = 0; i < expressionCount; ++i) RPNCalculator::compile(rpn[i].c_str(), programs[i]);
+    run("rpn.run", evaluations, [&] {
+        for (int r = 0; r < evaluationRounds; ++r) {
+            for (const Program& program : programs) {
+                int errorCode = 0;
+                checksum += calculator.run(program, errorCode);
+            }
+        }
+    });
+    run("infix.evaluate", evaluations, [&] {
+        for (int r = 0; r < evaluationRounds; ++r) {
+            for (const std::string& expression : infix) {
+                int errorCode = 0;
+                checksum += infixCalculator.evaluateInfix(expression.c_str(), errorCode);
+            }
+        }
+    });
+    run("infix.compile", evaluations, [&] {
+        for (int r = 0; r < evaluationRounds; ++r) {
+            for (std::size_t i = 0; i < expressionCount; ++i) infixCalculator.compileInfix(infix[i].c_str(), programs[i]);
+        }
+    });
+
+    ExpressionCache cache(16 << 20);
+    InfixCalculator cachedCalculator;
+    cachedCalculator.setCache(&cache);
+    for (const std::string& expression : infix) {
+        int errorCode = 0;
+        cachedCalculator.evaluateInfix(expression.c_str(), errorCode);
+    }
+    run("cache.hit", evaluations, [&] {
+        for (int r = 0; r < evaluationRounds; ++r) {
+            for (const std::string& expression : infix) {
+                int errorCode = 0;
+                checksum += cachedCalculator.evaluateInfix(expression.c_str(), errorCode);
+            }
+        }
+    });
+
+    std::vector<std::string> numbers;
+    for (const std::string& expression : rpn) {
+        std::size_t start = 0;
+        while (start < expression.size()) {
+            std::size_t end = expression.find(' ', start);
+            if (end == std::string::npos) end = expression.size();
+            if (end - start > 1 || (expression[start] >= '0' && expression[start] <= '9')) {
+                numbers.push_back(expression.substr(start, end - start));
+            }
+            start = end + 1;
+        }
+    }
+    run("number.parse", numbers.size(), [&] {
+        for (const std::string& number : numbers) {
+            double value = 0.0;
+            parseDouble(number, value);
+            checksum += value;
+        }
+    });
+
+    // Word counting over a Zipf-distributed corpus
+    const std::size_t corpusWords = scaled(options, 200000);
+    std::vector<std::string> lines;
+    {
+        std::istringstream corpus(bench::makeCorpus(options.seed, corpusWords, corpusWords / 20));
+        std::string line;
+        while (std::getline(corpus, line)) lines.push_back(line);
+    }
+    run("wordcount.build", corpusWords, [&] {
+        WordCount counter;
+        for (const std::string& line : lines) counter.processLine(line);
+    });
+
+    bench::doNotOptimize(checksum);
+
+    if (options.jsonPath && !bench::writeJson(options.jsonPath, results)) {
+        std::fprintf(stderr, "cannot write %s\n", options.jsonPath);
+        return 2;
+    }
+    if (options.baselinePath) {
+        std::vector<bench::Result> baseline;
+        if (!bench::readJson(options.baselinePath, baseline)) {
+            std::fprintf(stderr, "cannot read baseline %s\n", options.baselinePath);
+            return 2;
+        }
+        std::printf("\n");
+        int regressions = bench::compareResults(results, baseline, options.thresholdPercent);
+        if (regressions > 0) {
+            std::printf("%d benchmark(s) regressed more than %.1f%%\n", regressions, options.thresholdPercent);
+            return 1;
+        }
+    }
+    return 0;
+}
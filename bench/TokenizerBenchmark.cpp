@@ -0,0 +1,112 @@
+//##################################################
+// File: TokenizerBenchmark.cpp
+// Description: Measures word tokenization throughput per SIMD level against the former per-character splitter.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "Workload.h"
+#include "../WordTokenizer.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief The splitter WordCount used before: `isalnum` and `tolower` one character at a time.
+ */
+template <typename Fn>
+void tokenizeReference(std::string_view text, Fn&& onWord) {
+    std::string word;
+    for (char c : text) {
+        if (std::isalnum(static_cast<unsigned char>(c))) {
+            word += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        } else if (!word.empty()) {
+            onWord(std::string_view(word));
+            word.clear();
+        }
+    }
+    if (!word.empty()) onWord(std::string_view(word));
+}
+
+std::vector<std::string> collect(std::string_view text, SimdLevel level) {
+    std::vector<std::string> words;
+    tokenizeWords(text, [&](std::string_view word) { words.emplace_back(word); }, level);
+    return words;
+}
+
+/**
+ * @brief Checks every level against the reference on random bytes (all 256 values) and on every
+ *        alignment and length of a short text, so words cross block edges and the padded tail.
+ */
+int checkAgainstReference() {
+    std::mt19937_64 rng(18);
+    std::vector<std::string> texts;
+    std::string random(1 << 20, '\0');
+    std::uniform_int_distribution<int> byte(0, 255);
+    for (char& c : random) c = static_cast<char>(byte(rng));
+    texts.push_back(random);
+    std::string sample = "Hello, WORLD! x86-64 caf\xc3\xa9 [Zz] `a` {b} @c 0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz/";
+    for (std::size_t start = 0; start < sample.size(); ++start) {
+        for (std::size_t length = 0; start + length <= sample.size(); length += 7) texts.push_back(sample.substr(start, length));
+    }
+    texts.push_back(std::string(200, 'Q'));
+
+    const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2 };
+    for (const std::string& text : texts) {
+        std::vector<std::string> expected;
+        tokenizeReference(text, [&](std::string_view word) { expected.emplace_back(word); });
+        for (SimdLevel level : levels) {
+            if (collect(text, level) != expected) {
+                std::printf("MISMATCH level %d on a %zu-byte text\n", static_cast<int>(level), text.size());
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 256;
+    int mismatches = checkAgainstReference();
+
+    const std::string block = bench::makeCorpus(18, 2000000, 100000);
+    std::string corpus;
+    corpus.reserve(megabytes * 1000000 + block.size());
+    while (corpus.size() < megabytes * 1000000) corpus += block;
+    std::printf("%.1f MB corpus\n", corpus.size() / 1e6);
+
+    std::uint64_t expectedWords = 0, expectedBytes = 0;
+    auto run = [&](const char* name, auto&& tokenize) {
+        std::uint64_t words = 0, bytes = 0;
+        double ns = bench::timeNs([&] {
+            tokenize([&](std::string_view word) {
+                words++;
+                bytes += word.size() + static_cast<unsigned char>(word[0]);
+            });
+        });
+        std::printf("%-36s %10.2f ms %10.1f MB/s %8.2f ns/word\n", name, ns / 1e6,
+                    corpus.size() / (ns / 1e9) / 1e6, words ? ns / static_cast<double>(words) : 0.0);
+        if (expectedWords == 0) {
+            expectedWords = words;
+            expectedBytes = bytes;
+        } else if (words != expectedWords || bytes != expectedBytes) {
+            std::printf("MISMATCH %s: %llu words\n", name, static_cast<unsigned long long>(words));
+            mismatches++;
+        }
+    };
+    run("isalnum/tolower per character", [&](auto&& onWord) { tokenizeReference(corpus, onWord); });
+    run("tokenizeWords scalar", [&](auto&& onWord) { tokenizeWords(corpus, onWord, SimdLevel::Scalar); });
+    run("tokenizeWords SSE2", [&](auto&& onWord) { tokenizeWords(corpus, onWord, SimdLevel::SSE2); });
+    run("tokenizeWords AVX2", [&](auto&& onWord) { tokenizeWords(corpus, onWord, SimdLevel::AVX2); });
+    return mismatches == 0 ? 0 : 1;
+}
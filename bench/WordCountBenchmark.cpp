@@ -0,0 +1,66 @@
+//##################################################
+// File: WordCountBenchmark.cpp
+// Description: Compares the hash-table and AVL-tree word count backends on a generated corpus file.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Benchmark.h"
+#include "Workload.h"
+#include "../WordCount.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    std::size_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+    const char* path = argc > 2 ? argv[2] : "/tmp/rpn_wordcount_corpus.txt";
+
+    // A Zipf-distributed block of about 30 MB repeated up to the requested size
+    std::FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        std::perror(path);
+        return 1;
+    }
+    const std::string block = bench::makeCorpus(17, 4000000, 200000);
+    const std::size_t target = megabytes * 1000000;
+    std::size_t bytes = 0;
+    while (bytes < target) {
+        std::size_t span = target - bytes < block.size() ? target - bytes : block.size();
+        while (span < block.size() && span > 0 && block[span - 1] != '\n') span--; // End on a whole line
+        if (span == 0) break;
+        bytes += std::fwrite(block.data(), 1, span, file);
+    }
+    std::fclose(file);
+    std::printf("%.1f MB corpus, %zu distinct words per block\n", bytes / 1e6, static_cast<std::size_t>(200000));
+
+    std::string expected;
+    int mismatches = 0;
+    auto run = [&](const char* name, WordCountBackend backend) {
+        std::ostringstream printed;
+        std::uint64_t allocationsBefore = bench::allocationCount();
+        double ns = 0.0;
+        {
+            WordCount counter(backend);
+            ns = bench::timeNs([&] { counter.readFile(path); });
+            double printNs = bench::timeNs([&] { counter.printWordCounts(printed); });
+            std::printf("%-32s %10.2f ms  %8.1f MB/s  print %8.2f ms  %12llu allocations\n", name, ns / 1e6,
+                        bytes / (ns / 1e9) / 1e6, printNs / 1e6,
+                        static_cast<unsigned long long>(bench::allocationCount() - allocationsBefore));
+        }
+        if (expected.empty()) expected = printed.str();
+        else if (printed.str() != expected) {
+            std::printf("MISMATCH %s output\n", name);
+            mismatches++;
+        }
+    };
+    run("AVLTree", WordCountBackend::AVLTree);
+    run("WordTable (hash + arena)", WordCountBackend::HashTable);
+    std::printf("peak RSS %ld KB\n", bench::peakRssKb());
+
+    std::remove(path);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,136 @@
+//##################################################
+// File: Workload.cpp
+// Description: Seeded generators of synthetic expressions and word corpora for the benchmarks.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#include "Workload.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace bench {
+
+namespace {
+
+/**
+ * @brief Appends one random expression tree in the requested notation.
+ * @note Infix output parenthesizes every operator operand, so each tree has exactly one meaning in
+ *       both notations.
+ */
+void appendExpression(std::mt19937_64& rng, const ExpressionShape& shape, Notation notation, int depth, std::string& out) {
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    if (depth <= 0 || chance(rng) < shape.leafChance || shape.operators.empty()) {
+        std::uniform_int_distribution<unsigned> pick(0, 9);
+        if (shape.variables > 0 && pick(rng) < 3) {
+            std::uniform_int_distribution<unsigned> variable(0, shape.variables - 1);
+            out += 'x';
+            out += std::to_string(variable(rng));
+        } else if (shape.wholeNumbers || pick(rng) < 7) {
+            std::uniform_int_distribution<int> integer(1, 999);
+            out += std::to_string(integer(rng));
+        } else {
+            std::uniform_int_distribution<int> hundredths(1, 99999);
+            int value = hundredths(rng);
+            out += std::to_string(value / 100);
+            out += '.';
+            out += static_cast<char>('0' + value / 10 % 10);
+            out += static_cast<char>('0' + value % 10);
+        }
+        return;
+    }
+
+    std::uniform_int_distribution<std::size_t> pickOperator(0, shape.operators.size() - 1);
+    char op = shape.operators[pickOperator(rng)];
+    if (notation == Notation::RPN) {
+        appendExpression(rng, shape, notation, depth - 1, out);
+        out += ' ';
+        appendExpression(rng, shape, notation, depth - 1, out);
+        out += ' ';
+        out += op;
+        return;
+    }
+    for (int side = 0; side < 2; ++side) {
+        std::size_t start = out.size();
+        appendExpression(rng, shape, notation, depth - 1, out);
+        bool isOperand = out.find(' ', start) == std::string::npos;
+        if (!isOperand) {
+            out.insert(start, 1, '(');
+            out += ')';
+        }
+        if (side == 0) {
+            out += ' ';
+            out += op;
+            out += ' ';
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Generates random well-formed expressions.
+ * @param seed Seed for the generator; equal seeds give equal lists.
+ * @param count Number of expressions.
+ * @param shape Depth, operator mix and variables.
+ * @param notation Whether to write RPN or infix.
+ * @return The expressions.
+ */
+std::vector<std::string> makeExpressions(std::uint64_t seed, std::size_t count, const ExpressionShape& shape, Notation notation) {
+    std::mt19937_64 rng(seed);
+    std::vector<std::string> expressions(count);
+    for (std::string& expression : expressions) {
+        appendExpression(rng, shape, notation, shape.depth, expression);
+    }
+    return expressions;
+}
+
+/**
+ * @brief Generates a text corpus for the word counter.
+ * @param seed Seed for the generator.
+ * @param words Number of words in the corpus.
+ * @param vocabulary Number of distinct words; word ranks follow a Zipf distribution like natural text.
+ * @return Lines of about a dozen words with capitalization and punctuation to be stripped.
+ */
+std::string makeCorpus(std::uint64_t seed, std::size_t words, std::size_t vocabulary) {
+    std::mt19937_64 rng(seed);
+    vocabulary = std::max<std::size_t>(vocabulary, 1);
+
+    std::uniform_int_distribution<int> length(2, 10);
+    std::uniform_int_distribution<int> letter(0, 25);
+    std::vector<std::string> dictionary(vocabulary);
+    for (std::string& word : dictionary) {
+        int letters = length(rng);
+        for (int i = 0; i < letters; ++i) word += static_cast<char>('a' + letter(rng));
+    }
+
+    // Zipf weights 1/rank, sampled through the cumulative distribution
+    std::vector<double> cumulative(vocabulary);
+    double total = 0.0;
+    for (std::size_t rank = 0; rank < vocabulary; ++rank) {
+        total += 1.0 / static_cast<double>(rank + 1);
+        cumulative[rank] = total;
+    }
+    std::uniform_real_distribution<double> sample(0.0, total);
+    std::uniform_int_distribution<int> decoration(0, 19);
+
+    std::string corpus;
+    corpus.reserve(words * 8);
+    for (std::size_t i = 0; i < words; ++i) {
+        std::size_t rank = static_cast<std::size_t>(
+            std::lower_bound(cumulative.begin(), cumulative.end(), sample(rng)) - cumulative.begin());
+        std::string word = dictionary[std::min(rank, vocabulary - 1)];
+        int style = decoration(rng);
+        if (style == 0) word[0] = static_cast<char>(word[0] - 'a' + 'A');
+        corpus += word;
+        if (style == 1) corpus += ',';
+        if (style == 2) corpus += '.';
+        corpus += i % 12 == 11 ? '\n' : ' ';
+    }
+    return corpus;
+}
+
+} // namespace bench
@@ -0,0 +1,37 @@
+//##################################################
+// File: Workload.h
+// Description: Seeded generators of synthetic expressions and word corpora for the benchmarks.
+// Date: Oct,16 2026
+//##################################################
+
+
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include "../Program.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/**
+ * @brief The shape of generated expressions.
+ */
+struct ExpressionShape {
+    int depth = 4;                   ///< Maximum nesting of operators; an expression has at most 2^depth operands.
+    double leafChance = 0.2;         ///< Chance that a subtree above the maximum depth is a single operand.
+    std::string operators = "+-*/";  ///< Operator mix; repeat a character to make it more likely.
+    unsigned variables = 0;          ///< Distinct variables (x0, x1, ...) mixed in with the numbers.
+    bool wholeNumbers = false;       ///< Only integer literals (no "12.34" operands).
+};
+
+std::vector<std::string> makeExpressions(std::uint64_t seed, std::size_t count, const ExpressionShape& shape, Notation notation); ///< Generates expressions; the same seed gives the same list.
+std::string makeCorpus(std::uint64_t seed, std::size_t words, std::size_t vocabulary); ///< Generates text with Zipf-distributed words, mixed case and punctuation.
+
+} // namespace bench
+
+#endif // WORKLOAD_H
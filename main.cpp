@@ -1,183 +1,215 @@
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
-#include <fstream>
-#include <sstream>
-#include <cctype>
+#include <memory>
 #include <string>
+#include "CsvEvaluator.h"
+#include "ExpressionPipeline.h"
+#include "FileEvaluator.h"
+#include "IncrementalWordCount.h"
+#include "ParallelWordCount.h"
+#include "WordCount.h"
 using namespace std;
 
-// Node structure for AVL Tree
-struct AVLNode {
-    string word;
-    int count;  // Frequency of the word
-    AVLNode* left;
-    AVLNode* right;
-    int height;
+// Set by Ctrl-C to end --follow
+atomic<bool> stopRequested(false);
 
-    AVLNode(string w, int c = 1) : word(w), count(c), left(nullptr), right(nullptr), height(1) {}
-};
-
-// AVL Tree class
-class AVLTree {
-private:
-    AVLNode* root;
+void requestStop(int) {
+    stopRequested.store(true);
+}
 
-    // Helper function to get the height of a node
-    int height(AVLNode* node) const {
-        return node ? node->height : 0;
+// Streaming mode: rpn-calculator --evaluate [--rpn|--infix] [--threads N] [--batch-size N] [--window N] [--stats] [FILE|-]
+int runEvaluate(int argc, char* argv[]) {
+    PipelineOptions options;
+    bool printStats = false;
+    const char* path = "-";
+    for (int i = 2; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--rpn") options.notation = Notation::RPN;
+        else if (arg == "--infix") options.notation = Notation::Infix;
+        else if (arg == "--stats") printStats = true;
+        else if (arg == "--threads" && hasValue) options.threads = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--batch-size" && hasValue) options.batchSize = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--window" && hasValue) options.window = strtoull(argv[++i], nullptr, 10);
+        else if (arg.size() > 1 && arg[0] == '-') {
+            cerr << "Unknown option: " << arg << endl;
+            return 2;
+        }
+        else path = argv[i];
     }
 
-    // Helper function to calculate the balance factor
-    int getBalanceFactor(AVLNode* node) const {
-        return node ? height(node->left) - height(node->right) : 0;
+    FILE* in = string(path) == "-" ? stdin : fopen(path, "rb");
+    if (!in) {
+        cerr << "Cannot open input: " << path << endl;
+        return 1;
     }
-
-    // Right rotation
-    AVLNode* rightRotate(AVLNode* y) {
-        AVLNode* x = y->left;
-        AVLNode* T2 = x->right;
-
-        // Perform rotation
-        x->right = y;
-        y->left = T2;
-
-        // Update heights
-        y->height = max(height(y->left), height(y->right)) + 1;
-        x->height = max(height(x->left), height(x->right)) + 1;
-
-        return x;
-    }
-
-    // Left rotation
-    AVLNode* leftRotate(AVLNode* x) {
-        AVLNode* y = x->right;
-        AVLNode* T2 = y->left;
-
-        // Perform rotation
-        y->left = x;
-        x->right = T2;
-
-        // Update heights
-        x->height = max(height(x->left), height(x->right)) + 1;
-        y->height = max(height(y->left), height(y->right)) + 1;
-
-        return y;
+    PipelineStats stats;
+    bool ok = evaluateStream(in, stdout, options, &stats);
+    if (in != stdin) fclose(in);
+    if (printStats) printPipelineStats(stats, stderr);
+    if (!ok) {
+        cerr << "Error evaluating input: " << path << endl;
+        return 1;
     }
+    return 0;
+}
 
-    // Insert helper
-    AVLNode* insert(AVLNode* node, const string& word) {
-        if (!node)
-            return new AVLNode(word);
-
-        if (word < node->word) {
-            node->left = insert(node->left, word);
-        } else if (word > node->word) {
-            node->right = insert(node->right, word);
-        } else {
-            // Word already exists, increment count
-            node->count++;
-            return node;
+// CSV mode: rpn-calculator --csv [--rpn|--infix] --column NAME=FORMULA... [--delimiter C] [--batch-size N] [--precision N] [--stats] [FILE|-]
+int runCsv(int argc, char* argv[]) {
+    CsvOptions options;
+    bool printStats = false;
+    const char* path = "-";
+    for (int i = 2; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--rpn") options.notation = Notation::RPN;
+        else if (arg == "--infix") options.notation = Notation::Infix;
+        else if (arg == "--stats") printStats = true;
+        else if (arg == "--delimiter" && hasValue) options.delimiter = argv[++i][0];
+        else if (arg == "--batch-size" && hasValue) options.batchRows = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--precision" && hasValue) options.precision = atoi(argv[++i]);
+        else if (arg == "--column" && hasValue) {
+            string column = argv[++i];
+            size_t equals = column.find('=');
+            if (equals == string::npos) {
+                cerr << "Expected NAME=FORMULA: " << column << endl;
+                return 2;
+            }
+            options.formulas.push_back(CsvFormula{ column.substr(0, equals), column.substr(equals + 1) });
         }
-
-        // Update height
-        node->height = max(height(node->left), height(node->right)) + 1;
-
-        // Balance the node
-        int balance = getBalanceFactor(node);
-
-        // Left Left Case
-        if (balance > 1 && word < node->left->word)
-            return rightRotate(node);
-
-        // Right Right Case
-        if (balance < -1 && word > node->right->word)
-            return leftRotate(node);
-
-        // Left Right Case
-        if (balance > 1 && word > node->left->word) {
-            node->left = leftRotate(node->left);
-            return rightRotate(node);
+        else if (arg.size() > 1 && arg[0] == '-') {
+            cerr << "Unknown option: " << arg << endl;
+            return 2;
         }
-
-        // Right Left Case
-        if (balance < -1 && word < node->right->word) {
-            node->right = rightRotate(node->right);
-            return leftRotate(node);
-        }
-
-        return node;
+        else path = argv[i];
     }
 
-    // In-order traversal to print the tree
-    void printTree(AVLNode* node) const {
-        if (node) {
-            printTree(node->left);
-            cout << node->word << " - " << node->count << endl;
-            printTree(node->right);
-        }
+    FILE* in = string(path) == "-" ? stdin : fopen(path, "rb");
+    if (!in) {
+        cerr << "Cannot open input: " << path << endl;
+        return 1;
     }
-
-public:
-    AVLTree() : root(nullptr) {}
-
-    void insert(const string& word) {
-        root = insert(root, word);
+    CsvStats stats;
+    bool ok = evaluateCsv(in, stdout, options, &stats);
+    if (in != stdin) fclose(in);
+    if (printStats) printCsvStats(stats, stderr);
+    for (const string& name : stats.unboundVariables) cerr << "No column named: " << name << endl;
+    if (!ok) {
+        cerr << "Error evaluating CSV: " << path << endl;
+        return 1;
     }
+    return 0;
+}
 
-    void printTree() const {
-        printTree(root);
-    }
-};
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && string(argv[1]) == "--evaluate") return runEvaluate(argc, argv);
+    if (argc >= 2 && string(argv[1]) == "--csv") return runCsv(argc, argv);
 
-// WordCount class
-class WordCount {
-private:
-    AVLTree tree;
+    // Expression file mode: one RPN or infix expression per line, one result per line on stdout
+    if (argc == 4 && string(argv[1]) == "--eval-file") {
+        Notation notation = string(argv[2]) == "infix" ? Notation::Infix : Notation::RPN;
+        if (!evaluateFile(argv[3], notation, stdout)) {
+            cerr << "Error evaluating file: " << argv[3] << endl;
+            return 1;
+        }
+        return 0;
+    }
 
-    // Helper function to clean and split words
-    void processLine(const string& line) {
-        string word;
-        for (char c : line) {
-            if (isalnum(c)) {
-                word += tolower(c);
-            } else if (!word.empty()) {
-                tree.insert(word);
-                word.clear();
-            }
+    // Word count mode: rpn-calculator [--avl | --threads N | --snapshot PATH [--follow [--interval MS]]]
+    //                                 [--top K] [--prefix P] [--lookup WORD] [FILE]
+    // --avl keeps counts in the AVL tree instead of the hash table, --threads counts on N workers
+    // (0 = one per hardware thread). --snapshot resumes from the counts saved by the previous run and
+    // reads only what was appended since; --follow keeps counting as the file grows until Ctrl-C.
+    // The query options freeze the counts into a FrozenWordIndex and print only the answers.
+    WordCountBackend backend = WordCountBackend::HashTable;
+    bool parallel = false;
+    unsigned threads = 0;
+    long long top = -1;
+    const char* prefix = nullptr;
+    const char* lookup = nullptr;
+    const char* snapshot = nullptr;
+    bool follow = false;
+    long long interval = 1000;
+    const char* fileName = "in/Users/novva/Downloads/CSIS-211-3443/Project 11/Project 11/WordCountTest.txtput.txt";
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--avl") backend = WordCountBackend::AVLTree;
+        else if (arg == "--threads" && hasValue) {
+            parallel = true;
+            threads = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
         }
-        if (!word.empty())
-            tree.insert(word);
+        else if (arg == "--top" && hasValue) top = strtoll(argv[++i], nullptr, 10);
+        else if (arg == "--prefix" && hasValue) prefix = argv[++i];
+        else if (arg == "--lookup" && hasValue) lookup = argv[++i];
+        else if (arg == "--snapshot" && hasValue) snapshot = argv[++i];
+        else if (arg == "--follow") follow = true;
+        else if (arg == "--interval" && hasValue) interval = strtoll(argv[++i], nullptr, 10);
+        else if (arg.size() > 1 && arg[0] == '-') {
+            cerr << "Unknown option: " << arg << endl;
+            return 2;
+        }
+        else fileName = argv[i];
     }
 
-public:
-    void readFile(const string& fileName) {
-        ifstream file(fileName);
-        if (!file.is_open()) {
+    // Count the file named on the command line, or the default test file
+    WordCount wc(backend);
+    unique_ptr<ParallelWordCount> counts;
+    unique_ptr<IncrementalWordCount> incremental;
+    if (snapshot || follow) {
+        incremental = make_unique<IncrementalWordCount>();
+        if (snapshot) incremental->loadSnapshot(snapshot);
+        if (follow) {
+            signal(SIGINT, requestStop);
+            incremental->follow(fileName, chrono::milliseconds(interval > 0 ? interval : 1), stopRequested, [&] {
+                cerr << incremental->totalWords() << " words, " << incremental->distinctWords() << " distinct, "
+                     << incremental->fileBytes() << " bytes" << (incremental->restarted() ? " (file replaced, recounted)" : "") << endl;
+                if (snapshot) incremental->saveSnapshot(snapshot);
+            });
+        } else if (!incremental->update(fileName)) {
             cerr << "Error opening file: " << fileName << endl;
-            return;
+            return 1;
         }
-
-        string line;
-        while (getline(file, line)) {
-            processLine(line);
+        if (snapshot && !incremental->saveSnapshot(snapshot)) {
+            cerr << "Error writing snapshot: " << snapshot << endl;
+            return 1;
         }
-
-        file.close();
+    } else if (parallel) {
+        counts = make_unique<ParallelWordCount>(threads);
+        if (!counts->readFile(fileName)) {
+            cerr << "Error opening file: " << fileName << endl;
+            return 1;
+        }
+    } else {
+        wc.readFile(fileName);
     }
 
-    void printWordCounts() const {
-        tree.printTree();
+    if (top < 0 && !prefix && !lookup) {
+        // Print word counts
+        cout << "Word Counts:" << endl;
+        if (incremental) incremental->print(cout);
+        else if (counts) counts->print(cout);
+        else wc.printWordCounts();
+        return 0;
     }
-};
 
-int main() {
-    WordCount wc;
-
-    // Read the file
-    wc.readFile("in/Users/novva/Downloads/CSIS-211-3443/Project 11/Project 11/WordCountTest.txtput.txt");
-
-    // Print word counts
-    cout << "Word Counts:" << endl;
-    wc.printWordCounts();
+    FrozenWordIndex index = incremental ? incremental->freeze() : counts ? counts->freeze() : wc.freeze();
+    if (lookup) {
+        cout << lookup << " - " << index.count(lookup) << endl;
+    }
+    if (prefix) {
+        cout << "Words starting with \"" << prefix << "\":" << endl;
+        for (const WordFrequency& entry : index.withPrefix(prefix)) cout << entry.word << " - " << entry.count << '\n';
+    }
+    if (top >= 0) {
+        cout << "Top " << top << " words:" << endl;
+        for (const WordFrequency& entry : index.topK(static_cast<size_t>(top))) cout << entry.word << " - " << entry.count << '\n';
+    }
+    cout.flush();
 
     return 0;
 }